@@ -2,11 +2,72 @@
 #define DATA_TRANSMITTER_H
 
 #include <Arduino.h>
+#include <PsychroFrame.h>
+#include <PsychroLog.h>
+#include "EnvironmentalCalculations.h"
+#include "Telemetry.h"
+
+#define BACKFILL_SETTLE_MS 50  // Time the host gets to follow a baud switch
 
 class DataTransmitter {
 public:
-    void begin();
-    void sendData(float dryBulbTemp, float wetBulbTemp, float relativeHumidity, float dewPoint, float absoluteHumidity, float partialPressure, float specificVolume, float enthalpy);
+    enum Format {
+        FORMAT_CSV,     // One ASCII line per sample, as read by webapp/server.js
+        FORMAT_BINARY,  // COBS/CRC-16 PsychroFrame frames, see lib/PsychroFrame
+    };
+
+    DataTransmitter();
+    // baud is the rate main.cpp opened Serial with, restored after a backfill burst
+    void begin(Format format = FORMAT_CSV, unsigned long baud = 9600, PsychroLogSpill* spill = 0);
+    void sendData(const PsychroState& state);
+    // One state per sensor pair from the same conversion, primary pair first.
+    // Binary mode sends them as one FRAME_MULTI_STATE; CSV and the sample log
+    // carry the primary pair only.
+    void sendData(const PsychroState* states, uint8_t count);
+
+    // Handle host requests and advance a backfill replay; call every loop()
+    void poll();
+
+#ifdef TELEMETRY
+    // Send a due telemetry report a frame per call, whenever the TX buffer
+    // has room for it; call every loop(), outside the timed spans
+    void sendTelemetry();
+#endif
+
+private:
+    Format format;
+    uint16_t stateSeq;
+    unsigned long baud;
+
+    PsychroLog log;
+    PsychroFrameDecoder requests;
+
+    // Backfill replay in progress
+    bool replaying;
+    uint16_t replaySeq;       // Next seq to send
+    uint16_t replayEnd;       // One past the last seq to send
+    unsigned long replayBaud; // 0 if the rate is unchanged
+    unsigned long replayStart;
+
+#ifdef TELEMETRY
+    uint8_t telemetryStage;  // Next span frame of the report, PSYCHRO_TELEMETRY_STAGES when done
+    // CSV mode's '#' line in progress: the raw frame, written out as hex a
+    // TX buffer's room at a time
+    uint8_t telemetryLine[PSYCHRO_FRAME_MAX];
+    uint8_t telemetryLineLength;  // Frame bytes, 0 if no line is pending
+    uint8_t telemetryLineSent;    // Characters of the line written so far
+#endif
+
+    void sendCsv(const PsychroState& state);
+    void sendFrame(const PsychroState& state);
+    void sendMultiFrame(const PsychroState* states, uint8_t count);
+    void sendEncoded(uint8_t type, const void* body, size_t length);
+    void startBackfill(const PsychroBackfillRequestFrame& request);
+    void continueBackfill();
+#ifdef TELEMETRY
+    void sendTelemetryFrame(uint8_t type, const void* body, size_t length);
+    void continueTelemetryLine();
+#endif
 };
 
 #endif
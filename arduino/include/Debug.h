@@ -0,0 +1,16 @@
+#ifndef DEBUG_H
+#define DEBUG_H
+
+#include <Arduino.h>
+
+// Human-readable progress output on Serial, compiled in only with -D DEBUG_OUTPUT.
+// It shares the link with the data stream, so keep it off in production builds.
+#ifdef DEBUG_OUTPUT
+#define DEBUG_PRINT(...) Serial.print(__VA_ARGS__)
+#define DEBUG_PRINTLN(...) Serial.println(__VA_ARGS__)
+#else
+#define DEBUG_PRINT(...) do {} while (0)
+#define DEBUG_PRINTLN(...) do {} while (0)
+#endif
+
+#endif
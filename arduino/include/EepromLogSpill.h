@@ -0,0 +1,22 @@
+#ifndef EEPROM_LOG_SPILL_H
+#define EEPROM_LOG_SPILL_H
+
+#include <Arduino.h>
+#include <PsychroLog.h>
+
+// First EEPROM byte used by the spill; the bytes below it hold the sensor
+// address cache (SENSOR_CACHE_EEPROM_ADDR) and settings
+#define EEPROM_LOG_SPILL_BASE 128
+
+// Sample log overflow in EEPROM. The ring position is kept in SRAM only, so
+// the spill does not survive a reset (seqs restart at 0 anyway). It is written
+// only while a host that has acknowledged samples before stays away, which
+// keeps wear at about one write per slot per outage.
+class EepromLogSpill : public PsychroLogSpill {
+public:
+    uint16_t capacity() const override;
+    void write(uint16_t slot, const PsychroRawSampleFrame& sample) override;
+    void read(uint16_t slot, PsychroRawSampleFrame& sample) const override;
+};
+
+#endif
@@ -1,12 +1,16 @@
 #ifndef ENVIRONMENTAL_CALCULATIONS_H
 #define ENVIRONMENTAL_CALCULATIONS_H
 
+#include "Psychrometrics.h"
+
 class EnvironmentalCalculations {
 public:
+    PsychroState computeState(float dryBulbTemp, float wetBulbTemp);
+
     float calculateRelativeHumidity(float dryBulbTemp, float wetBulbTemp);
-    float calculateDewPoint(float dryBulbTemp, float relativeHumidity);
-    float calculateAbsoluteHumidity(float dryBulbTemp, float relativeHumidity);
-    float calculatePartialPressure(float dryBulbTemp, float relativeHumidity);
+    float calculateDewPoint(float dryBulbTemp, float wetBulbTemp);
+    float calculateAbsoluteHumidity(float dryBulbTemp, float wetBulbTemp);
+    float calculatePartialPressure(float dryBulbTemp, float wetBulbTemp);
     float calculateSpecificVolume(float dryBulbTemp, float absoluteHumidity);
     float calculateEnthalpy(float dryBulbTemp, float absoluteHumidity);
 };
@@ -5,18 +5,78 @@
 #include <OneWire.h>
 #include <DallasTemperature.h>
 
+#define SENSOR_MAX_PAIRS 4              // Dry/wet pairs on the bus, one per zone
+#define SENSOR_CACHE_EEPROM_ADDR 0      // Address cache location, below EEPROM_LOG_SPILL_BASE
+#define SENSOR_CACHE_MAGIC 0x5053       // "PS"
+
+// ROM addresses and pair assignments, persisted so boot can skip the bus search
+struct SensorAddressCache {
+    uint16_t magic;
+    uint8_t pairCount;
+    DeviceAddress dryBulb[SENSOR_MAX_PAIRS];
+    DeviceAddress wetBulb[SENSOR_MAX_PAIRS];
+    uint16_t crc;  // psychroCrc16 over everything before it
+};
+
+// One zone's sensors by ROM address, e.g. an entry of include/SensorPairs.h
+struct SensorPairAddresses {
+    DeviceAddress dryBulb;
+    DeviceAddress wetBulb;
+};
+
 class SensorManager {
 public:
     SensorManager();
-    void begin();
-    float getDryBulbTemperature();
-    float getWetBulbTemperature();
+    // Call before begin() to assign the pairs by address; without a table
+    // begin() uses the EEPROM cache, or ROM order on a blank EEPROM
+    void setPairTable(const SensorPairAddresses* pairs, uint8_t count);
+    void begin(uint8_t resolution = 12, unsigned long samplePeriodMs = 2000);
+
+    // Non-blocking acquisition: call poll() from loop(); ready() returns true
+    // once for every completed conversion, after which the getters hold it
+    // for every pair.
+    void poll();
+    bool ready();
+
+    void setResolution(uint8_t resolution);
+    void setSamplePeriod(unsigned long samplePeriodMs);
+    unsigned long getConversionTime();
+
+    uint8_t getPairCount();
+    float getDryBulbTemperature(uint8_t pair = 0);
+    float getWetBulbTemperature(uint8_t pair = 0);
+
+    // Search the bus again and reassign pairs in ROM order, which need not
+    // match the wiring; assignPair() or a pair table sets the real roles
+    void rescan();
+    // Assign two known sensors to a pair; pair may be one past the last
+    bool assignPair(uint8_t pair, const DeviceAddress dryBulb, const DeviceAddress wetBulb);
+
+    bool cachedBoot;  // True if begin() found every sensor without a bus search
     DallasTemperature sensors;
 
 private:
     OneWire oneWire;
-    DeviceAddress dryBulbAddress, wetBulbAddress;
-    void printAddress(DeviceAddress deviceAddress);
+    DeviceAddress dryBulbAddress[SENSOR_MAX_PAIRS], wetBulbAddress[SENSOR_MAX_PAIRS];
+    uint8_t pairCount;
+    const SensorPairAddresses* pairTable;
+    uint8_t pairTableCount;
+    uint8_t resolution;
+    unsigned long samplePeriod;      // ms between conversion starts
+    unsigned long conversionTime;    // ms the DS18B20 needs at this resolution
+    unsigned long conversionStart;   // millis() when the pending conversion began
+    bool converting;
+    bool sampleReady;
+    float dryBulbTemp[SENSOR_MAX_PAIRS], wetBulbTemp[SENSOR_MAX_PAIRS];
+
+    bool loadCache();
+    void saveCache();
+    void discover();
+    uint8_t replaceMissing();
+    bool isAssigned(const DeviceAddress address);
+    void startConversion(unsigned long now);
+    bool conversionComplete(unsigned long now);
+    void printAddress(const DeviceAddress deviceAddress);
 };
 
 #endif
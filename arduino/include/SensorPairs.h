@@ -0,0 +1,16 @@
+#ifndef SENSOR_PAIRS_H
+#define SENSOR_PAIRS_H
+
+#include "SensorManager.h"
+
+// Build-time sensor assignment, used with -D SENSOR_PAIRS: pair i is zone i,
+// by ROM address, so wet and dry cannot swap whatever order the bus search
+// finds them in. A debug build prints every address at boot. An entry whose
+// sensor is gone is stood in for by an unassigned one until the table is fixed.
+static const SensorPairAddresses sensorPairs[] = {
+    // The README's instrument
+    { { 0x28, 0x61, 0x64, 0x34, 0xCD, 0xA6, 0xC5, 0x50 },    // Dry bulb
+      { 0x28, 0x61, 0x64, 0x34, 0x8C, 0x36, 0x91, 0xB3 } },  // Wet bulb
+};
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <Arduino.h>
+#include <Psychrometrics.h>
+#include <PsychroTelemetry.h>
+
+// Loop profiling, compiled in only with -D TELEMETRY. A TelemetrySpan times
+// the scope it lives in as one PsychroTelemetryStage; DataTransmitter counts
+// its writes and sends the report every TELEMETRY_PERIOD_MS. Without the flag
+// everything here is empty and inlines away.
+#define TELEMETRY_PERIOD_MS 60000
+
+#ifdef TELEMETRY
+extern PsychroTelemetry telemetry;
+
+// Paints the free SRAM so telemetryMinFreeSram() can find the deepest the
+// stack has been since; call first thing in setup()
+void telemetryBegin();
+uint16_t telemetryFreeSram();
+uint16_t telemetryMinFreeSram();
+
+inline void telemetrySpan(uint8_t stage, uint32_t us) {
+    telemetry.span(stage, us);
+}
+
+inline void telemetryDewPoint(const PsychroState& state) {
+    telemetry.dewPoint(state.dewPointIterations, state.dewPointConverged);
+}
+
+class TelemetrySpan {
+public:
+    explicit TelemetrySpan(uint8_t stage) : stage(stage), start(micros()) {}
+    ~TelemetrySpan() { done(); }
+
+    // Book the span under another stage once it is known
+    void setStage(uint8_t stage) { this->stage = stage; }
+    // End the span before the scope does
+    void done() {
+        telemetry.span(stage, micros() - start);
+        stage = PSYCHRO_TELEMETRY_STAGES;
+    }
+
+private:
+    uint8_t stage;
+    unsigned long start;
+};
+#else
+inline void telemetryBegin() {}
+inline void telemetrySpan(uint8_t, uint32_t) {}
+inline void telemetryDewPoint(const PsychroState&) {}
+
+class TelemetrySpan {
+public:
+    explicit TelemetrySpan(uint8_t) {}
+    void setStage(uint8_t) {}
+    void done() {}
+};
+#endif
+
+#endif
@@ -0,0 +1,108 @@
+#include "Arduino.h"
+#include <stdio.h>
+
+HardwareSerial Serial;
+bool mockSerialEcho = false;
+void (*mockSerialOutput)(const uint8_t* data, size_t length) = 0;
+
+static unsigned long mockMillis = 0;
+
+unsigned long millis() {
+    return mockMillis;
+}
+
+unsigned long micros() {
+    return mockMillis * 1000;
+}
+
+void delay(unsigned long ms) {
+    mockMillis += ms;
+}
+
+void mockAdvanceMillis(unsigned long ms) {
+    mockMillis += ms;
+}
+
+HardwareSerial::HardwareSerial() : baud(0), bytesWritten(0), inputHead(0), inputCount(0) {}
+
+void HardwareSerial::begin(unsigned long baud) {
+    this->baud = baud;
+}
+
+size_t HardwareSerial::write(uint8_t byte) {
+    return write(&byte, 1);
+}
+
+size_t HardwareSerial::write(const uint8_t* data, size_t length) {
+    bytesWritten += length;
+    if (mockSerialEcho) {
+        fwrite(data, 1, length, stdout);
+    }
+    if (mockSerialOutput) {
+        mockSerialOutput(data, length);
+    }
+    return length;
+}
+
+size_t HardwareSerial::print(const char* text) {
+    return write((const uint8_t*)text, strlen(text));
+}
+
+size_t HardwareSerial::print(char c) {
+    return write((uint8_t)c);
+}
+
+size_t HardwareSerial::print(double value, int digits) {
+    char text[32];
+    int length = snprintf(text, sizeof(text), "%.*f", digits, value);
+    return write((const uint8_t*)text, length);
+}
+
+size_t HardwareSerial::print(long value, int base) {
+    char text[24];
+    int length = snprintf(text, sizeof(text), base == HEX ? "%lX" : "%ld", value);
+    return write((const uint8_t*)text, length);
+}
+
+size_t HardwareSerial::print(unsigned long value, int base) {
+    char text[24];
+    int length = snprintf(text, sizeof(text), base == HEX ? "%lX" : "%lu", value);
+    return write((const uint8_t*)text, length);
+}
+
+size_t HardwareSerial::print(int value, int base) {
+    return print((long)value, base);
+}
+
+size_t HardwareSerial::print(unsigned int value, int base) {
+    return print((unsigned long)value, base);
+}
+
+size_t HardwareSerial::print(unsigned char value, int base) {
+    return print((unsigned long)value, base);
+}
+
+size_t HardwareSerial::println() {
+    return print("\r\n");
+}
+
+int HardwareSerial::available() {
+    return (int)inputCount;
+}
+
+int HardwareSerial::read() {
+    if (inputCount == 0) {
+        return -1;
+    }
+    uint8_t byte = input[inputHead];
+    inputHead = (inputHead + 1) % sizeof(input);
+    inputCount--;
+    return byte;
+}
+
+void HardwareSerial::mockInput(const uint8_t* data, size_t length) {
+    for (size_t i = 0; i < length && inputCount < sizeof(input); i++) {
+        input[(inputHead + inputCount) % sizeof(input)] = data[i];
+        inputCount++;
+    }
+}
@@ -0,0 +1,67 @@
+#ifndef ARDUINO_MOCK_H
+#define ARDUINO_MOCK_H
+
+// Just enough of the Arduino core for the firmware sources to build and run
+// on the host. Time is virtual: millis() only moves through delay() and
+// mockAdvanceMillis(), so runs are deterministic. Serial output is counted,
+// echoed to stdout only if mockSerialEcho is set, and handed to
+// mockSerialOutput if a test has set one to play the host.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#define HEX 16
+#define DEC 10
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+
+void mockAdvanceMillis(unsigned long ms);
+
+class HardwareSerial {
+public:
+    HardwareSerial();
+
+    void begin(unsigned long baud);
+    void end() {}
+    void flush() {}
+    operator bool() const { return true; }
+
+    size_t write(uint8_t byte);
+    size_t write(const uint8_t* data, size_t length);
+    size_t print(const char* text);
+    size_t print(char c);
+    size_t print(double value, int digits = 2);
+    size_t print(int value, int base = DEC);
+    size_t print(unsigned int value, int base = DEC);
+    size_t print(long value, int base = DEC);
+    size_t print(unsigned long value, int base = DEC);
+    size_t print(unsigned char value, int base = DEC);
+    size_t println();
+    template <typename T> size_t println(T value) { return print(value) + println(); }
+    template <typename T> size_t println(T value, int format) { return print(value, format) + println(); }
+
+    int available();
+    int read();
+    int availableForWrite() { return 63; }
+
+    // Bytes the host side queues for read()
+    void mockInput(const uint8_t* data, size_t length);
+
+    unsigned long baud;
+    unsigned long bytesWritten;
+
+private:
+    uint8_t input[256];
+    size_t inputHead;
+    size_t inputCount;
+};
+
+extern HardwareSerial Serial;
+extern bool mockSerialEcho;
+extern void (*mockSerialOutput)(const uint8_t* data, size_t length);  // Sent at Serial.baud
+
+#endif
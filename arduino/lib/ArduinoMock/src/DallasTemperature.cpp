@@ -0,0 +1,94 @@
+#include "DallasTemperature.h"
+#include "Arduino.h"
+
+uint8_t DallasTemperature::deviceCount = 2;
+unsigned DallasTemperature::mockSearches = 0;
+float DallasTemperature::temperatures[DALLAS_MOCK_MAX_DEVICES] = { 20, 20, 20, 20, 20, 20, 20, 20 };
+uint8_t DallasTemperature::addresses[DALLAS_MOCK_MAX_DEVICES][8];
+
+DallasTemperature::DallasTemperature(OneWire* oneWire)
+    : oneWire(oneWire), waitForConversion(true), resolution(12), conversionStart(0) {}
+
+bool DallasTemperature::getAddress(uint8_t* address, uint8_t index) {
+    mockSearches++;
+    if (index >= deviceCount) {
+        return false;
+    }
+    addressOf(index, address);
+    return true;
+}
+
+bool DallasTemperature::isConnected(const uint8_t* address) {
+    return indexOf(address) >= 0;
+}
+
+bool DallasTemperature::setResolution(const uint8_t* address, uint8_t resolution) {
+    this->resolution = resolution;
+    return indexOf(address) >= 0;
+}
+
+uint16_t DallasTemperature::millisToWaitForConversion(uint8_t resolution) {
+    switch (resolution) {
+        case 9: return 94;
+        case 10: return 188;
+        case 11: return 375;
+        default: return 750;
+    }
+}
+
+void DallasTemperature::requestTemperatures() {
+    conversionStart = millis();
+    if (waitForConversion) {
+        delay(millisToWaitForConversion(resolution));
+    }
+}
+
+bool DallasTemperature::isConversionComplete() {
+    return millis() - conversionStart >= millisToWaitForConversion(resolution);
+}
+
+float DallasTemperature::getTempC(const uint8_t* address) {
+    int index = indexOf(address);
+    if (index < 0) {
+        return DEVICE_DISCONNECTED_C;
+    }
+    float step = 0.5f / (1 << (resolution - 9));  // 0.5 °C at 9 bit .. 0.0625 °C at 12 bit
+    return floorf(temperatures[index] / step + 0.5f) * step;
+}
+
+void DallasTemperature::mockSetDeviceCount(uint8_t count) {
+    deviceCount = count <= DALLAS_MOCK_MAX_DEVICES ? count : DALLAS_MOCK_MAX_DEVICES;
+}
+
+void DallasTemperature::mockSetTemperature(uint8_t index, float celsius) {
+    if (index < DALLAS_MOCK_MAX_DEVICES) {
+        temperatures[index] = celsius;
+    }
+}
+
+void DallasTemperature::mockSetAddress(uint8_t index, const uint8_t* address) {
+    if (index < DALLAS_MOCK_MAX_DEVICES) {
+        memcpy(addresses[index], address, 8);
+    }
+}
+
+void DallasTemperature::addressOf(uint8_t index, uint8_t* address) {
+    if (addresses[index][0] != 0) {
+        memcpy(address, addresses[index], 8);
+        return;
+    }
+    memset(address, 0, 8);
+    address[0] = 0x28;  // DS18B20 family code
+    address[1] = index;
+}
+
+int DallasTemperature::indexOf(const uint8_t* address) {
+    for (uint8_t index = 0; index < deviceCount; index++) {
+        uint8_t known[8];
+        addressOf(index, known);
+        if (memcmp(address, known, 8) == 0) {
+            return index;
+        }
+    }
+    return -1;
+}
@@ -0,0 +1,55 @@
+#ifndef DALLAS_TEMPERATURE_MOCK_H
+#define DALLAS_TEMPERATURE_MOCK_H
+
+// Simulated DS18B20 bus. Sensor i has address {0x28, i, 0, ...} unless
+// mockSetAddress() gave it another, and reports
+// whatever mockSetTemperature() last set, quantized to the configured
+// resolution. Conversions complete after the datasheet time in virtual millis().
+// Bus searches (begin() and getAddress()) are counted in mockSearches.
+
+#include <stdint.h>
+#include "OneWire.h"
+
+#define DEVICE_DISCONNECTED_C -127
+#define DALLAS_MOCK_MAX_DEVICES 8
+
+typedef uint8_t DeviceAddress[8];
+
+class DallasTemperature {
+public:
+    explicit DallasTemperature(OneWire* oneWire);
+
+    void begin() { mockSearches++; }
+    uint8_t getDeviceCount() { return deviceCount; }
+    bool getAddress(uint8_t* address, uint8_t index);
+    bool isConnected(const uint8_t* address);
+    bool setResolution(const uint8_t* address, uint8_t resolution);
+    void setWaitForConversion(bool wait) { waitForConversion = wait; }
+    bool isParasitePowerMode() { return false; }
+    bool readPowerSupply(const uint8_t* address = 0) { return false; }
+    uint16_t millisToWaitForConversion(uint8_t resolution);
+    void requestTemperatures();
+    bool isConversionComplete();
+    float getTempC(const uint8_t* address);
+
+    // Simulation controls
+    static void mockSetDeviceCount(uint8_t count);
+    static void mockSetTemperature(uint8_t index, float celsius);
+    static void mockSetAddress(uint8_t index, const uint8_t* address);
+    static unsigned mockSearches;
+
+private:
+    OneWire* oneWire;
+    bool waitForConversion;
+    uint8_t resolution;
+    unsigned long conversionStart;
+
+    static uint8_t deviceCount;
+    static float temperatures[DALLAS_MOCK_MAX_DEVICES];
+    static uint8_t addresses[DALLAS_MOCK_MAX_DEVICES][8];  // All zero: the default address
+
+    static void addressOf(uint8_t index, uint8_t* address);
+    int indexOf(const uint8_t* address);
+};
+
+#endif
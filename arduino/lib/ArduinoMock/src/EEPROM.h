@@ -0,0 +1,32 @@
+#ifndef EEPROM_MOCK_H
+#define EEPROM_MOCK_H
+
+#include <stdint.h>
+#include <string.h>
+
+// 4 KiB like the ATmega2560, held in RAM and erased (0xFF) at start
+class EEPROMClass {
+public:
+    EEPROMClass() { memset(cells, 0xFF, sizeof(cells)); }
+
+    uint16_t length() { return sizeof(cells); }
+    uint8_t read(int address) { return cells[address]; }
+    void write(int address, uint8_t value) { cells[address] = value; }
+    void update(int address, uint8_t value) { cells[address] = value; }
+
+    template <typename T> T& get(int address, T& value) {
+        memcpy(&value, cells + address, sizeof(T));
+        return value;
+    }
+    template <typename T> const T& put(int address, const T& value) {
+        memcpy(cells + address, &value, sizeof(T));
+        return value;
+    }
+
+private:
+    uint8_t cells[4096];
+};
+
+extern EEPROMClass EEPROM;
+
+#endif
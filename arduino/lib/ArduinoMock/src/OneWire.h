@@ -0,0 +1,13 @@
+#ifndef ONE_WIRE_MOCK_H
+#define ONE_WIRE_MOCK_H
+
+#include <stdint.h>
+
+// The bus itself is never touched; DallasTemperature is mocked above it
+class OneWire {
+public:
+    explicit OneWire(uint8_t pin) : pin(pin) {}
+    uint8_t pin;
+};
+
+#endif
@@ -0,0 +1,276 @@
+#include "PsychroBatch.h"
+#include "Psychrometrics.h"
+#include <math.h>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define PSYCHRO_BATCH_X86 1
+#include <immintrin.h>
+#endif
+
+// Dew point lanes whose final |ln P_ws(Dew) - ln Pw| exceeds this are redone by FindDew
+const float dewLaneTolerance = 1e-5f;
+const int dewLaneIterations = 3;
+
+// Scalar evaluation of elements [begin, end), exactly as the firmware computes them
+static void computeRangeScalar(const float* dryBulb, const float* wetBulb, size_t begin, size_t end, PsychroBatchOut& out) {
+    for (size_t i = begin; i < end; i++) {
+        PsychroState state = computePsychroState(dryBulb[i], wetBulb[i]);
+        if (out.relativeHumidity) out.relativeHumidity[i] = state.relativeHumidity;
+        if (out.dewPoint) out.dewPoint[i] = state.dewPoint;
+        if (out.absoluteHumidity) out.absoluteHumidity[i] = state.absoluteHumidity;
+        if (out.partialPressure) out.partialPressure[i] = state.partialPressure;
+        if (out.specificVolume) out.specificVolume[i] = state.specificVolume;
+        if (out.enthalpy) out.enthalpy[i] = state.enthalpy;
+    }
+}
+
+#ifdef PSYCHRO_BATCH_X86
+
+#define AVX2 __attribute__((target("avx2,fma")))
+
+AVX2 static inline __m256 set1(float x) {
+    return _mm256_set1_ps(x);
+}
+
+// Natural log for positive normal floats (Cephes logf polynomial, ~1 ulp)
+AVX2 static inline __m256 log256(__m256 x) {
+    __m256i bits = _mm256_castps_si256(x);
+    __m256 e = _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(127)));
+    __m256 m = _mm256_castsi256_ps(_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi32(0x007FFFFF)), _mm256_set1_epi32(0x3F800000)));
+
+    // Keep the mantissa in [sqrt(1/2), sqrt(2)) so the polynomial argument is small
+    __m256 big = _mm256_cmp_ps(m, set1(1.41421356f), _CMP_GT_OQ);
+    m = _mm256_blendv_ps(m, _mm256_mul_ps(m, set1(0.5f)), big);
+    e = _mm256_add_ps(e, _mm256_and_ps(big, set1(1.0f)));
+
+    __m256 f = _mm256_sub_ps(m, set1(1.0f));
+    __m256 z = _mm256_mul_ps(f, f);
+    __m256 y = set1(7.0376836292E-2f);
+    y = _mm256_fmadd_ps(y, f, set1(-1.1514610310E-1f));
+    y = _mm256_fmadd_ps(y, f, set1(1.1676998740E-1f));
+    y = _mm256_fmadd_ps(y, f, set1(-1.2420140846E-1f));
+    y = _mm256_fmadd_ps(y, f, set1(1.4249322787E-1f));
+    y = _mm256_fmadd_ps(y, f, set1(-1.6668057665E-1f));
+    y = _mm256_fmadd_ps(y, f, set1(2.0000714765E-1f));
+    y = _mm256_fmadd_ps(y, f, set1(-2.4999993993E-1f));
+    y = _mm256_fmadd_ps(y, f, set1(3.3333331174E-1f));
+    y = _mm256_mul_ps(_mm256_mul_ps(y, f), z);
+    y = _mm256_fmadd_ps(e, set1(-2.12194440e-4f), y);
+    y = _mm256_fnmadd_ps(z, set1(0.5f), y);
+    return _mm256_fmadd_ps(e, set1(0.693359375f), _mm256_add_ps(f, y));
+}
+
+// e^x for |x| < 88 (Cephes expf polynomial, ~1 ulp)
+AVX2 static inline __m256 exp256(__m256 x) {
+    x = _mm256_min_ps(_mm256_max_ps(x, set1(-87.0f)), set1(88.0f));
+    __m256 n = _mm256_round_ps(_mm256_mul_ps(x, set1(1.44269504088896341f)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    x = _mm256_fnmadd_ps(n, set1(0.693359375f), x);
+    x = _mm256_fnmadd_ps(n, set1(-2.12194440e-4f), x);
+
+    __m256 y = set1(1.9875691500E-4f);
+    y = _mm256_fmadd_ps(y, x, set1(1.3981999507E-3f));
+    y = _mm256_fmadd_ps(y, x, set1(8.3334519073E-3f));
+    y = _mm256_fmadd_ps(y, x, set1(4.1665795894E-2f));
+    y = _mm256_fmadd_ps(y, x, set1(1.6666665459E-1f));
+    y = _mm256_fmadd_ps(y, x, set1(5.0000001201E-1f));
+    y = _mm256_fmadd_ps(y, _mm256_mul_ps(x, x), _mm256_add_ps(x, set1(1.0f)));
+
+    __m256i scale = _mm256_slli_epi32(_mm256_add_epi32(_mm256_cvtps_epi32(n), _mm256_set1_epi32(127)), 23);
+    return _mm256_mul_ps(y, _mm256_castsi256_ps(scale));
+}
+
+// Per-lane select of the Hyland-Wexler coefficient set, as lnP_ws() does
+#define HW_SELECT(field, water) _mm256_blendv_ps(set1((float)HW_OVER_ICE.field), set1((float)HW_OVER_WATER.field), water)
+
+// ln P_ws(T) (unit: ln kPa) and d(ln P_ws)/dT, lane-wise version of lnP_ws()
+AVX2 static inline __m256 lnPws256(__m256 T, __m256* slope) {
+    __m256 water = _mm256_cmp_ps(T, _mm256_setzero_ps(), _CMP_GE_OQ);
+    __m256 C1 = HW_SELECT(C1, water);
+    __m256 C3 = HW_SELECT(C3, water);
+    __m256 C4 = HW_SELECT(C4, water);
+    __m256 C5 = HW_SELECT(C5, water);
+    __m256 C6 = HW_SELECT(C6, water);
+    __m256 C7 = HW_SELECT(C7, water);
+
+    __m256 T_K = _mm256_add_ps(T, set1(273.15f));
+    __m256 inv = _mm256_div_ps(set1(1.0f), T_K);
+
+    if (slope) {
+        __m256 d = _mm256_mul_ps(set1(4.0f), C6);
+        d = _mm256_fmadd_ps(d, T_K, _mm256_mul_ps(set1(3.0f), C5));
+        d = _mm256_fmadd_ps(d, T_K, _mm256_mul_ps(set1(2.0f), C4));
+        d = _mm256_fmadd_ps(d, T_K, C3);
+        d = _mm256_fmadd_ps(C7, inv, d);
+        *slope = _mm256_fnmadd_ps(_mm256_mul_ps(C1, inv), inv, d);
+    }
+
+    __m256 p = _mm256_fmadd_ps(C6, T_K, C5);
+    p = _mm256_fmadd_ps(p, T_K, C4);
+    p = _mm256_fmadd_ps(p, T_K, C3);
+    p = _mm256_fmadd_ps(p, T_K, _mm256_sub_ps(HW_SELECT(C2, water), set1(6.907755279f)));  // ln Pa to ln kPa
+    p = _mm256_fmadd_ps(C1, inv, p);
+    return _mm256_fmadd_ps(C7, log256(T_K), p);
+}
+
+// coef(P_atm, T) for the standard atmosphere
+AVX2 static inline __m256 coef256(__m256 T) {
+    __m256 d = _mm256_fmadd_ps(set1(0.0008f), T, set1(-0.004f));
+    return _mm256_fmadd_ps(d, d, set1((float)(1 + 0.004 * P_atm / 101.325)));
+}
+
+// H_s(coef, P_ws, P_atm)
+AVX2 static inline __m256 Hs256(__m256 c, __m256 P) {
+    __m256 cP = _mm256_mul_ps(c, P);
+    return _mm256_div_ps(_mm256_mul_ps(set1(0.62198f), cP), _mm256_sub_ps(set1((float)P_atm), cP));
+}
+
+// Dew point by fixed-count Newton in log space from the same correlation FindDew uses.
+// Sets failed lanes (no convergence, bad input) in *retry for the scalar solver.
+AVX2 static inline __m256 dew256(__m256 Pw, __m256* retry) {
+    __m256 lnPw = log256(Pw);
+    __m256 L = lnPw;  // The correlation takes ln Pw with Pw in kPa
+    __m256 L2 = _mm256_mul_ps(L, L);
+
+    __m256 dew = _mm256_mul_ps(set1(0.4569f), exp256(_mm256_mul_ps(set1(0.1984f), L)));
+    dew = _mm256_fmadd_ps(set1(0.09486f), _mm256_mul_ps(L2, L), dew);
+    dew = _mm256_fmadd_ps(set1(0.7389f), L2, dew);
+    dew = _mm256_fmadd_ps(set1(14.526f), L, dew);
+    dew = _mm256_add_ps(dew, set1(6.54f));
+
+    // Condition for negative dew point temperatures
+    __m256 cold = _mm256_fmadd_ps(set1(0.4959f), L2, _mm256_fmadd_ps(set1(12.608f), L, set1(6.09f)));
+    dew = _mm256_blendv_ps(dew, cold, _mm256_cmp_ps(dew, _mm256_setzero_ps(), _CMP_LT_OQ));
+
+    __m256 residual = set1(NAN);
+    for (int i = 0; i < dewLaneIterations; i++) {
+        __m256 slope;
+        residual = _mm256_sub_ps(lnPws256(dew, &slope), lnPw);
+        dew = _mm256_sub_ps(dew, _mm256_div_ps(residual, slope));
+    }
+    residual = _mm256_sub_ps(lnPws256(dew, 0), lnPw);
+
+    __m256 absResidual = _mm256_andnot_ps(set1(-0.0f), residual);
+    *retry = _mm256_cmp_ps(absResidual, set1(dewLaneTolerance), _CMP_NLE_UQ);  // NaN counts as failed
+    return dew;
+}
+
+AVX2 static inline void store(float* column, size_t i, __m256 v) {
+    if (column) {
+        _mm256_storeu_ps(column + i, v);
+    }
+}
+
+// Eight elements per step; the tail and any lane the vector dew solver
+// could not settle go through the scalar path
+AVX2 static void computeRangeAvx2(const float* dryBulb, const float* wetBulb, size_t begin, size_t end, PsychroBatchOut& out) {
+    size_t i = begin;
+    for (; i + 8 <= end; i += 8) {
+        __m256 db = _mm256_loadu_ps(dryBulb + i);
+        __m256 wb = _mm256_loadu_ps(wetBulb + i);
+
+        // Saturated vapor pressures and correction factors
+        __m256 P_db = exp256(lnPws256(db, 0));
+        __m256 P_wb = exp256(lnPws256(wb, 0));
+        __m256 coef_db = coef256(db);
+        __m256 coef_wb = coef256(wb);
+
+        // Saturated absolute humidity
+        __m256 H_db = Hs256(coef_db, P_db);
+        __m256 H_wb = Hs256(coef_wb, P_wb);
+
+        // W_prime(), both branches blended on T_db >= 0
+        __m256 dT = _mm256_mul_ps(set1(1.006f), _mm256_sub_ps(db, wb));
+        __m256 warmNum = _mm256_fmsub_ps(_mm256_fnmadd_ps(set1(2.381f), wb, set1(2501.0f)), H_wb, dT);
+        __m256 warmDen = _mm256_fnmadd_ps(set1(4.186f), wb, _mm256_fmadd_ps(set1(1.805f), db, set1(2501.0f)));
+        __m256 coldNum = _mm256_fmsub_ps(_mm256_fmadd_ps(set1(1.805f - 2.093f), wb, set1(2501.0f + 334.0f)), H_wb, dT);
+        __m256 coldDen = _mm256_fnmadd_ps(set1(2.093f), wb, _mm256_fmadd_ps(set1(1.805f), db, set1(2501.0f + 334.0f)));
+        __m256 warm = _mm256_cmp_ps(db, _mm256_setzero_ps(), _CMP_GE_OQ);
+        __m256 W = _mm256_div_ps(_mm256_blendv_ps(coldNum, warmNum, warm), _mm256_blendv_ps(coldDen, warmDen, warm));
+
+        // VP(), RH()
+        __m256 Pw = _mm256_div_ps(_mm256_div_ps(_mm256_mul_ps(set1((float)P_atm), W), _mm256_add_ps(set1(0.62198f), W)), coef_wb);
+        __m256 DoS = _mm256_div_ps(W, H_db);
+        __m256 ratio = _mm256_mul_ps(coef_db, _mm256_mul_ps(P_db, set1((float)(1 / P_atm))));
+        __m256 rh = _mm256_div_ps(DoS, _mm256_fnmadd_ps(_mm256_sub_ps(set1(1.0f), DoS), ratio, set1(1.0f)));
+
+        // SpecificVolume(), Enthalpy()
+        __m256 T_K = _mm256_add_ps(db, set1(273.15f));
+        __m256 v = _mm256_mul_ps(_mm256_mul_ps(set1((float)(0.287055 / P_atm)), T_K), _mm256_fmadd_ps(set1(1.6078f), W, set1(1.0f)));
+        __m256 h = _mm256_fmadd_ps(W, _mm256_fmadd_ps(set1(1.805f), db, set1(2501.0f)), _mm256_mul_ps(set1(1.006f), db));
+
+        store(out.relativeHumidity, i, rh);
+        store(out.absoluteHumidity, i, W);
+        store(out.partialPressure, i, _mm256_mul_ps(Pw, set1(1000.0f)));  // kPa to Pa
+        store(out.specificVolume, i, v);
+        store(out.enthalpy, i, h);
+
+        if (out.dewPoint) {
+            __m256 retry;
+            _mm256_storeu_ps(out.dewPoint + i, dew256(Pw, &retry));
+            int failed = _mm256_movemask_ps(retry);
+            if (failed) {
+                float pw[8];
+                _mm256_storeu_ps(pw, Pw);
+                for (int lane = 0; lane < 8; lane++) {
+                    if (failed & (1 << lane)) {
+                        out.dewPoint[i + lane] = FindDew<float>(P_atm, pw[lane]).dewPoint;
+                    }
+                }
+            }
+        }
+    }
+
+    computeRangeScalar(dryBulb, wetBulb, i, end, out);
+}
+
+bool psychroBatchHasAvx2() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+}
+
+#else
+
+bool psychroBatchHasAvx2() {
+    return false;
+}
+
+#endif
+
+typedef void (*RangeKernel)(const float*, const float*, size_t, size_t, PsychroBatchOut&);
+
+void computeBatch(const float* dryBulb, const float* wetBulb, size_t n, PsychroBatchOut& out, unsigned threads) {
+    RangeKernel kernel = computeRangeScalar;
+#ifdef PSYCHRO_BATCH_X86
+    if (psychroBatchHasAvx2()) {
+        kernel = computeRangeAvx2;
+    }
+#endif
+
+    if (threads == 0) {
+        threads = n >= PSYCHRO_BATCH_PARALLEL_MIN ? std::thread::hardware_concurrency() : 1;
+    }
+    if (threads <= 1 || n < 8 * (size_t)threads) {
+        kernel(dryBulb, wetBulb, 0, n, out);
+        return;
+    }
+
+    // Contiguous slices, each a multiple of the vector width
+    size_t slice = (n / threads + 7) & ~(size_t)7;
+    std::vector<std::thread> workers;
+    size_t begin = 0;
+    for (unsigned t = 0; t + 1 < threads && begin + slice < n; t++, begin += slice) {
+        workers.push_back(std::thread(kernel, dryBulb, wetBulb, begin, begin + slice, std::ref(out)));
+    }
+    kernel(dryBulb, wetBulb, begin, n, out);
+
+    for (size_t t = 0; t < workers.size(); t++) {
+        workers[t].join();
+    }
+}
+
+void computeBatchScalar(const float* dryBulb, const float* wetBulb, size_t n, PsychroBatchOut& out) {
+    computeRangeScalar(dryBulb, wetBulb, 0, n, out);
+}
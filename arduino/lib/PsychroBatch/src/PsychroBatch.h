@@ -0,0 +1,31 @@
+#ifndef PSYCHRO_BATCH_H
+#define PSYCHRO_BATCH_H
+
+// Host-only batch evaluation of the psychrometric state (see Psychrometrics.h)
+// over structure-of-arrays input, for bulk reprocessing of logged history.
+// Uses AVX2/FMA kernels when the CPU has them, the shared scalar equations
+// otherwise, and splits large inputs across threads.
+
+#include <stddef.h>
+
+// Output columns, each with room for n values. A null column is skipped.
+struct PsychroBatchOut {
+    float* relativeHumidity;  // 0..1
+    float* dewPoint;          // °C
+    float* absoluteHumidity;  // kg/kg
+    float* partialPressure;   // Pa
+    float* specificVolume;    // m^3/kg
+    float* enthalpy;          // kJ/kg
+};
+
+#define PSYCHRO_BATCH_PARALLEL_MIN 65536  // Inputs below this stay on the calling thread
+
+// threads = 0 picks std::thread::hardware_concurrency() for large inputs
+void computeBatch(const float* dryBulb, const float* wetBulb, size_t n, PsychroBatchOut& out, unsigned threads = 0);
+
+// Same, forcing the scalar path; for comparison and on CPUs without AVX2
+void computeBatchScalar(const float* dryBulb, const float* wetBulb, size_t n, PsychroBatchOut& out);
+
+bool psychroBatchHasAvx2();
+
+#endif
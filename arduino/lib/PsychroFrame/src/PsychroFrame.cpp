@@ -0,0 +1,217 @@
+#include "PsychroFrame.h"
+#include <math.h>
+
+#define WIRE_LONG_MAX 2147483520.0f  // Largest float below 2^31
+
+// CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF), bitwise to keep it out of RAM
+uint16_t psychroCrc16(const uint8_t* data, size_t length, uint16_t crc) {
+    for (size_t i = 0; i < length; i++) {
+        crc ^= (uint16_t)data[i] << 8;
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+// COBS-encode type + body + crc straight into out, without a staging copy
+size_t psychroEncodeFrame(uint8_t type, const void* body, size_t length, uint8_t* out) {
+    if (length + 3 > PSYCHRO_FRAME_MAX) {
+        return 0;
+    }
+
+    const uint8_t* bytes = static_cast<const uint8_t*>(body);
+    uint16_t crc = psychroCrc16(&type, 1);
+    crc = psychroCrc16(bytes, length, crc);
+    uint8_t trailer[2] = { (uint8_t)(crc & 0xFF), (uint8_t)(crc >> 8) };
+
+    size_t codeIndex = 0;  // Where the current group's code byte goes
+    size_t outIndex = 1;
+    uint8_t code = 1;
+    size_t total = length + 3;
+
+    for (size_t i = 0; i < total; i++) {
+        uint8_t byte;
+        if (i == 0) {
+            byte = type;
+        } else if (i <= length) {
+            byte = bytes[i - 1];
+        } else {
+            byte = trailer[i - length - 1];
+        }
+
+        if (byte == 0) {
+            out[codeIndex] = code;
+            codeIndex = outIndex++;
+            code = 1;
+        } else {
+            out[outIndex++] = byte;
+            if (++code == 0xFF) {
+                out[codeIndex] = code;
+                codeIndex = outIndex++;
+                code = 1;
+            }
+        }
+    }
+
+    out[codeIndex] = code;
+    out[outIndex++] = 0;  // Frame delimiter
+    return outIndex;
+}
+
+// Rounded after clamping, so lround() never sees a value its long cannot hold
+static long wireValue(float value, float scale, float low, float high) {
+    float scaled = value * scale;
+    if (scaled < low) {
+        scaled = low;
+    } else if (scaled > high) {
+        scaled = high;
+    }
+    return lround(scaled);
+}
+
+int16_t psychroWireInt16(float value, float scale) {
+    if (!isfinite(value)) {
+        return PSYCHRO_MISSING_INT16;
+    }
+    return (int16_t)wireValue(value, scale, -32767.0f, 32767.0f);
+}
+
+uint16_t psychroWireUint16(float value, float scale) {
+    if (!isfinite(value)) {
+        return PSYCHRO_MISSING_UINT16;
+    }
+    return (uint16_t)wireValue(value, scale, 0, 65534.0f);
+}
+
+int32_t psychroWireInt32(float value, float scale) {
+    if (!isfinite(value)) {
+        return PSYCHRO_MISSING_INT32;
+    }
+    return (int32_t)wireValue(value, scale, -WIRE_LONG_MAX, WIRE_LONG_MAX);
+}
+
+uint32_t psychroWireUint32(float value, float scale) {
+    if (!isfinite(value)) {
+        return PSYCHRO_MISSING_UINT32;
+    }
+    return (uint32_t)wireValue(value, scale, 0, WIRE_LONG_MAX);
+}
+
+PsychroFrameDecoder::PsychroFrameDecoder()
+    : frames(0), crcErrors(0), frameErrors(0), frameLength(0) {
+    reset();
+}
+
+void PsychroFrameDecoder::reset() {
+    length = 0;
+    code = 0;
+    remaining = 0;
+    overflow = false;
+}
+
+bool PsychroFrameDecoder::push(uint8_t byte) {
+    if (byte == 0) {
+        // Delimiter: a frame is complete only if its last group was
+        bool complete = code != 0 && remaining == 0 && !overflow;
+        bool empty = code == 0;
+        size_t decoded = length;
+        reset();
+
+        if (empty) {
+            return false;  // Back-to-back delimiters
+        }
+        if (!complete || decoded < 3) {
+            frameErrors++;
+            return false;
+        }
+
+        uint16_t crc = psychroCrc16(buffer, decoded - 2);
+        if ((buffer[decoded - 2] | (buffer[decoded - 1] << 8)) != crc) {
+            crcErrors++;
+            return false;
+        }
+
+        frameLength = decoded - 3;
+        frames++;
+        return true;
+    }
+
+    if (remaining == 0) {
+        // Start of a group; every group but the first and those after a
+        // full 254-byte run stands for a zero in the decoded data
+        if (code != 0 && code != 0xFF) {
+            if (length < PSYCHRO_FRAME_MAX) {
+                buffer[length++] = 0;
+            } else {
+                overflow = true;
+            }
+        }
+        code = byte;
+        remaining = byte - 1;
+        return false;
+    }
+
+    if (length < PSYCHRO_FRAME_MAX) {
+        buffer[length++] = byte;
+    } else {
+        overflow = true;
+    }
+    remaining--;
+    return false;
+}
+
+PsychroSeqFilter::PsychroSeqFilter() {
+    reset();
+}
+
+void PsychroSeqFilter::reset() {
+    newestSeq = 0;
+    for (size_t i = 0; i < sizeof(seen); i++) {
+        seen[i] = 0;
+    }
+    started = false;
+}
+
+bool PsychroSeqFilter::test(uint16_t seq) const {
+    uint16_t bit = seq % PSYCHRO_SEQ_WINDOW;
+    return seen[bit / 8] & (1 << (bit % 8));
+}
+
+void PsychroSeqFilter::mark(uint16_t seq, bool value) {
+    uint16_t bit = seq % PSYCHRO_SEQ_WINDOW;
+    if (value) {
+        seen[bit / 8] |= (uint8_t)(1 << (bit % 8));
+    } else {
+        seen[bit / 8] &= (uint8_t)~(1 << (bit % 8));
+    }
+}
+
+bool PsychroSeqFilter::accept(uint16_t seq) {
+    if (!started) {
+        started = true;
+        newestSeq = seq;
+        mark(seq, true);
+        return true;
+    }
+
+    if (psychroSeqBefore(newestSeq, seq)) {
+        // Forget the slots the window slides over
+        uint16_t shift = seq - newestSeq;
+        if (shift >= PSYCHRO_SEQ_WINDOW) {
+            shift = PSYCHRO_SEQ_WINDOW;
+        }
+        for (uint16_t i = 1; i <= shift; i++) {
+            mark(newestSeq + i, false);
+        }
+        newestSeq = seq;
+        mark(seq, true);
+        return true;
+    }
+
+    if ((uint16_t)(newestSeq - seq) >= PSYCHRO_SEQ_WINDOW || test(seq)) {
+        return false;
+    }
+    mark(seq, true);
+    return true;
+}
@@ -0,0 +1,265 @@
+#ifndef PSYCHRO_FRAME_H
+#define PSYCHRO_FRAME_H
+
+// Binary serial protocol shared by the firmware and host tools.
+//
+// On the wire every frame is COBS( type | body | crc16 ) followed by a 0x00
+// delimiter, so a receiver can resynchronise on any zero byte and reject
+// corrupted frames by CRC. The CRC is CRC-16/CCITT-FALSE over type and body.
+// Multi-byte fields are little-endian (native on AVR and x86/ARM hosts).
+// Nothing here allocates or depends on Arduino.h.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define PSYCHRO_FRAME_MAX 64  // Largest unencoded frame: type + body + crc
+#define PSYCHRO_FRAME_ENCODED_MAX (PSYCHRO_FRAME_MAX + PSYCHRO_FRAME_MAX / 254 + 2)  // COBS overhead + delimiter
+
+// Fixed-point scales of the wire fields (wire value = physical value * scale)
+#define PSYCHRO_SCALE_TEMP 100.0f      // °C
+#define PSYCHRO_SCALE_RH 10000.0f      // 0..1
+#define PSYCHRO_SCALE_W 100000.0f      // kg/kg
+#define PSYCHRO_SCALE_PRESSURE 100.0f  // Pa
+#define PSYCHRO_SCALE_VOLUME 10000.0f  // m^3/kg
+#define PSYCHRO_SCALE_ENTHALPY 100.0f  // kJ/kg
+
+// Wire value of a field the state could not give (NaN or infinite), one per
+// field width; finite values are clamped short of it
+#define PSYCHRO_MISSING_INT16 (-32767 - 1)
+#define PSYCHRO_MISSING_UINT16 0xFFFFu
+#define PSYCHRO_MISSING_INT32 (-2147483647L - 1)
+#define PSYCHRO_MISSING_UINT32 0xFFFFFFFFul
+
+// Device to host below 0x80, host to device from 0x80
+enum PsychroFrameType {
+    FRAME_STATE = 0x01,           // PsychroStateFrame
+    FRAME_RAW_SAMPLE = 0x02,      // PsychroRawSampleFrame, replayed from the device log
+    FRAME_BACKFILL_BEGIN = 0x03,  // PsychroBackfillBeginFrame
+    FRAME_BACKFILL_END = 0x04,    // PsychroBackfillEndFrame
+    FRAME_MULTI_STATE = 0x05,     // PsychroMultiStateFrame
+    FRAME_TELEMETRY = 0x06,       // PsychroTelemetryFrame, TELEMETRY firmware builds only
+    FRAME_TELEMETRY_SPAN = 0x07,  // PsychroTelemetrySpanFrame, after its FRAME_TELEMETRY
+    FRAME_BACKFILL_REQUEST = 0x81,  // PsychroBackfillRequestFrame
+    FRAME_LOG_ACK = 0x82,           // PsychroLogAckFrame
+};
+
+// Common to every frame body
+struct __attribute__((packed)) PsychroFrameHeader {
+    uint16_t seq;        // Per-type counter, wraps at 65535
+    uint32_t timestamp;  // millis() on the device when the sample was taken
+};
+
+// One complete psychrometric state
+struct __attribute__((packed)) PsychroStateFrame {
+    PsychroFrameHeader header;
+    int16_t dryBulbTemp;
+    int16_t wetBulbTemp;
+    uint16_t relativeHumidity;
+    int16_t dewPoint;
+    uint16_t absoluteHumidity;
+    uint32_t partialPressure;
+    uint16_t specificVolume;
+    int32_t enthalpy;
+};
+
+static_assert(sizeof(PsychroStateFrame) == 26, "PsychroStateFrame layout changed");
+
+#define PSYCHRO_FRAME_MAX_CHANNELS 6   // Channels that fit in one PSYCHRO_FRAME_MAX frame
+#define PSYCHRO_TEMP_DISCONNECTED -12700  // DEVICE_DISCONNECTED_C on the wire: the pair's sensor failed
+
+// The measured part of one sensor pair's state; the rest follows from
+// dry and wet bulb and is derived by the host
+struct __attribute__((packed)) PsychroChannelState {
+    int16_t dryBulbTemp;
+    int16_t wetBulbTemp;
+    uint16_t relativeHumidity;
+    int16_t dewPoint;
+};
+
+static_assert(sizeof(PsychroChannelState) == 8, "PsychroChannelState layout changed");
+
+// Every sensor pair from one bus conversion. Only the first count channels
+// are sent, so the body is PSYCHRO_MULTI_STATE_SIZE(count) bytes long.
+struct __attribute__((packed)) PsychroMultiStateFrame {
+    PsychroFrameHeader header;
+    uint8_t count;
+    PsychroChannelState channels[PSYCHRO_FRAME_MAX_CHANNELS];
+};
+
+#define PSYCHRO_MULTI_STATE_SIZE(count) (offsetof(PsychroMultiStateFrame, channels) + (count) * sizeof(PsychroChannelState))
+
+static_assert(sizeof(PsychroMultiStateFrame) + 3 <= PSYCHRO_FRAME_MAX, "PsychroMultiStateFrame exceeds PSYCHRO_FRAME_MAX");
+
+// The raw readings behind a state frame with the same seq; also the record
+// kept by the device's sample log
+struct __attribute__((packed)) PsychroRawSampleFrame {
+    PsychroFrameHeader header;
+    int16_t dryBulbTemp;
+    int16_t wetBulbTemp;
+};
+
+static_assert(sizeof(PsychroRawSampleFrame) == 10, "PsychroRawSampleFrame layout changed");
+
+// Host asks for every logged sample from fromSeq on. Everything before fromSeq
+// is acknowledged and dropped from the log. A non-zero baud runs the replay at
+// that rate; the device switches after sending FRAME_BACKFILL_BEGIN and
+// switches back after FRAME_BACKFILL_END.
+struct __attribute__((packed)) PsychroBackfillRequestFrame {
+    uint16_t fromSeq;
+    uint32_t baud;
+};
+
+// Sent at the old rate before the replay; firstSeq > fromSeq means samples were lost
+struct __attribute__((packed)) PsychroBackfillBeginFrame {
+    uint16_t firstSeq;
+    uint16_t count;
+    uint32_t baud;  // Rate of the replay, 0 if unchanged
+};
+
+// Sent at the replay rate after the last replayed sample
+struct __attribute__((packed)) PsychroBackfillEndFrame {
+    uint16_t nextSeq;  // First seq not covered by the replay
+};
+
+// Host holds every sample before nextSeq; the device drops them from its log.
+// A listening host sends one every few samples so the log never fills, and
+// the device only spills to EEPROM once the acks stop.
+struct __attribute__((packed)) PsychroLogAckFrame {
+    uint16_t nextSeq;
+};
+
+// Parts of the firmware's loop() that TELEMETRY builds time, see include/Telemetry.h
+enum PsychroTelemetryStage {
+    STAGE_LOOP,         // loop() passes that handled a conversion, end to end
+    STAGE_IDLE,         // loop() passes that only polled the host and the bus
+    STAGE_SENSOR_START, // requestTemperatures(), starting a bus-wide conversion
+    STAGE_CONVERSION,   // From that start until the sensors are done, ms resolution
+    STAGE_SENSOR_READ,  // Reading every pair's scratchpads after a conversion
+    STAGE_CALC,         // Filtering and computeState() for one pair
+    STAGE_TRANSMIT,     // DataTransmitter::sendData()
+    STAGE_DEBUG,        // The DEBUG_OUTPUT value dump
+    PSYCHRO_TELEMETRY_STAGES
+};
+
+// Span histograms are log2 over µs: bucket 0 counts spans under 16 µs,
+// bucket k those in [2^(k+3), 2^(k+4)) µs and the last one everything from
+// 2^18 µs (262 ms) on
+#define PSYCHRO_SPAN_BUCKETS 16
+
+// Device counters over the period since the previous report. A span frame
+// per stage follows with the same header.
+struct __attribute__((packed)) PsychroTelemetryFrame {
+    PsychroFrameHeader header;  // seq counts reports
+    uint32_t periodMs;          // Time the counters cover
+    uint16_t freeSram;          // Bytes between heap and stack when sent
+    uint16_t minFreeSram;       // The same at the deepest stack since boot
+    uint32_t serialBytes;       // Data and replay bytes written; telemetry is left out
+    uint16_t txStalls;          // Writes that found the TX buffer too full and blocked
+    uint16_t dewSolves;         // Dew point solves (FindDew)
+    uint32_t dewIterations;     // Solver steps over all of them
+    uint8_t dewMaxIterations;   // Most steps one solve took
+    uint16_t dewNotConverged;   // Solves that hit the step cap
+    uint8_t stages;             // PSYCHRO_TELEMETRY_STAGES of the sender
+};
+
+static_assert(sizeof(PsychroTelemetryFrame) == 30, "PsychroTelemetryFrame layout changed");
+
+// One stage's spans over the report's period
+struct __attribute__((packed)) PsychroTelemetrySpanFrame {
+    PsychroFrameHeader header;  // The report's
+    uint8_t stage;              // PsychroTelemetryStage
+    uint32_t count;
+    uint32_t minUs;             // 0 without spans
+    uint32_t maxUs;
+    uint32_t totalUs;
+    uint16_t histogram[PSYCHRO_SPAN_BUCKETS];  // Counts saturate at 65535
+};
+
+static_assert(sizeof(PsychroTelemetrySpanFrame) + 3 <= PSYCHRO_FRAME_MAX, "PsychroTelemetrySpanFrame exceeds PSYCHRO_FRAME_MAX");
+
+uint16_t psychroCrc16(const uint8_t* data, size_t length, uint16_t crc = 0xFFFF);
+
+// Frame type + body into out[PSYCHRO_FRAME_ENCODED_MAX] including the trailing
+// delimiter. Returns the number of bytes to send, or 0 if the body is too large.
+size_t psychroEncodeFrame(uint8_t type, const void* body, size_t length, uint8_t* out);
+
+// value * scale rounded into a wire field: PSYCHRO_MISSING_* if value is not
+// finite, otherwise clamped to the rest of the field's range. The 32-bit
+// fields stop at 2^31 - 128, the largest float lround() takes on AVR.
+int16_t psychroWireInt16(float value, float scale);
+uint16_t psychroWireUint16(float value, float scale);
+int32_t psychroWireInt32(float value, float scale);
+uint32_t psychroWireUint32(float value, float scale);
+
+// Serial number arithmetic on wrapping 16-bit seqs: true if a comes before b
+inline bool psychroSeqBefore(uint16_t a, uint16_t b) {
+    return (int16_t)(a - b) < 0;
+}
+
+#define PSYCHRO_SEQ_WINDOW 1024  // Seqs remembered; must cover a full device log replay
+
+// Host-side duplicate filter for seqs that can arrive twice (live and
+// replayed) and out of order. Remembers the newest seq and the
+// PSYCHRO_SEQ_WINDOW - 1 before it.
+class PsychroSeqFilter {
+public:
+    PsychroSeqFilter();
+
+    // True the first time seq is seen, false for duplicates and for seqs
+    // older than the window
+    bool accept(uint16_t seq);
+    void reset();
+
+    uint16_t newest() const { return newestSeq; }
+
+private:
+    uint16_t newestSeq;
+    uint8_t seen[PSYCHRO_SEQ_WINDOW / 8];  // Bit seq % PSYCHRO_SEQ_WINDOW: accepted
+    bool started;
+
+    bool test(uint16_t seq) const;
+    void mark(uint16_t seq, bool value);
+};
+
+// Incremental receiver. Feed every byte from the link to push(); it returns
+// true when a complete frame with a valid CRC has arrived, after which
+// type(), body() and bodyLength() describe it until the next push().
+class PsychroFrameDecoder {
+public:
+    PsychroFrameDecoder();
+
+    bool push(uint8_t byte);
+    void reset();
+
+    uint8_t type() const { return buffer[0]; }
+    const uint8_t* body() const { return buffer + 1; }
+    size_t bodyLength() const { return frameLength; }
+
+    // Copy the body into a frame struct if it has exactly that size
+    template <typename Frame>
+    bool read(Frame& frame) const {
+        if (frameLength != sizeof(Frame)) {
+            return false;
+        }
+        const uint8_t* src = body();
+        uint8_t* dst = reinterpret_cast<uint8_t*>(&frame);
+        for (size_t i = 0; i < sizeof(Frame); i++) {
+            dst[i] = src[i];
+        }
+        return true;
+    }
+
+    uint32_t frames;       // Frames delivered
+    uint32_t crcErrors;    // Well-formed COBS with a bad CRC
+    uint32_t frameErrors;  // Overlong, truncated or malformed COBS
+
+private:
+    uint8_t buffer[PSYCHRO_FRAME_MAX];
+    size_t length;       // Decoded bytes of the frame in progress
+    uint8_t code;        // Current COBS group code
+    uint8_t remaining;   // Data bytes left in the current group
+    bool overflow;
+    size_t frameLength;  // Body length of the last delivered frame
+};
+
+#endif
@@ -0,0 +1,85 @@
+#include "PsychroLog.h"
+
+PsychroLog::PsychroLog() : spill(0), spillArmed(false) {
+    clear();
+}
+
+void PsychroLog::setSpill(PsychroLogSpill* spill) {
+    this->spill = spill;
+    spillHead = 0;
+    spillCount = 0;
+}
+
+void PsychroLog::clear() {
+    ramHead = 0;
+    ramCount = 0;
+    spillHead = 0;
+    spillCount = 0;
+    firstSeq = 0;
+}
+
+void PsychroLog::push(const PsychroRawSampleFrame& sample) {
+    if (size() == 0 || sample.header.seq != endSeq()) {
+        clear();
+        firstSeq = sample.header.seq;
+    }
+
+    if (ramCount == PSYCHRO_LOG_CAPACITY) {
+        // Move the oldest SRAM sample out, to the spill if there is one
+        const PsychroRawSampleFrame& oldest = ram[ramHead];
+        if (spill && spillArmed && spill->capacity() > 0) {
+            if (spillCount == spill->capacity()) {
+                spillHead = (spillHead + 1) % spill->capacity();  // Overwrite the oldest spilled sample
+                spillCount--;
+                firstSeq++;
+            }
+            spill->write((spillHead + spillCount) % spill->capacity(), oldest);
+            spillCount++;
+        } else {
+            firstSeq++;
+        }
+        ramHead = (ramHead + 1) % PSYCHRO_LOG_CAPACITY;
+        ramCount--;
+    }
+
+    ram[(ramHead + ramCount) % PSYCHRO_LOG_CAPACITY] = sample;
+    ramCount++;
+}
+
+bool PsychroLog::get(uint16_t seq, PsychroRawSampleFrame& sample) const {
+    uint16_t index = seq - firstSeq;
+    if (index >= size()) {
+        return false;
+    }
+
+    if (index < spillCount) {
+        spill->read((spillHead + index) % spill->capacity(), sample);
+    } else {
+        sample = ram[(ramHead + index - spillCount) % PSYCHRO_LOG_CAPACITY];
+    }
+    return true;
+}
+
+void PsychroLog::acknowledge(uint16_t seq) {
+    spillArmed = true;
+
+    // Seqs from before the oldest logged sample (or far in the future) drop nothing
+    uint16_t count = seq - firstSeq;
+    if (count > size()) {
+        count = psychroSeqBefore(seq, firstSeq) ? 0 : size();
+    }
+    while (count--) {
+        popOldest();
+    }
+}
+
+void PsychroLog::popOldest() {
+    if (spillCount > 0) {
+        spillHead = (spillHead + 1) % spill->capacity();
+        spillCount--;
+    } else {
+        ramHead = (ramHead + 1) % PSYCHRO_LOG_CAPACITY;
+        ramCount--;
+    }
+    firstSeq++;
+}
@@ -0,0 +1,68 @@
+#ifndef PSYCHRO_LOG_H
+#define PSYCHRO_LOG_H
+
+// Fixed-size log of the most recent raw samples, kept so a host that lost
+// the link can ask for the gap to be replayed (FRAME_BACKFILL_REQUEST).
+//
+// Samples are PsychroRawSampleFrame records with consecutive seqs, so any
+// seq still in the log is found by offset. The newest PSYCHRO_LOG_CAPACITY
+// samples live in SRAM. Once a host has acknowledged samples at least once,
+// samples pushed out of SRAM go to an optional PsychroLogSpill (EEPROM on
+// the device) instead of being dropped. A host that keeps acknowledging
+// (FRAME_LOG_ACK) keeps the log short, so the spill is only written while the
+// host is away.
+// Nothing here depends on Arduino.h.
+
+#include <stdint.h>
+#include <PsychroFrame.h>
+
+#ifndef PSYCHRO_LOG_CAPACITY
+#define PSYCHRO_LOG_CAPACITY 128  // Samples held in SRAM, 10 bytes each
+#endif
+
+// Secondary ring storage for samples pushed out of SRAM
+class PsychroLogSpill {
+public:
+    virtual uint16_t capacity() const = 0;
+    virtual void write(uint16_t slot, const PsychroRawSampleFrame& sample) = 0;
+    virtual void read(uint16_t slot, PsychroRawSampleFrame& sample) const = 0;
+};
+
+class PsychroLog {
+public:
+    PsychroLog();
+
+    void setSpill(PsychroLogSpill* spill);
+
+    // Append the next sample. A seq that does not follow the newest one
+    // starts the log over, since lookups rely on consecutive seqs.
+    void push(const PsychroRawSampleFrame& sample);
+
+    // Copy the sample with this seq; false if it is not in the log
+    bool get(uint16_t seq, PsychroRawSampleFrame& sample) const;
+
+    // The host holds every sample before seq; drop them
+    void acknowledge(uint16_t seq);
+
+    void clear();
+
+    uint16_t size() const { return spillCount + ramCount; }
+    uint16_t oldestSeq() const { return firstSeq; }
+    uint16_t endSeq() const { return (uint16_t)(firstSeq + size()); }  // One past the newest
+
+private:
+    PsychroRawSampleFrame ram[PSYCHRO_LOG_CAPACITY];
+    uint16_t ramHead;   // Slot of the oldest SRAM sample
+    uint16_t ramCount;
+
+    PsychroLogSpill* spill;
+    uint16_t spillHead;
+    uint16_t spillCount;
+    bool spillArmed;    // Set by the first acknowledge()
+
+    uint16_t firstSeq;  // Seq of the oldest sample in the log
+
+    void popOldest();
+};
+
+#endif
@@ -0,0 +1,121 @@
+#include "PsychroReport.h"
+#include <math.h>
+
+PsychroReporter::PsychroReporter()
+    : samples(0), reports(0), lastCount(0), lastReport(0), reported(false),
+      period(0), quietSamples(0) {
+    config.filter = FILTER_NONE;
+    config.window = 1;
+    config.alpha = 1;
+    config.deadbandTemp = 0;
+    config.deadbandRH = 0;
+    config.heartbeatMs = 0;
+    config.fastPeriodMs = 2000;
+    config.slowPeriodMs = 2000;
+    config.stableSamples = 1;
+    for (uint8_t channel = 0; channel < PSYCHRO_REPORT_MAX_CHANNELS; channel++) {
+        historyCount[channel] = 0;
+        historyNext[channel] = 0;
+        filterPrimed[channel] = false;
+    }
+}
+
+void PsychroReporter::begin(const PsychroReportConfig& config) {
+    this->config = config;
+    if (this->config.window < 1) {
+        this->config.window = 1;
+    } else if (this->config.window > PSYCHRO_REPORT_MAX_WINDOW) {
+        this->config.window = PSYCHRO_REPORT_MAX_WINDOW;
+    }
+    if (this->config.slowPeriodMs < this->config.fastPeriodMs) {
+        this->config.slowPeriodMs = this->config.fastPeriodMs;
+    }
+
+    for (uint8_t channel = 0; channel < PSYCHRO_REPORT_MAX_CHANNELS; channel++) {
+        historyCount[channel] = 0;
+        historyNext[channel] = 0;
+        filterPrimed[channel] = false;
+    }
+    reported = false;
+    period = this->config.fastPeriodMs;
+    quietSamples = 0;
+}
+
+void PsychroReporter::filter(uint8_t channel, float& dryBulbTemp, float& wetBulbTemp) {
+    if (channel >= PSYCHRO_REPORT_MAX_CHANNELS) {
+        return;
+    }
+
+    if (config.filter == FILTER_MOVING_AVERAGE) {
+        float* dry = dryHistory[channel];
+        float* wet = wetHistory[channel];
+        dry[historyNext[channel]] = dryBulbTemp;
+        wet[historyNext[channel]] = wetBulbTemp;
+        historyNext[channel] = (historyNext[channel] + 1) % config.window;
+        if (historyCount[channel] < config.window) {
+            historyCount[channel]++;
+        }
+
+        // Summed afresh each time; the window is short and this avoids drift
+        float drySum = 0;
+        float wetSum = 0;
+        for (uint8_t i = 0; i < historyCount[channel]; i++) {
+            drySum += dry[i];
+            wetSum += wet[i];
+        }
+        dryBulbTemp = drySum / historyCount[channel];
+        wetBulbTemp = wetSum / historyCount[channel];
+    } else if (config.filter == FILTER_IIR) {
+        if (!filterPrimed[channel]) {
+            dryFiltered[channel] = dryBulbTemp;
+            wetFiltered[channel] = wetBulbTemp;
+            filterPrimed[channel] = true;
+        } else {
+            dryFiltered[channel] += config.alpha * (dryBulbTemp - dryFiltered[channel]);
+            wetFiltered[channel] += config.alpha * (wetBulbTemp - wetFiltered[channel]);
+        }
+        dryBulbTemp = dryFiltered[channel];
+        wetBulbTemp = wetFiltered[channel];
+    }
+}
+
+bool PsychroReporter::update(const PsychroState* states, uint8_t count, unsigned long now) {
+    samples++;
+    if (count > PSYCHRO_REPORT_MAX_CHANNELS) {
+        count = PSYCHRO_REPORT_MAX_CHANNELS;
+    }
+
+    // NaN in any comparison counts as a change
+    bool changed = !reported || count != lastCount;
+    for (uint8_t channel = 0; channel < count && !changed; channel++) {
+        const PsychroState& state = states[channel];
+        changed = !(fabs(state.dryBulbTemp - lastDry[channel]) <= config.deadbandTemp)
+            || !(fabs(state.wetBulbTemp - lastWet[channel]) <= config.deadbandTemp)
+            || !(fabs(state.relativeHumidity - lastRH[channel]) <= config.deadbandRH);
+    }
+    bool heartbeat = config.heartbeatMs > 0 && now - lastReport >= config.heartbeatMs;
+
+    if (changed) {
+        period = config.fastPeriodMs;
+        quietSamples = 0;
+    } else if (++quietSamples >= config.stableSamples) {
+        period = period * 2 < config.slowPeriodMs ? period * 2 : config.slowPeriodMs;
+        quietSamples = 0;
+    }
+
+    if (!changed && !heartbeat) {
+        return false;
+    }
+
+    // Every channel goes out together, so all of them restart from here
+    for (uint8_t channel = 0; channel < count; channel++) {
+        lastDry[channel] = states[channel].dryBulbTemp;
+        lastWet[channel] = states[channel].wetBulbTemp;
+        lastRH[channel] = states[channel].relativeHumidity;
+    }
+    lastCount = count;
+    lastReport = now;
+    reported = true;
+    reports++;
+    return true;
+}
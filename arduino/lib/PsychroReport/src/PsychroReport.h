@@ -0,0 +1,84 @@
+#ifndef PSYCHRO_REPORT_H
+#define PSYCHRO_REPORT_H
+
+// Reporting stage between SensorManager and DataTransmitter: smooths the raw
+// DS18B20 readings, decides which samples are worth sending and adapts the
+// sample period to how fast the air state is changing.
+//
+// A sample covers every sensor pair (channel) read in one conversion and is
+// reported when dry bulb, wet bulb or RH of any channel has moved past its
+// deadband since the last reported sample, or when the heartbeat expires.
+// The period drops to fastPeriodMs on a deadband report and doubles after
+// every stableSamples quiet samples, up to slowPeriodMs. A receiver that
+// holds the last reported value is therefore never off by more than the
+// deadband from the filtered signal. Nothing here depends on Arduino.h.
+
+#include <stdint.h>
+#include <Psychrometrics.h>
+
+#define PSYCHRO_REPORT_MAX_WINDOW 8  // Longest moving average
+
+#ifndef PSYCHRO_REPORT_MAX_CHANNELS
+#define PSYCHRO_REPORT_MAX_CHANNELS 4
+#endif
+
+enum PsychroFilterMode {
+    FILTER_NONE,
+    FILTER_MOVING_AVERAGE,  // Mean of the last window readings
+    FILTER_IIR,             // y += alpha * (x - y)
+};
+
+struct PsychroReportConfig {
+    uint8_t filter;              // PsychroFilterMode
+    uint8_t window;              // Moving average length, 1..PSYCHRO_REPORT_MAX_WINDOW
+    float alpha;                 // IIR weight of the newest reading, 0..1
+    float deadbandTemp;          // °C, dry or wet bulb; 0 reports every change
+    float deadbandRH;            // 0..1
+    unsigned long heartbeatMs;   // Longest silence; 0 disables the heartbeat
+    unsigned long fastPeriodMs;  // Sample period while values are changing
+    unsigned long slowPeriodMs;  // Sample period once they have settled
+    uint8_t stableSamples;       // Quiet samples before the period doubles
+};
+
+class PsychroReporter {
+public:
+    PsychroReporter();
+    void begin(const PsychroReportConfig& config);
+
+    // Smooth one channel's raw reading in place
+    void filter(uint8_t channel, float& dryBulbTemp, float& wetBulbTemp);
+
+    // Decide whether the states computed from the filtered readings go out,
+    // and update the sample period. now is millis().
+    bool update(const PsychroState* states, uint8_t count, unsigned long now);
+
+    unsigned long samplePeriod() const { return period; }
+
+    uint32_t samples;   // Readings seen by update()
+    uint32_t reports;   // Readings it let through
+
+private:
+    PsychroReportConfig config;
+
+    // Filter state per channel
+    float dryHistory[PSYCHRO_REPORT_MAX_CHANNELS][PSYCHRO_REPORT_MAX_WINDOW];
+    float wetHistory[PSYCHRO_REPORT_MAX_CHANNELS][PSYCHRO_REPORT_MAX_WINDOW];
+    uint8_t historyCount[PSYCHRO_REPORT_MAX_CHANNELS];
+    uint8_t historyNext[PSYCHRO_REPORT_MAX_CHANNELS];
+    float dryFiltered[PSYCHRO_REPORT_MAX_CHANNELS];
+    float wetFiltered[PSYCHRO_REPORT_MAX_CHANNELS];
+    bool filterPrimed[PSYCHRO_REPORT_MAX_CHANNELS];
+
+    // Last reported sample
+    float lastDry[PSYCHRO_REPORT_MAX_CHANNELS];
+    float lastWet[PSYCHRO_REPORT_MAX_CHANNELS];
+    float lastRH[PSYCHRO_REPORT_MAX_CHANNELS];
+    uint8_t lastCount;
+    unsigned long lastReport;
+    bool reported;
+
+    unsigned long period;
+    uint8_t quietSamples;
+};
+
+#endif
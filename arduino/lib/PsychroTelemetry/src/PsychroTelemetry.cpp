@@ -0,0 +1,121 @@
+#include "PsychroTelemetry.h"
+
+static void saturatingIncrement(uint16_t& counter) {
+    if (counter != 0xFFFF) {
+        counter++;
+    }
+}
+
+uint8_t psychroSpanBucket(uint32_t us) {
+    // Bucket 0 is everything under 16 µs, each one after that an octave
+    uint8_t bucket = 0;
+    us >>= 3;
+    while (us > 1 && bucket < PSYCHRO_SPAN_BUCKETS - 1) {
+        us >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+PsychroSpanStats::PsychroSpanStats() {
+    reset();
+}
+
+void PsychroSpanStats::add(uint32_t us) {
+    count++;
+    if (us < minUs) {
+        minUs = us;
+    }
+    if (us > maxUs) {
+        maxUs = us;
+    }
+    totalUs += us;
+    saturatingIncrement(histogram[psychroSpanBucket(us)]);
+}
+
+void PsychroSpanStats::reset() {
+    count = 0;
+    minUs = 0xFFFFFFFF;
+    maxUs = 0;
+    totalUs = 0;
+    for (uint8_t i = 0; i < PSYCHRO_SPAN_BUCKETS; i++) {
+        histogram[i] = 0;
+    }
+}
+
+PsychroTelemetry::PsychroTelemetry() : period(0), periodStart(0), seq(0) {
+    header.seq = 0;
+    header.timestamp = 0;
+    resetCounters();
+}
+
+void PsychroTelemetry::begin(uint32_t periodMs, uint32_t now) {
+    period = periodMs;
+    periodStart = now;
+}
+
+void PsychroTelemetry::span(uint8_t stage, uint32_t us) {
+    if (stage < PSYCHRO_TELEMETRY_STAGES) {
+        spans[stage].add(us);
+    }
+}
+
+void PsychroTelemetry::dewPoint(uint8_t iterations, bool converged) {
+    saturatingIncrement(dewSolves);
+    dewIterations += iterations;
+    if (iterations > dewMaxIterations) {
+        dewMaxIterations = iterations;
+    }
+    if (!converged) {
+        saturatingIncrement(dewNotConverged);
+    }
+}
+
+void PsychroTelemetry::serial(uint32_t length, bool stalled) {
+    serialBytes += length;
+    if (stalled) {
+        saturatingIncrement(txStalls);
+    }
+}
+
+void PsychroTelemetry::report(PsychroTelemetryFrame& frame, uint32_t now, uint16_t freeSram, uint16_t minFreeSram) {
+    header.seq = seq++;
+    header.timestamp = now;
+    frame.header = header;
+    frame.periodMs = now - periodStart;
+    frame.freeSram = freeSram;
+    frame.minFreeSram = minFreeSram;
+    frame.serialBytes = serialBytes;
+    frame.txStalls = txStalls;
+    frame.dewSolves = dewSolves;
+    frame.dewIterations = dewIterations;
+    frame.dewMaxIterations = dewMaxIterations;
+    frame.dewNotConverged = dewNotConverged;
+    frame.stages = PSYCHRO_TELEMETRY_STAGES;
+
+    periodStart = now;
+    resetCounters();
+}
+
+void PsychroTelemetry::reportSpan(uint8_t stage, PsychroTelemetrySpanFrame& frame) {
+    PsychroSpanStats& stats = spans[stage];
+    frame.header = header;
+    frame.stage = stage;
+    frame.count = stats.count;
+    frame.minUs = stats.count ? stats.minUs : 0;
+    frame.maxUs = stats.maxUs;
+    frame.totalUs = stats.totalUs;
+    for (uint8_t i = 0; i < PSYCHRO_SPAN_BUCKETS; i++) {
+        frame.histogram[i] = stats.histogram[i];
+    }
+    stats.reset();
+}
+
+void PsychroTelemetry::resetCounters() {
+    serialBytes = 0;
+    txStalls = 0;
+    dewSolves = 0;
+    dewIterations = 0;
+    dewMaxIterations = 0;
+    dewNotConverged = 0;
+}
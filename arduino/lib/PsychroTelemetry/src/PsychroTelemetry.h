@@ -0,0 +1,67 @@
+#ifndef PSYCHRO_TELEMETRY_H
+#define PSYCHRO_TELEMETRY_H
+
+// Profiling accumulators for the firmware's loop(), reported to the host as
+// FRAME_TELEMETRY and FRAME_TELEMETRY_SPAN frames (lib/PsychroFrame). Stages
+// are timed in µs by the caller and kept as count, min, max, total and a
+// log2 histogram; the counters cover serial writes and dew point solves.
+// Everything restarts with each report. Nothing here depends on Arduino.h.
+
+#include <stdint.h>
+#include <PsychroFrame.h>
+
+// Histogram bucket of a span, see PSYCHRO_SPAN_BUCKETS
+uint8_t psychroSpanBucket(uint32_t us);
+
+class PsychroSpanStats {
+public:
+    PsychroSpanStats();
+
+    void add(uint32_t us);
+    void reset();
+
+    uint32_t count;
+    uint32_t minUs;
+    uint32_t maxUs;
+    uint32_t totalUs;  // Wraps after 71 minutes of spans
+    uint16_t histogram[PSYCHRO_SPAN_BUCKETS];
+};
+
+class PsychroTelemetry {
+public:
+    PsychroTelemetry();
+
+    // Reports fall due every periodMs from now on
+    void begin(uint32_t periodMs, uint32_t now);
+
+    void span(uint8_t stage, uint32_t us);
+    void dewPoint(uint8_t iterations, bool converged);
+    // One write of length bytes; stalled if the TX buffer could not take it all
+    void serial(uint32_t length, bool stalled);
+
+    bool due(uint32_t now) const { return now - periodStart >= period; }
+
+    // The counters since the previous report, then start the next period.
+    // SRAM is measured by the caller, it is platform specific.
+    void report(PsychroTelemetryFrame& frame, uint32_t now, uint16_t freeSram, uint16_t minFreeSram);
+    // One stage under the last report's header, then reset it
+    void reportSpan(uint8_t stage, PsychroTelemetrySpanFrame& frame);
+
+private:
+    PsychroSpanStats spans[PSYCHRO_TELEMETRY_STAGES];
+    PsychroFrameHeader header;  // Of the last report
+    uint32_t period;
+    uint32_t periodStart;
+    uint16_t seq;  // The next report's
+
+    uint32_t serialBytes;
+    uint16_t txStalls;
+    uint16_t dewSolves;
+    uint32_t dewIterations;
+    uint8_t dewMaxIterations;
+    uint16_t dewNotConverged;
+
+    void resetCounters();
+};
+
+#endif
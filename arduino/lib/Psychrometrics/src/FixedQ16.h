@@ -0,0 +1,74 @@
+#ifndef FIXED_Q16_H
+#define FIXED_Q16_H
+
+// Signed Q15.16 fixed point for the psychrometric templates on MCUs without
+// an FPU. Range ±32767 with a resolution of 1.5e-5, which is why the
+// equations work in kPa. Products and quotients go through a 64-bit
+// intermediate. Only what the templates need is provided; exp/log/pow are
+// routed through float and exist solely so the exact-formula code paths
+// compile; FixedQ16 always evaluates P_ws from the Q16 table.
+
+#include <stdint.h>
+#include <math.h>
+
+class FixedQ16 {
+public:
+    int32_t raw;
+
+    constexpr FixedQ16() : raw(0) {}
+    constexpr FixedQ16(int v) : raw((int32_t)v * 65536) {}
+    constexpr FixedQ16(double v) : raw((int32_t)(v * 65536.0 + (v >= 0 ? 0.5 : -0.5))) {}
+
+    static constexpr FixedQ16 fromRaw(int32_t raw) {
+        return FixedQ16(raw, RawTag());
+    }
+
+    explicit operator float() const {
+        return raw * (1.0f / 65536.0f);
+    }
+
+    // Integer part, rounded toward negative infinity
+    int16_t floor() const {
+        return (int16_t)(raw >> 16);
+    }
+
+    FixedQ16& operator+=(FixedQ16 b) { raw += b.raw; return *this; }
+    FixedQ16& operator-=(FixedQ16 b) { raw -= b.raw; return *this; }
+    FixedQ16& operator*=(FixedQ16 b) { raw = mul(raw, b.raw); return *this; }
+    FixedQ16& operator/=(FixedQ16 b) { raw = div(raw, b.raw); return *this; }
+
+    friend FixedQ16 operator+(FixedQ16 a, FixedQ16 b) { return fromRaw(a.raw + b.raw); }
+    friend FixedQ16 operator-(FixedQ16 a, FixedQ16 b) { return fromRaw(a.raw - b.raw); }
+    friend FixedQ16 operator*(FixedQ16 a, FixedQ16 b) { return fromRaw(mul(a.raw, b.raw)); }
+    friend FixedQ16 operator/(FixedQ16 a, FixedQ16 b) { return fromRaw(div(a.raw, b.raw)); }
+    friend FixedQ16 operator-(FixedQ16 a) { return fromRaw(-a.raw); }
+
+    friend bool operator<(FixedQ16 a, FixedQ16 b) { return a.raw < b.raw; }
+    friend bool operator>(FixedQ16 a, FixedQ16 b) { return a.raw > b.raw; }
+    friend bool operator<=(FixedQ16 a, FixedQ16 b) { return a.raw <= b.raw; }
+    friend bool operator>=(FixedQ16 a, FixedQ16 b) { return a.raw >= b.raw; }
+    friend bool operator==(FixedQ16 a, FixedQ16 b) { return a.raw == b.raw; }
+    friend bool operator!=(FixedQ16 a, FixedQ16 b) { return a.raw != b.raw; }
+
+private:
+    struct RawTag {};
+    constexpr FixedQ16(int32_t raw, RawTag) : raw(raw) {}
+
+    static int32_t mul(int32_t a, int32_t b) {
+        return (int32_t)(((int64_t)a * b + 32768) >> 16);
+    }
+
+    static int32_t div(int32_t a, int32_t b) {
+        if (b == 0) {
+            return a >= 0 ? INT32_MAX : INT32_MIN;
+        }
+        return (int32_t)(((int64_t)a * 65536) / b);
+    }
+};
+
+inline FixedQ16 fabs(FixedQ16 x) { return x.raw < 0 ? -x : x; }
+inline FixedQ16 exp(FixedQ16 x) { return FixedQ16((double)exp((float)x)); }
+inline FixedQ16 log(FixedQ16 x) { return FixedQ16((double)log((float)x)); }
+inline FixedQ16 pow(FixedQ16 x, FixedQ16 y) { return FixedQ16((double)pow((float)x, (float)y)); }
+
+#endif
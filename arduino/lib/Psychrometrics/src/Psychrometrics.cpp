@@ -0,0 +1,386 @@
+#include "Psychrometrics.h"
+#include "PwsTable.h"
+#include <math.h>
+
+// Constants
+const uint8_t maxDewIterations = 12;  // Hard cap on dew point solver steps
+const double dewBracketLow = -100;  // Dew point search range (unit: °C)
+const double dewBracketHigh = 200;
+const double dewBracketTolerance = 0.0001;  // Bracket width treated as converged (unit: °C)
+const double lnPaPerKPa = 6.907755278982137;  // ln 1000, converts the Hyland-Wexler result to kPa
+
+// Per-type choices. The table backend replaces exp/log for float and double
+// only when built with PWS_BACKEND_TABLE; FixedQ16 always uses its Q16 copy.
+template <typename Real>
+struct PsychroTraits {
+#ifdef PWS_BACKEND_TABLE
+    static const bool tableBackend = true;
+#else
+    static const bool tableBackend = false;
+#endif
+    static Real epsilon() { return Real(0.000005); }  // Precision threshold for iteration
+};
+
+template <>
+struct PsychroTraits<FixedQ16> {
+    static const bool tableBackend = true;
+    static FixedQ16 epsilon() { return FixedQ16::fromRaw(4); }  // 4 LSB of relative pressure error
+};
+
+// Helper function to convert Celsius to Kelvin
+template <typename Real>
+Real CtoK(Real T) {
+    return T + Real(273.15);
+}
+
+// Natural log of the saturated vapor pressure (unit: ln kPa).
+// If dlnP_dT is given it receives the analytic derivative d(ln P_ws)/dT (unit: 1/K).
+template <typename Real>
+Real lnP_ws(Real T, Real* dlnP_dT) {
+    Real T_K = CtoK(T);  // Convert temperature to Kelvin
+    const HylandWexlerCoefficients& C = T >= Real(0) ? HW_OVER_WATER : HW_OVER_ICE;
+
+    if (dlnP_dT) {
+        *dlnP_dT = -Real(C.C1) / (T_K * T_K) + Real(C.C3)
+                 + T_K * (Real(2 * C.C4) + T_K * (Real(3 * C.C5) + T_K * Real(4 * C.C6))) + Real(C.C7) / T_K;
+    }
+
+    return Real(C.C1) / T_K + Real(C.C2 - lnPaPerKPa)
+         + T_K * (Real(C.C3) + T_K * (Real(C.C4) + T_K * (Real(C.C5) + T_K * Real(C.C6)))) + Real(C.C7) * log(T_K);
+}
+
+template <>
+FixedQ16 lnP_ws<FixedQ16>(FixedQ16 T, FixedQ16* dlnP_dT) {
+    float slope;
+    float lnP = lnP_ws<float>((float)T, dlnP_dT ? &slope : 0);
+    if (dlnP_dT) {
+        *dlnP_dT = FixedQ16(slope);
+    }
+    return FixedQ16(lnP);
+}
+
+// Table coefficient i of segment k, read from flash
+template <typename Real>
+static inline Real pwsCoefficient(uint8_t k, uint8_t i) {
+    return Real(pgm_read_float(&pwsTable[k][i]));
+}
+
+template <>
+inline FixedQ16 pwsCoefficient<FixedQ16>(uint8_t k, uint8_t i) {
+    return FixedQ16::fromRaw((int32_t)pgm_read_dword(&pwsTableQ16[k][i]));
+}
+
+// Table position (T - T_MIN) / STEP of T, counted in segments
+template <typename Real>
+static inline Real pwsTablePosition(Real T) {
+    return (T - Real(PWS_TABLE_T_MIN)) * Real(1 / PWS_TABLE_STEP);
+}
+
+// 1/STEP is not exact in Q16 and its error would grow along the table
+// (2 mK at 100°C); dividing by STEP, which is, keeps the position exact
+template <>
+inline FixedQ16 pwsTablePosition<FixedQ16>(FixedQ16 T) {
+    return (T - FixedQ16(PWS_TABLE_T_MIN)) / FixedQ16(PWS_TABLE_STEP);
+}
+
+// Integer part of a non-negative table position
+template <typename Real>
+static inline uint8_t pwsSegmentIndex(Real x) {
+    return (uint8_t)x;
+}
+
+template <>
+inline uint8_t pwsSegmentIndex<FixedQ16>(FixedQ16 x) {
+    return (uint8_t)x.floor();
+}
+
+// Evaluate table segment k at t = (T - T0) / STEP (unit: kPa), with its slope dP_ws/dT if requested
+template <typename Real>
+static Real pwsSegment(uint8_t k, Real t, Real* dP_dT) {
+    Real b0 = pwsCoefficient<Real>(k, 0);
+    Real b1 = pwsCoefficient<Real>(k, 1);
+    Real b2 = pwsCoefficient<Real>(k, 2);
+    Real b3 = pwsCoefficient<Real>(k, 3);
+
+    if (dP_dT) {
+        *dP_dT = (b1 + t * (Real(2) * b2 + t * Real(3) * b3)) * Real(1 / PWS_TABLE_STEP);
+    }
+    return b0 + t * (b1 + t * (b2 + t * b3));
+}
+
+// Narrow the dew point search to the table segment containing Pw.
+// Returns false if Pw lies outside the table, leaving the exact solver to handle it.
+template <typename Real>
+static bool pwsTableBracket(Real Pw, Real* TT1, Real* TT2, Real* Dew) {
+    if (!(Pw >= pwsCoefficient<Real>(0, 0))) {
+        return false;
+    }
+
+    // Segment start values increase monotonically; find the last one not above Pw
+    uint8_t lo = 0;
+    uint8_t hi = PWS_TABLE_SEGMENTS - 1;
+    while (lo < hi) {
+        uint8_t mid = (lo + hi + 1) / 2;
+        if (pwsCoefficient<Real>(mid, 0) <= Pw) {
+            lo = mid;
+        } else {
+            hi = mid - 1;
+        }
+    }
+
+    Real T0 = Real(PWS_TABLE_T_MIN) + Real(lo) * Real(PWS_TABLE_STEP);
+    Real P0 = pwsCoefficient<Real>(lo, 0);
+    Real P1 = pwsSegment<Real>(lo, Real(1), 0);
+    if (Pw > P1) {
+        if (lo == PWS_TABLE_SEGMENTS - 1) {
+            return false;  // Above the table
+        }
+        // Between the ice and water branches at 0°C: the segment end is the answer
+        *TT1 = *TT2 = *Dew = T0 + Real(PWS_TABLE_STEP);
+        return true;
+    }
+
+    *TT1 = T0;
+    *TT2 = T0 + Real(PWS_TABLE_STEP);
+    *Dew = T0 + Real(PWS_TABLE_STEP) * (Pw - P0) / (P1 - P0);  // Linear estimate within the segment
+    return true;
+}
+
+// Saturated vapor pressure and, if requested, its slope dP_ws/dT (unit: kPa, kPa/K).
+// With the table backend exp/log are avoided entirely inside the table range;
+// outside it, and without the backend, the exact formula is used.
+template <typename Real>
+Real P_ws_slope(Real T, Real* dP_dT) {
+    if (PsychroTraits<Real>::tableBackend) {
+        Real x = pwsTablePosition(T);
+        if (x >= Real(0) && x < Real(PWS_TABLE_SEGMENTS)) {
+            uint8_t k = pwsSegmentIndex(x);
+            if (T < Real(0) && k == PWS_TABLE_ZERO_SEGMENT) {
+                k--;  // Rounding in x must not move a sub-zero temperature onto the water branch
+            }
+            return pwsSegment<Real>(k, x - Real(k), dP_dT);
+        }
+    }
+
+    Real dlnP_dT;
+    Real P = exp(lnP_ws(T, &dlnP_dT));
+    if (dP_dT) {
+        *dP_dT = P * dlnP_dT;
+    }
+    return P;
+}
+
+// Function to calculate saturated vapor pressure (unit: kPa)
+template <typename Real>
+Real P_ws(Real T) {
+    return P_ws_slope<Real>(T, 0);
+}
+
+// The humidity equations below are written so that no intermediate leaves
+// the Q15.16 range (±32767) or drops below its resolution for any dry and
+// wet bulb in -50..70°C; the largest products are kept to a few hundred by
+// dividing constants like 1006 J/kg·K by 1000 before they meet a temperature.
+
+// Correction factor for dry air and wet air
+template <typename Real>
+Real coef(Real P_atm, Real T) {
+    Real d = Real(0.0008) * T - Real(0.004);
+    return Real(1) + Real(0.004) * (P_atm / Real(101.325)) + d * d;
+}
+
+// Function for calculating saturated absolute humidity for dry air and wet air (unit: g/kg)
+template <typename Real>
+Real H_s(Real coef, Real P_ws, Real P_atm) {
+    Real P = coef * P_ws;
+    return P * (Real(621.98) / (P_atm - P));
+}
+
+// Function to calculate absolute humidity (g of water vapor per kg of dry air)
+template <typename Real>
+Real W_prime(Real T_db, Real T_wb, Real H_wb) {
+    Real den;
+    Real num;
+    if (T_db >= Real(0)) {
+        den = Real(2501) + Real(1.805) * T_db - Real(4.186) * T_wb;
+        num = Real(2501) - Real(2.381) * T_wb;
+    } else {
+        den = Real(2501) + Real(1.805) * T_db - Real(2.093) * T_wb + Real(334);
+        num = Real(2501) + Real(1.805) * T_wb - Real(2.093) * T_wb + Real(334);
+    }
+    // Scaled by 1/1000: 1006 * (T_db - T_wb) would overflow Q15.16 past a 32.6 K depression
+    return H_wb * (num / den) - Real(1.006) * (T_db - T_wb) / (den / Real(1000));
+}
+
+// Function to calculate the partial pressure of humid air (kPa)
+template <typename Real>
+Real VP(Real P_atm, Real W_prime, Real coef_wb) {
+    return W_prime * (P_atm / (Real(621.98) + W_prime)) / coef_wb;
+}
+
+// Function to calculate relative humidity
+template <typename Real>
+Real RH(Real H_db, Real W_prime, Real coef_db, Real P_db, Real P_atm) {
+    Real DoS = W_prime / H_db;
+    return DoS / (Real(1) - (Real(1) - DoS) * (coef_db * P_db / P_atm));
+}
+
+// Function to calculate dew-point temperature using partial pressure.
+// Safeguarded Newton iteration on ln P_ws(Dew) - ln Pw, which is close to linear
+// in temperature and converges in two or three steps from the correlation below.
+// With the table backend the start point and bracket come from the table segment
+// containing Pw instead, and the iteration runs on P_ws directly.
+// Steps that leave the current bracket fall back to bisection, and the loop is
+// capped at maxDewIterations so the worst case per reading is fixed.
+template <typename Real>
+DewPointResult FindDew(Real P_atm, Real Pw) {
+    DewPointResult result;
+    result.dewPoint = NAN;
+    result.iterations = 0;
+    result.converged = false;
+
+    if (!(Pw > Real(0))) {
+        return result;  // No water vapor, or a NaN from upstream
+    }
+
+    Real TT1 = Real(dewBracketLow);
+    Real TT2 = Real(dewBracketHigh);
+    Real Dew;
+    bool linear = false;  // Iterate on P_ws itself instead of ln P_ws
+
+    if (PsychroTraits<Real>::tableBackend) {
+        linear = pwsTableBracket(Pw, &TT1, &TT2, &Dew);
+    }
+
+    if (!linear) {
+        Real LnPw = log(Pw);
+        Dew = Real(6.54) + Real(14.526) * LnPw + Real(0.7389) * LnPw * LnPw + Real(0.09486) * LnPw * LnPw * LnPw
+            + Real(0.4569) * pow(Pw, Real(0.1984));
+
+        // Condition for negative dew point temperatures
+        if (Dew < Real(0)) {
+            Dew = Real(6.09) + Real(12.608) * LnPw + Real(0.4959) * LnPw * LnPw;
+        }
+
+        // The bracket covers every temperature the sensors can report
+        if (Dew < TT1 || Dew > TT2) {
+            Dew = (TT1 + TT2) / Real(2);
+        }
+    }
+
+    Real target = linear ? Pw : log(Pw);
+
+    while (result.iterations < maxDewIterations) {
+        result.iterations++;
+
+        // Relative pressure error and its slope
+        Real slope;
+        Real residual;
+        if (linear) {
+            residual = (P_ws_slope(Dew, &slope) - target) / target;
+            slope /= target;
+        } else {
+            residual = lnP_ws(Dew, &slope) - target;
+        }
+
+        // Stop iteration when the precision threshold is met
+        if (fabs(residual) <= PsychroTraits<Real>::epsilon()) {
+            result.converged = true;
+            break;
+        }
+
+        // P_ws is increasing, so the sign of the residual narrows the bracket
+        if (residual > Real(0)) {
+            TT2 = Dew;
+        } else {
+            TT1 = Dew;
+        }
+
+        // The ice/water formulas meet at 0°C with a small step; a root inside
+        // that step collapses the bracket instead of meeting the threshold
+        if (TT2 - TT1 <= Real(dewBracketTolerance)) {
+            result.converged = true;
+            break;
+        }
+
+        Real next = Dew - residual / slope;
+        if (!(next > TT1 && next < TT2)) {
+            next = (TT1 + TT2) / Real(2);
+        }
+        Dew = next;
+    }
+
+    result.dewPoint = (float)Dew;
+    return result;  // Return the final calculated dew point temperature
+}
+
+// Function to calculate specific volume of moist air (m^3/kg), W in g/kg
+template <typename Real>
+Real SpecificVolume(Real T_db, Real W) {
+    return Real(0.287055) * CtoK(T_db) * (Real(1) + W * Real(1.6078) / Real(1000)) / Real(P_atm);
+}
+
+// Function to calculate enthalpy of moist air (kJ/kg), W in g/kg
+template <typename Real>
+Real Enthalpy(Real T_db, Real W) {
+    return Real(1.006) * T_db + W * ((Real(2501) + Real(1.805) * T_db) / Real(1000));
+}
+
+// Calculate the full psychrometric state in a single pass.
+// Every intermediate (P_ws, coef, H_s, W') is evaluated exactly once; the
+// individual EnvironmentalCalculations::calculate* methods each redo the wet bulb chain.
+template <typename Real>
+PsychroState computePsychroState(float dryBulbTemp, float wetBulbTemp) {
+    PsychroState state;
+    state.dryBulbTemp = dryBulbTemp;
+    state.wetBulbTemp = wetBulbTemp;
+
+    Real T_db = Real(dryBulbTemp);
+    Real T_wb = Real(wetBulbTemp);
+    Real P = Real(P_atm);
+
+    // Saturated vapor pressures and correction factors
+    Real P_db = P_ws(T_db);
+    Real P_wb = P_ws(T_wb);
+    Real coef_db = coef(P, T_db);
+    Real coef_wb = coef(P, T_wb);
+
+    // Saturated absolute humidity
+    Real H_db = H_s(coef_db, P_db, P);
+    Real H_wb = H_s(coef_wb, P_wb, P);
+
+    // Absolute humidity and the vapor pressure it implies
+    Real W_prime_val = W_prime(T_db, T_wb, H_wb);
+    Real VP_val = VP(P, W_prime_val, coef_wb);
+
+    state.relativeHumidity = (float)RH(H_db, W_prime_val, coef_db, P_db, P);
+    state.absoluteHumidity = (float)W_prime_val / 1000;  // g/kg to kg/kg
+    state.partialPressure = (float)VP_val * 1000;  // kPa to Pa
+    DewPointResult dew = FindDew(P, VP_val);
+    state.dewPoint = dew.dewPoint;
+    state.dewPointIterations = dew.iterations;
+    state.dewPointConverged = dew.converged;
+    state.specificVolume = (float)SpecificVolume(T_db, W_prime_val);
+    state.enthalpy = (float)Enthalpy(T_db, W_prime_val);
+
+    return state;
+}
+
+// The scalar types the equations are built for
+#define PSYCHRO_INSTANTIATE(Real) \
+    template Real CtoK<Real>(Real); \
+    template Real lnP_ws<Real>(Real, Real*); \
+    template Real P_ws_slope<Real>(Real, Real*); \
+    template Real P_ws<Real>(Real); \
+    template Real coef<Real>(Real, Real); \
+    template Real H_s<Real>(Real, Real, Real); \
+    template Real W_prime<Real>(Real, Real, Real); \
+    template Real VP<Real>(Real, Real, Real); \
+    template Real RH<Real>(Real, Real, Real, Real, Real); \
+    template DewPointResult FindDew<Real>(Real, Real); \
+    template Real SpecificVolume<Real>(Real, Real); \
+    template Real Enthalpy<Real>(Real, Real); \
+    template PsychroState computePsychroState<Real>(float, float);
+
+PSYCHRO_INSTANTIATE(float)
+PSYCHRO_INSTANTIATE(double)
+PSYCHRO_INSTANTIATE(FixedQ16)
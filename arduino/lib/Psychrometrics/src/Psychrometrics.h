@@ -0,0 +1,81 @@
+#ifndef PSYCHROMETRICS_H
+#define PSYCHROMETRICS_H
+
+// Psychrometric equation set shared by the firmware (EnvironmentalCalculations)
+// and host tools. Plain C++ with no Arduino dependency; temperatures in °C,
+// pressures in kPa, humidity ratios in g/kg. PsychroState keeps the units the
+// firmware has always reported (Pa, kg/kg).
+//
+// The equations are templates on the scalar type, explicitly instantiated in
+// Psychrometrics.cpp for float, double and FixedQ16. psychro_real picks the
+// one the firmware uses (-D PSYCHRO_REAL=...); float matches what AVR did
+// when everything was written as double.
+
+#include <stdint.h>
+#include "FixedQ16.h"
+
+#ifndef PSYCHRO_REAL
+#define PSYCHRO_REAL float
+#endif
+
+typedef PSYCHRO_REAL psychro_real;
+
+const double P_atm = 101.325;  // Atmospheric pressure (unit: kPa)
+
+// ln P_ws = C1/T + C2 + C3*T + C4*T^2 + C5*T^3 + C6*T^4 + C7*ln T, T in K, P_ws in Pa
+struct HylandWexlerCoefficients {
+    double C1, C2, C3, C4, C5, C6, C7;
+};
+
+constexpr HylandWexlerCoefficients HW_OVER_WATER = {  // For temperatures above 0°C
+    -5800.2206, 1.3914993, -0.048640239, 0.000041764768, -0.000000014452093, 0, 6.5459673
+};
+constexpr HylandWexlerCoefficients HW_OVER_ICE = {  // For temperatures below 0°C
+    -5674.5359, 6.3925247, -0.009677843, 0.00000062215701, 2.0747825E-09, -9.484024E-13, 4.1635019
+};
+
+// Complete psychrometric state of one dry/wet bulb reading
+struct PsychroState {
+    float dryBulbTemp;        // °C
+    float wetBulbTemp;        // °C
+    float relativeHumidity;   // 0..1
+    float dewPoint;           // °C
+    float absoluteHumidity;   // kg/kg
+    float partialPressure;    // Pa
+    float specificVolume;     // m^3/kg
+    float enthalpy;           // kJ/kg
+    uint8_t dewPointIterations;  // Solver steps spent on dewPoint
+    bool dewPointConverged;      // false if the step cap was hit
+};
+
+// Outcome of the bounded dew point solver
+struct DewPointResult {
+    float dewPoint;      // °C
+    uint8_t iterations;
+    bool converged;
+};
+
+template <typename Real> Real CtoK(Real T);
+template <typename Real> Real lnP_ws(Real T, Real* dlnP_dT);
+template <typename Real> Real P_ws_slope(Real T, Real* dP_dT);
+template <typename Real> Real P_ws(Real T);
+template <typename Real> Real coef(Real P_atm, Real T);
+template <typename Real> Real H_s(Real coef, Real P_ws, Real P_atm);
+template <typename Real> Real W_prime(Real T_db, Real T_wb, Real H_wb);
+template <typename Real> Real VP(Real P_atm, Real W_prime, Real coef_wb);
+template <typename Real> Real RH(Real H_db, Real W_prime, Real coef_db, Real P_db, Real P_atm);
+template <typename Real> DewPointResult FindDew(Real P_atm, Real Pw);
+template <typename Real> Real SpecificVolume(Real T_db, Real W);
+template <typename Real> Real Enthalpy(Real T_db, Real W);
+
+// The Hyland-Wexler polynomial does not fit in Q15.16; evaluated in float
+template <> FixedQ16 lnP_ws<FixedQ16>(FixedQ16 T, FixedQ16* dlnP_dT);
+
+// Every intermediate (P_ws, coef, H_s, W') evaluated exactly once
+template <typename Real> PsychroState computePsychroState(float dryBulbTemp, float wetBulbTemp);
+
+inline PsychroState computePsychroState(float dryBulbTemp, float wetBulbTemp) {
+    return computePsychroState<psychro_real>(dryBulbTemp, wetBulbTemp);
+}
+
+#endif
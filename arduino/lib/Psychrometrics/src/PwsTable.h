@@ -0,0 +1,150 @@
+// Generated by scripts/pws_table.py - do not edit.
+// Piecewise cubic Hermite fit of the Hyland-Wexler saturation pressure (unit: kPa).
+// Max relative error against the exact formula: 1.39e-05 (float), max absolute: 1.74e-05 kPa (Q16)
+#ifndef PWS_TABLE_H
+#define PWS_TABLE_H
+
+#include <stdint.h>
+
+#ifdef __AVR__
+#include <avr/pgmspace.h>
+#else
+#define PROGMEM
+#define pgm_read_float(addr) (*(const float*)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t*)(addr))
+#endif
+
+#define PWS_TABLE_T_MIN -50.0
+#define PWS_TABLE_STEP 2.5
+#define PWS_TABLE_SEGMENTS 60
+#define PWS_TABLE_ZERO_SEGMENT 20  // First segment on the over-water branch
+
+// Row k covers [T_MIN + k * STEP, T_MIN + (k + 1) * STEP) as b0 + b1*t + b2*t^2 + b3*t^3, t = (T - T0) / STEP
+static const float pwsTable[PWS_TABLE_SEGMENTS][4] PROGMEM = {
+    { 0.00393898552f, 0.00121597783f, 0.000173136126f, 1.7221806e-05f },  // -50 °C
+    { 0.00534532126f, 0.00161391543f, 0.000224615011f, 2.17331908e-05f },  // -47.5 °C
+    { 0.00720558502f, 0.00212834496f, 0.000289592106f, 2.72654124e-05f },  // -45 °C
+    { 0.00965078734f, 0.00278932555f, 0.000371124479f, 3.40116349e-05f },  // -42.5 °C
+    { 0.0128452489f, 0.00363360927f, 0.000472848042f, 4.21938676e-05f },  // -40 °C
+    { 0.0169939008f, 0.00470588729f, 0.000599064166f, 5.20659487e-05f },  // -37.5 °C
+    { 0.0223509185f, 0.00606021332f, 0.000754835084f, 6.39166174e-05f },  // -35 °C
+    { 0.0292298831f, 0.00776163302f, 0.000946088636f, 7.80727132e-05f },  // -32.5 °C
+    { 0.0380156785f, 0.00988802873f, 0.0011797325f, 9.49024325e-05f },  // -30 °C
+    { 0.0491783395f, 0.0125322007f, 0.0014637782f, 0.000114818606f },  // -27.5 °C
+    { 0.0632891357f, 0.0158042125f, 0.00180747535f, 0.000138282048f },  // -25 °C
+    { 0.0810391083f, 0.0198340099f, 0.0022214551f, 0.000165804857f },  // -22.5 °C
+    { 0.103260376f, 0.0247743353f, 0.00271788426f, 0.000197953632f },  // -20 °C
+    { 0.130950555f, 0.0308039635f, 0.0033106287f, 0.000235352694f },  // -17.5 °C
+    { 0.165300503f, 0.038131278f, 0.00401542755f, 0.000278687163f },  // -15 °C
+    { 0.207725897f, 0.0469981954f, 0.00485007279f, 0.000328705763f },  // -12.5 °C
+    { 0.259902865f, 0.0576844588f, 0.00583460461f, 0.000386223663f },  // -10 °C
+    { 0.323808163f, 0.0705123395f, 0.00699150609f, 0.00045212495f },  // -7.5 °C
+    { 0.401764125f, 0.0858517289f, 0.00834591314f, 0.000527364726f },  // -5 °C
+    { 0.496489137f, 0.104125649f, 0.00992582645f, 0.000612971198f },  // -2.5 °C
+    { 0.61121285f, 0.11100436f, 0.00892720744f, 0.000438200979f },  // 0 °C
+    { 0.731582642f, 0.13017337f, 0.0102409627f, 0.000489683764f },  // 2.5 °C
+    { 0.872486651f, 0.152124345f, 0.0117091294f, 0.00054549909f },  // 5 °C
+    { 1.03686559f, 0.177179113f, 0.013344707f, 0.000605826848f },  // 7.5 °C
+    { 1.22799528f, 0.205686003f, 0.015161234f, 0.000670838519f },  // 10 °C
+    { 1.44951332f, 0.238020986f, 0.017172765f, 0.000740695803f },  // 12.5 °C
+    { 1.70544779f, 0.274588615f, 0.0193938389f, 0.000815549865f },  // 15 °C
+    { 2.00024581f, 0.315822929f, 0.0218394473f, 0.000895539648f },  // 17.5 °C
+    { 2.33880377f, 0.362188429f, 0.0245250016f, 0.000980791636f },  // 20 °C
+    { 2.72649789f, 0.414180815f, 0.0274662916f, 0.00107141829f },  // 22.5 °C
+    { 3.16921639f, 0.47232765f, 0.0306794439f, 0.0011675175f },  // 25 °C
+    { 3.6733911f, 0.537189126f, 0.0341808759f, 0.00126917206f },  // 27.5 °C
+    { 4.24603033f, 0.60935837f, 0.037987262f, 0.00137644901f },  // 30 °C
+    { 4.8947525f, 0.689462245f, 0.0421154723f, 0.001489399f },  // 32.5 °C
+    { 5.62781954f, 0.778161407f, 0.0465825237f, 0.00160805613f },  // 35 °C
+    { 6.45417118f, 0.876150608f, 0.051405549f, 0.00173243752f },  // 37.5 °C
+    { 7.38346004f, 0.984158993f, 0.0566017181f, 0.00186254375f },  // 40 °C
+    { 8.42608356f, 1.1029501f, 0.0621882081f, 0.00199835817f },  // 42.5 °C
+    { 9.59321976f, 1.23332155f, 0.0681821555f, 0.00213984726f },  // 45 °C
+    { 10.8968639f, 1.37610543f, 0.0746005774f, 0.0022869613f },  // 47.5 °C
+    { 12.3498564f, 1.53216743f, 0.0814603567f, 0.00243963464f },  // 50 °C
+    { 13.9659243f, 1.70240712f, 0.0887781754f, 0.00259778486f },  // 52.5 °C
+    { 15.7597065f, 1.88775682f, 0.096570462f, 0.00276131579f },  // 55 °C
+    { 17.7467957f, 2.08918166f, 0.104853369f, 0.00293011521f },  // 57.5 °C
+    { 19.9437599f, 2.3076787f, 0.1136427f, 0.00310405856f },  // 60 °C
+    { 22.368187f, 2.54427624f, 0.122953884f, 0.00328300684f },  // 62.5 °C
+    { 25.0387001f, 2.80003309f, 0.13280195f, 0.0034668101f },  // 65 °C
+    { 27.9750004f, 3.07603741f, 0.143201455f, 0.00365530606f },  // 67.5 °C
+    { 31.1978951f, 3.37340617f, 0.15416649f, 0.0038483229f },  // 70 °C
+    { 34.7293167f, 3.69328427f, 0.165710613f, 0.00404567923f },  // 72.5 °C
+    { 38.5923576f, 4.03684235f, 0.177846834f, 0.00424718438f },  // 75 °C
+    { 42.8112946f, 4.40527773f, 0.190587625f, 0.00445264205f },  // 77.5 °C
+    { 47.4116096f, 4.79981089f, 0.203944817f, 0.00466184877f },  // 80 °C
+    { 52.4200287f, 5.22168589f, 0.217929676f, 0.00487459498f },  // 82.5 °C
+    { 57.864521f, 5.67216921f, 0.232552826f, 0.00509066926f },  // 85 °C
+    { 63.774334f, 6.15254688f, 0.247824222f, 0.0053098551f },  // 87.5 °C
+    { 70.1800156f, 6.66412497f, 0.263753235f, 0.00553193409f },  // 90 °C
+    { 77.1134262f, 7.20822716f, 0.280348539f, 0.0057566883f },  // 92.5 °C
+    { 84.6077576f, 7.78619432f, 0.297618121f, 0.00598389795f },  // 95 °C
+    { 92.6975555f, 8.39938259f, 0.315569401f, 0.00621334556f },  // 97.5 °C
+};
+
+// The same rows as raw FixedQ16 values
+static const int32_t pwsTableQ16[PWS_TABLE_SEGMENTS][4] PROGMEM = {
+    { 258, 80, 11, 1 },  // -50 °C
+    { 350, 106, 15, 1 },  // -47.5 °C
+    { 472, 139, 19, 2 },  // -45 °C
+    { 632, 183, 24, 2 },  // -42.5 °C
+    { 842, 238, 31, 3 },  // -40 °C
+    { 1114, 308, 39, 3 },  // -37.5 °C
+    { 1465, 397, 49, 4 },  // -35 °C
+    { 1916, 509, 62, 5 },  // -32.5 °C
+    { 2491, 648, 77, 6 },  // -30 °C
+    { 3223, 821, 96, 8 },  // -27.5 °C
+    { 4148, 1036, 118, 9 },  // -25 °C
+    { 5311, 1300, 146, 11 },  // -22.5 °C
+    { 6767, 1624, 178, 13 },  // -20 °C
+    { 8582, 2019, 217, 15 },  // -17.5 °C
+    { 10833, 2499, 263, 18 },  // -15 °C
+    { 13614, 3080, 318, 22 },  // -12.5 °C
+    { 17033, 3780, 382, 25 },  // -10 °C
+    { 21221, 4621, 458, 30 },  // -7.5 °C
+    { 26330, 5626, 547, 35 },  // -5 °C
+    { 32538, 6824, 650, 40 },  // -2.5 °C
+    { 40056, 7275, 585, 29 },  // 0 °C
+    { 47945, 8531, 671, 32 },  // 2.5 °C
+    { 57179, 9970, 767, 36 },  // 5 °C
+    { 67952, 11612, 875, 40 },  // 7.5 °C
+    { 80478, 13480, 994, 44 },  // 10 °C
+    { 94995, 15599, 1125, 49 },  // 12.5 °C
+    { 111768, 17995, 1271, 53 },  // 15 °C
+    { 131088, 20698, 1431, 59 },  // 17.5 °C
+    { 153276, 23736, 1607, 64 },  // 20 °C
+    { 178684, 27144, 1800, 70 },  // 22.5 °C
+    { 207698, 30954, 2011, 77 },  // 25 °C
+    { 240739, 35205, 2240, 83 },  // 27.5 °C
+    { 278268, 39935, 2490, 90 },  // 30 °C
+    { 320782, 45185, 2760, 98 },  // 32.5 °C
+    { 368825, 50998, 3053, 105 },  // 35 °C
+    { 422981, 57419, 3369, 114 },  // 37.5 °C
+    { 483882, 64498, 3709, 122 },  // 40 °C
+    { 552212, 72283, 4076, 131 },  // 42.5 °C
+    { 628701, 80827, 4468, 140 },  // 45 °C
+    { 714137, 90184, 4889, 150 },  // 47.5 °C
+    { 809360, 100412, 5339, 160 },  // 50 °C
+    { 915271, 111569, 5818, 170 },  // 52.5 °C
+    { 1032828, 123716, 6329, 181 },  // 55 °C
+    { 1163054, 136917, 6872, 192 },  // 57.5 °C
+    { 1307034, 151236, 7448, 203 },  // 60 °C
+    { 1465921, 166742, 8058, 215 },  // 62.5 °C
+    { 1640936, 183503, 8703, 227 },  // 65 °C
+    { 1833370, 201591, 9385, 240 },  // 67.5 °C
+    { 2044585, 221080, 10103, 252 },  // 70 °C
+    { 2276020, 242043, 10860, 265 },  // 72.5 °C
+    { 2529189, 264559, 11655, 278 },  // 75 °C
+    { 2805681, 288704, 12490, 292 },  // 77.5 °C
+    { 3107167, 314560, 13366, 306 },  // 80 °C
+    { 3435399, 342208, 14282, 319 },  // 82.5 °C
+    { 3792209, 371731, 15241, 334 },  // 85 °C
+    { 4179515, 403213, 16241, 348 },  // 87.5 °C
+    { 4599317, 436740, 17285, 363 },  // 90 °C
+    { 5053705, 472398, 18373, 377 },  // 92.5 °C
+    { 5544854, 510276, 19505, 392 },  // 95 °C
+    { 6075027, 550462, 20681, 407 },  // 97.5 °C
+};
+
+#endif
@@ -0,0 +1,147 @@
+"""Generate lib/Psychrometrics/src/PwsTable.h, the piecewise cubic P_ws backend.
+
+Runs as a PlatformIO pre: extra script on every build, or standalone with
+`python scripts/pws_table.py`. Each segment is a cubic Hermite interpolant
+of the exact Hyland-Wexler saturation pressure, so the table is continuous
+in value and slope across segments (except at 0 °C, where the ice and water
+formulas themselves disagree). Pressures are in kPa and each cubic is in the
+normalized position t = (T - T0) / STEP, which keeps all four coefficients
+representable in Q15.16 for the FixedQ16 copy of the table.
+
+The generator samples every segment against the exact formula and refuses
+to write a float table beyond MAX_REL_ERROR or a Q16 table beyond
+MAX_Q16_ERROR.
+"""
+
+import math
+import os
+import struct
+
+T_MIN = -50.0       # °C, first knot
+STEP = 2.5          # °C per segment
+SEGMENTS = 60       # T_MIN + SEGMENTS * STEP = 100 °C
+SAMPLES = 100       # error check points per segment
+MAX_REL_ERROR = 2e-5
+MAX_Q16_ERROR = 4 / 65536.0  # kPa, absolute
+ZERO_SEGMENT = int(round(-T_MIN / STEP))  # 0 °C must fall on a knot
+
+# Hyland-Wexler coefficients; keep in sync with HW_OVER_WATER/HW_OVER_ICE in Psychrometrics.h
+WATER = (-5800.2206, 1.3914993, -0.048640239, 0.000041764768, -0.000000014452093, 0, 6.5459673)
+ICE = (-5674.5359, 6.3925247, -0.009677843, 0.00000062215701, 2.0747825E-09, -9.484024E-13, 4.1635019)
+
+
+def exact(T, ice):
+    """Return (P_ws, dP_ws/dT) in kPa from the exact formula on the given branch."""
+    C1, C2, C3, C4, C5, C6, C7 = ICE if ice else WATER
+    T_K = T + 273.15
+    ln_p = C1 / T_K + C2 + T_K * (C3 + T_K * (C4 + T_K * (C5 + T_K * C6))) + C7 * math.log(T_K)
+    dln_p = -C1 / (T_K * T_K) + C3 + T_K * (2 * C4 + T_K * (3 * C5 + T_K * 4 * C6)) + C7 / T_K
+    p = math.exp(ln_p) / 1000
+    return p, p * dln_p
+
+
+def to_float32(x):
+    return struct.unpack("<f", struct.pack("<f", x))[0]
+
+
+def to_q16(x):
+    return int(round(x * 65536))
+
+
+def segment(k):
+    """Cubic b0 + b1*t + b2*t^2 + b3*t^3 in t = (T - T0) / STEP, unrounded."""
+    T0 = T_MIN + k * STEP
+    ice = T0 < 0
+    p0, s0 = exact(T0, ice)
+    p1, s1 = exact(T0 + STEP, ice)
+    d0 = s0 * STEP
+    d1 = s1 * STEP
+    return [p0, d0, 3 * (p1 - p0) - 2 * d0 - d1, 2 * (p0 - p1) + d0 + d1]
+
+
+def max_error(coeffs, relative):
+    worst = 0.0
+    for k, (b0, b1, b2, b3) in enumerate(coeffs):
+        T0 = T_MIN + k * STEP
+        for j in range(SAMPLES + 1):
+            t = j / SAMPLES
+            p = b0 + t * (b1 + t * (b2 + t * b3))
+            ref, _ = exact(T0 + t * STEP, T0 < 0)
+            worst = max(worst, abs(p / ref - 1) if relative else abs(p - ref))
+    return worst
+
+
+def render(floats, q16, error, q16_error):
+    float_rows = "\n".join(
+        "    {{ {:.9g}f, {:.9g}f, {:.9g}f, {:.9g}f }},  // {:g} °C".format(*c, T_MIN + k * STEP)
+        for k, c in enumerate(floats))
+    q16_rows = "\n".join(
+        "    {{ {}, {}, {}, {} }},  // {:g} °C".format(*c, T_MIN + k * STEP)
+        for k, c in enumerate(q16))
+    return """// Generated by scripts/pws_table.py - do not edit.
+// Piecewise cubic Hermite fit of the Hyland-Wexler saturation pressure (unit: kPa).
+// Max relative error against the exact formula: {error:.2e} (float), max absolute: {q16_error:.2e} kPa (Q16)
+#ifndef PWS_TABLE_H
+#define PWS_TABLE_H
+
+#include <stdint.h>
+
+#ifdef __AVR__
+#include <avr/pgmspace.h>
+#else
+#define PROGMEM
+#define pgm_read_float(addr) (*(const float*)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t*)(addr))
+#endif
+
+#define PWS_TABLE_T_MIN {t_min:.1f}
+#define PWS_TABLE_STEP {step:.1f}
+#define PWS_TABLE_SEGMENTS {segments}
+#define PWS_TABLE_ZERO_SEGMENT {zero}  // First segment on the over-water branch
+
+// Row k covers [T_MIN + k * STEP, T_MIN + (k + 1) * STEP) as b0 + b1*t + b2*t^2 + b3*t^3, t = (T - T0) / STEP
+static const float pwsTable[PWS_TABLE_SEGMENTS][4] PROGMEM = {{
+{float_rows}
+}};
+
+// The same rows as raw FixedQ16 values
+static const int32_t pwsTableQ16[PWS_TABLE_SEGMENTS][4] PROGMEM = {{
+{q16_rows}
+}};
+
+#endif
+""".format(error=error, q16_error=q16_error, t_min=T_MIN, step=STEP, segments=SEGMENTS, zero=ZERO_SEGMENT,
+           float_rows=float_rows, q16_rows=q16_rows)
+
+
+def generate(project_dir):
+    coeffs = [segment(k) for k in range(SEGMENTS)]
+    floats = [[to_float32(b) for b in c] for c in coeffs]
+    q16 = [[to_q16(b) for b in c] for c in coeffs]
+
+    error = max_error(floats, True)
+    if error > MAX_REL_ERROR:
+        raise SystemExit("P_ws table error {:.2e} exceeds bound {:.2e}".format(error, MAX_REL_ERROR))
+    q16_error = max_error([[b / 65536.0 for b in c] for c in q16], False)
+    if q16_error > MAX_Q16_ERROR:
+        raise SystemExit("P_ws Q16 table error {:.2e} kPa exceeds bound {:.2e}".format(q16_error, MAX_Q16_ERROR))
+
+    path = os.path.join(project_dir, "lib", "Psychrometrics", "src", "PwsTable.h")
+    text = render(floats, q16, error, q16_error)
+    current = None
+    if os.path.exists(path):
+        with open(path, newline="") as f:
+            current = f.read().replace("\r\n", "\n")
+    if current != text:
+        with open(path, "w", newline="\r\n") as f:
+            f.write(text)
+        print("Generated {} (max rel error {:.2e}, Q16 abs error {:.2e} kPa)".format(path, error, q16_error))
+
+
+try:
+    Import("env")  # noqa: F821 - provided when run as a PlatformIO extra script
+    PROJECT_DIR = env.subst("$PROJECT_DIR")  # noqa: F821
+except NameError:
+    PROJECT_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+generate(PROJECT_DIR)
@@ -1,21 +1,280 @@
 #include "DataTransmitter.h"
 
-void DataTransmitter::begin() {
-    // Initialize any necessary components for data transmission
-    // For now, we'll just use Serial, which is already initialized in main.cpp
+DataTransmitter::DataTransmitter()
+    : format(FORMAT_CSV), stateSeq(0), baud(9600), replaying(false),
+      replaySeq(0), replayEnd(0), replayBaud(0), replayStart(0) {
+#ifdef TELEMETRY
+    telemetryStage = PSYCHRO_TELEMETRY_STAGES;
+    telemetryLineLength = 0;
+    telemetryLineSent = 0;
+#endif
 }
 
-void DataTransmitter::sendData(float dryBulbTemp, float wetBulbTemp, float relativeHumidity, float dewPoint, float absoluteHumidity, float partialPressure, float specificVolume, float enthalpy) {
-    // Send data in CSV format with increased precision
-    String dataString = String(dryBulbTemp, 2) + "," +
-                       String(wetBulbTemp, 2) + "," +
-                       String(relativeHumidity, 4) + "," +
-                       String(dewPoint, 2) + "," +
-                       String(absoluteHumidity, 5) + "," +
-                       String(partialPressure, 2) + "," +
-                       String(specificVolume, 3) + "," +
-                       String(enthalpy, 2);
+void DataTransmitter::begin(Format format, unsigned long baud, PsychroLogSpill* spill) {
+    // Serial itself is initialized in main.cpp
+    this->format = format;
+    this->baud = baud;
+    log.setSpill(spill);
+}
+
+void DataTransmitter::sendData(const PsychroState& state) {
+    sendData(&state, 1);
+}
+
+void DataTransmitter::sendData(const PsychroState* states, uint8_t count) {
+    if (count == 0) {
+        return;
+    }
+
+    // Every sample is logged under the seq its state frame carries, in CSV mode too
+    PsychroRawSampleFrame sample;
+    sample.header.seq = stateSeq;
+    sample.header.timestamp = millis();
+    sample.dryBulbTemp = psychroWireInt16(states[0].dryBulbTemp, PSYCHRO_SCALE_TEMP);
+    sample.wetBulbTemp = psychroWireInt16(states[0].wetBulbTemp, PSYCHRO_SCALE_TEMP);
+    log.push(sample);
+
+    if (format == FORMAT_BINARY && count > 1) {
+        sendMultiFrame(states, count);
+    } else if (format == FORMAT_BINARY) {
+        sendFrame(states[0]);
+    } else {
+        sendCsv(states[0]);
+    }
+    stateSeq++;
+}
+
+void DataTransmitter::poll() {
+    while (Serial.available() > 0) {
+        if (!requests.push((uint8_t)Serial.read())) {
+            continue;
+        }
+        if (requests.type() == FRAME_BACKFILL_REQUEST) {
+            PsychroBackfillRequestFrame request;
+            if (requests.read(request) && !replaying) {
+                startBackfill(request);
+            }
+        } else if (requests.type() == FRAME_LOG_ACK) {
+            // Samples acknowledged mid-replay are simply skipped by it
+            PsychroLogAckFrame ack;
+            if (requests.read(ack)) {
+                log.acknowledge(ack.nextSeq);
+            }
+        }
+    }
+
+    if (replaying) {
+        continueBackfill();
+    }
+}
+
+void DataTransmitter::sendCsv(const PsychroState& state) {
+#ifdef TELEMETRY
+    // A sample never waits for a telemetry line: cut the line short, which
+    // both readers drop, and send it again whole afterwards
+    if (telemetryLineSent > 0) {
+        Serial.println();
+        telemetryLineSent = 0;
+    }
+    int room = Serial.availableForWrite();
+#endif
+    // Send data in CSV format with increased precision, printed field by
+    // field so no String is built on the heap
+    size_t written = Serial.print(state.dryBulbTemp, 2);
+    written += Serial.print(',');
+    written += Serial.print(state.wetBulbTemp, 2);
+    written += Serial.print(',');
+    written += Serial.print(state.relativeHumidity, 4);
+    written += Serial.print(',');
+    written += Serial.print(state.dewPoint, 2);
+    written += Serial.print(',');
+    written += Serial.print(state.absoluteHumidity, 5);
+    written += Serial.print(',');
+    written += Serial.print(state.partialPressure, 2);
+    written += Serial.print(',');
+    written += Serial.print(state.specificVolume, 3);
+    written += Serial.print(',');
+    written += Serial.println(state.enthalpy, 2);
+#ifdef TELEMETRY
+    telemetry.serial(written, written > (size_t)room);
+#endif
+}
+
+void DataTransmitter::sendFrame(const PsychroState& state) {
+    PsychroStateFrame frame;
+    frame.header.seq = stateSeq;
+    frame.header.timestamp = millis();
+    // A dew point without vapor is NaN; it goes out as PSYCHRO_MISSING_INT16
+    frame.dryBulbTemp = psychroWireInt16(state.dryBulbTemp, PSYCHRO_SCALE_TEMP);
+    frame.wetBulbTemp = psychroWireInt16(state.wetBulbTemp, PSYCHRO_SCALE_TEMP);
+    frame.relativeHumidity = psychroWireUint16(state.relativeHumidity, PSYCHRO_SCALE_RH);
+    frame.dewPoint = psychroWireInt16(state.dewPoint, PSYCHRO_SCALE_TEMP);
+    frame.absoluteHumidity = psychroWireUint16(state.absoluteHumidity, PSYCHRO_SCALE_W);
+    frame.partialPressure = psychroWireUint32(state.partialPressure, PSYCHRO_SCALE_PRESSURE);
+    frame.specificVolume = psychroWireUint16(state.specificVolume, PSYCHRO_SCALE_VOLUME);
+    frame.enthalpy = psychroWireInt32(state.enthalpy, PSYCHRO_SCALE_ENTHALPY);
+
+    sendEncoded(FRAME_STATE, &frame, sizeof(frame));
+}
+
+void DataTransmitter::sendMultiFrame(const PsychroState* states, uint8_t count) {
+    if (count > PSYCHRO_FRAME_MAX_CHANNELS) {
+        count = PSYCHRO_FRAME_MAX_CHANNELS;
+    }
+
+    PsychroMultiStateFrame frame;
+    frame.header.seq = stateSeq;
+    frame.header.timestamp = millis();
+    frame.count = count;
+    for (uint8_t i = 0; i < count; i++) {
+        const PsychroState& state = states[i];
+        PsychroChannelState& channel = frame.channels[i];
+        channel.dryBulbTemp = psychroWireInt16(state.dryBulbTemp, PSYCHRO_SCALE_TEMP);
+        channel.wetBulbTemp = psychroWireInt16(state.wetBulbTemp, PSYCHRO_SCALE_TEMP);
+        channel.relativeHumidity = psychroWireUint16(state.relativeHumidity, PSYCHRO_SCALE_RH);
+        channel.dewPoint = psychroWireInt16(state.dewPoint, PSYCHRO_SCALE_TEMP);
+    }
+
+    sendEncoded(FRAME_MULTI_STATE, &frame, PSYCHRO_MULTI_STATE_SIZE(count));
+}
+
+void DataTransmitter::sendEncoded(uint8_t type, const void* body, size_t length) {
+    uint8_t encoded[PSYCHRO_FRAME_ENCODED_MAX];
+    size_t encodedLength = psychroEncodeFrame(type, body, length, encoded);
+#ifdef TELEMETRY
+    telemetry.serial(encodedLength, encodedLength > (size_t)Serial.availableForWrite());
+#endif
+    Serial.write(encoded, encodedLength);
+}
+
+// Drop what the host already has, announce the replay at the current rate,
+// then switch to the requested rate. The samples go out from continueBackfill().
+void DataTransmitter::startBackfill(const PsychroBackfillRequestFrame& request) {
+    log.acknowledge(request.fromSeq);
+
+    replaySeq = log.oldestSeq();
+    replayEnd = log.endSeq();  // Later samples reach the host live
+    replayBaud = request.baud != baud ? request.baud : 0;
+
+    PsychroBackfillBeginFrame begin;
+    begin.firstSeq = replaySeq;
+    begin.count = log.size();
+    begin.baud = replayBaud;
+    sendEncoded(FRAME_BACKFILL_BEGIN, &begin, sizeof(begin));
+
+    if (replayBaud) {
+        Serial.flush();
+        Serial.begin(replayBaud);
+    }
+    replayStart = millis();
+    replaying = true;
+}
+
+// Send as many logged samples as fit in the TX buffer without blocking
+void DataTransmitter::continueBackfill() {
+    if (millis() - replayStart < BACKFILL_SETTLE_MS) {
+        return;
+    }
+
+    PsychroRawSampleFrame sample;
+    while (replaySeq != replayEnd && Serial.availableForWrite() >= (int)(sizeof(sample) + 5)) {
+        if (log.get(replaySeq, sample)) {
+            sendEncoded(FRAME_RAW_SAMPLE, &sample, sizeof(sample));
+        }
+        replaySeq++;
+    }
+    if (replaySeq != replayEnd) {
+        return;
+    }
+
+    PsychroBackfillEndFrame end;
+    end.nextSeq = replayEnd;
+    sendEncoded(FRAME_BACKFILL_END, &end, sizeof(end));
+    if (replayBaud) {
+        Serial.flush();
+        Serial.begin(baud);
+    }
+    replaying = false;
+}
+
+#ifdef TELEMETRY
+// One frame per call so the report never stalls the loop: the counters when a
+// report falls due, then a span frame per stage. Spans keep accumulating until
+// their frame goes out, a few passes later at most.
+void DataTransmitter::sendTelemetry() {
+    // The host reads a replay at its own rate; keep reports out of it
+    if (replaying) {
+        return;
+    }
+    // A CSV line of hex never fits the TX buffer; it goes out over several
+    // passes before the next frame is taken
+    if (telemetryLineLength > 0) {
+        continueTelemetryLine();
+        return;
+    }
+    if (format == FORMAT_BINARY && Serial.availableForWrite() < (int)sizeof(PsychroTelemetrySpanFrame) + 5) {
+        return;
+    }
+
+    if (telemetryStage == PSYCHRO_TELEMETRY_STAGES) {
+        unsigned long now = millis();
+        if (!telemetry.due(now)) {
+            return;
+        }
+        PsychroTelemetryFrame report;
+        telemetry.report(report, now, telemetryFreeSram(), telemetryMinFreeSram());
+        sendTelemetryFrame(FRAME_TELEMETRY, &report, sizeof(report));
+        telemetryStage = 0;
+        return;
+    }
+
+    PsychroTelemetrySpanFrame span;
+    telemetry.reportSpan(telemetryStage++, span);
+    sendTelemetryFrame(FRAME_TELEMETRY_SPAN, &span, sizeof(span));
+}
+
+// Binary mode sends the frame as usual. CSV mode sends '#' and the unencoded
+// type | body | crc16 in hex on a line of its own, which webapp/server.js
+// skips and the ingest daemon decodes. Neither is in the serial counters.
+void DataTransmitter::sendTelemetryFrame(uint8_t type, const void* body, size_t length) {
+    if (format == FORMAT_BINARY) {
+        uint8_t encoded[PSYCHRO_FRAME_ENCODED_MAX];
+        Serial.write(encoded, psychroEncodeFrame(type, body, length, encoded));
+        return;
+    }
+
+    if (length + 3 > sizeof(telemetryLine)) {
+        return;
+    }
+    telemetryLine[0] = type;
+    memcpy(telemetryLine + 1, body, length);
+    uint16_t crc = psychroCrc16(telemetryLine, length + 1);
+    telemetryLine[length + 1] = (uint8_t)crc;
+    telemetryLine[length + 2] = (uint8_t)(crc >> 8);
+    telemetryLineLength = length + 3;
+    telemetryLineSent = 0;
+    continueTelemetryLine();
+}
 
-    // Send data over Serial
-    Serial.println(dataString);
+// Write as much of the pending line as the TX buffer takes without blocking
+void DataTransmitter::continueTelemetryLine() {
+    static const char digits[] = "0123456789abcdef";
+    uint8_t total = 1 + 2 * telemetryLineLength + 2;  // '#', hex, CR LF
+    int room = Serial.availableForWrite();
+    for (; room > 0 && telemetryLineSent < total; room--, telemetryLineSent++) {
+        uint8_t i = telemetryLineSent;
+        if (i == 0) {
+            Serial.write('#');
+        } else if (i < total - 2) {
+            uint8_t byte = telemetryLine[(i - 1) / 2];
+            Serial.write(digits[i % 2 ? byte >> 4 : byte & 0x0F]);
+        } else {
+            Serial.write(i == total - 2 ? '\r' : '\n');
+        }
+    }
+    if (telemetryLineSent == total) {
+        telemetryLineLength = 0;
+        telemetryLineSent = 0;
+    }
 }
+#endif
@@ -0,0 +1,18 @@
+#include "EepromLogSpill.h"
+#include "SensorManager.h"
+#include <EEPROM.h>
+
+static_assert(SENSOR_CACHE_EEPROM_ADDR + sizeof(SensorAddressCache) <= EEPROM_LOG_SPILL_BASE,
+              "Sensor address cache overlaps the log spill");
+
+uint16_t EepromLogSpill::capacity() const {
+    return (EEPROM.length() - EEPROM_LOG_SPILL_BASE) / sizeof(PsychroRawSampleFrame);
+}
+
+void EepromLogSpill::write(uint16_t slot, const PsychroRawSampleFrame& sample) {
+    EEPROM.put(EEPROM_LOG_SPILL_BASE + slot * sizeof(PsychroRawSampleFrame), sample);
+}
+
+void EepromLogSpill::read(uint16_t slot, PsychroRawSampleFrame& sample) const {
+    EEPROM.get(EEPROM_LOG_SPILL_BASE + slot * sizeof(PsychroRawSampleFrame), sample);
+}
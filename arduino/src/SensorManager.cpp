@@ -1,67 +1,300 @@
 #include "SensorManager.h"
+#include "Debug.h"
+#include "Telemetry.h"
+#include <EEPROM.h>
+#include <PsychroFrame.h>
 
 #define ONE_WIRE_BUS 2
+
+// Discovery order within a pair; pair 0 keeps the original single-pair wiring
 #define DRY_BULB_SENSOR_INDEX 1
 #define WET_BULB_SENSOR_INDEX 0
 
-SensorManager::SensorManager() : oneWire(ONE_WIRE_BUS), sensors(&oneWire) {}
+SensorManager::SensorManager()
+    : cachedBoot(false), oneWire(ONE_WIRE_BUS), sensors(&oneWire), pairCount(0),
+      pairTable(0), pairTableCount(0), resolution(12), samplePeriod(2000), conversionTime(750), conversionStart(0),
+      converting(false), sampleReady(false) {
+    for (uint8_t pair = 0; pair < SENSOR_MAX_PAIRS; pair++) {
+        dryBulbTemp[pair] = DEVICE_DISCONNECTED_C;
+        wetBulbTemp[pair] = DEVICE_DISCONNECTED_C;
+    }
+}
 
-void SensorManager::begin() {
-    Serial.println("Initializing sensors...");
-    sensors.begin();
+void SensorManager::setPairTable(const SensorPairAddresses* pairs, uint8_t count) {
+    pairTable = pairs;
+    pairTableCount = count < SENSOR_MAX_PAIRS ? count : SENSOR_MAX_PAIRS;
+}
+
+void SensorManager::begin(uint8_t resolution, unsigned long samplePeriodMs) {
+    DEBUG_PRINTLN("Initializing sensors...");
+    this->resolution = resolution;
+
+    // A full search costs several ms per device; known addresses only need
+    // one scratchpad write each, done by replaceMissing() below
+    if (pairTableCount > 0) {
+        DEBUG_PRINTLN("Using the sensor pair table");
+        pairCount = 0;
+        for (uint8_t pair = 0; pair < pairTableCount; pair++) {
+            assignPair(pair, pairTable[pair].dryBulb, pairTable[pair].wetBulb);
+        }
+        cachedBoot = true;
+    } else if (loadCache()) {
+        DEBUG_PRINTLN("Using cached sensor addresses");
+        cachedBoot = true;
+    } else {
+        discover();
+        cachedBoot = false;
+    }
+    // A sensor that stopped answering is searched for on its own; every
+    // other pair keeps its sensors
+    if (replaceMissing() > 0) {
+        saveCache();
+        cachedBoot = false;
+    }
 
-    // Count devices
-    int deviceCount = sensors.getDeviceCount();
-    Serial.print("Found ");
-    Serial.print(deviceCount);
-    Serial.println(" devices.");
+    // Conversions run in the background; poll() collects them
+    sensors.setWaitForConversion(false);
 
-    if (!sensors.getAddress(dryBulbAddress, DRY_BULB_SENSOR_INDEX)) {
-        Serial.println("ERROR: Unable to find address for Dry Bulb Sensor");
+    for (uint8_t pair = 0; pair < pairCount; pair++) {
+        DEBUG_PRINT("Pair ");
+        DEBUG_PRINT(pair);
+        DEBUG_PRINT(" Dry Bulb: ");
+        printAddress(dryBulbAddress[pair]);
+        DEBUG_PRINT(" Wet Bulb: ");
+        printAddress(wetBulbAddress[pair]);
+        DEBUG_PRINTLN();
+    }
+    if (pairCount == 0) {
+        DEBUG_PRINTLN("ERROR: Unable to find a dry/wet bulb sensor pair");
         return;
     }
 
-    if (!sensors.getAddress(wetBulbAddress, WET_BULB_SENSOR_INDEX)) {
-        Serial.println("ERROR: Unable to find address for Wet Bulb Sensor");
+    // replaceMissing() already configured every sensor
+    conversionTime = sensors.millisToWaitForConversion(resolution);
+    setSamplePeriod(samplePeriodMs);
+
+    DEBUG_PRINT("Conversion time: ");
+    DEBUG_PRINT(conversionTime);
+    DEBUG_PRINTLN(" ms");
+
+    // Start the first conversion; the first sample arrives through poll()
+    startConversion(millis());
+}
+
+void SensorManager::poll() {
+    if (pairCount == 0) {
         return;
     }
+    unsigned long now = millis();
+
+    if (converting) {
+        if (!conversionComplete(now)) {
+            return;
+        }
+        telemetrySpan(STAGE_CONVERSION, (now - conversionStart) * 1000UL);
+
+        // One bus-wide conversion serves every pair
+        TelemetrySpan read(STAGE_SENSOR_READ);
+        for (uint8_t pair = 0; pair < pairCount; pair++) {
+            dryBulbTemp[pair] = sensors.getTempC(dryBulbAddress[pair]);
+            wetBulbTemp[pair] = sensors.getTempC(wetBulbAddress[pair]);
+        }
+        converting = false;
+        sampleReady = true;
+    }
+
+    // Start the next conversion as soon as the period allows, so it runs
+    // while the caller processes the sample just collected
+    if (now - conversionStart >= samplePeriod) {
+        startConversion(now);
+    }
+}
+
+bool SensorManager::ready() {
+    if (!sampleReady) {
+        return false;
+    }
+    sampleReady = false;
+    return true;
+}
+
+void SensorManager::setResolution(uint8_t resolution) {
+    this->resolution = resolution;
+    for (uint8_t pair = 0; pair < pairCount; pair++) {
+        sensors.setResolution(dryBulbAddress[pair], resolution);
+        sensors.setResolution(wetBulbAddress[pair], resolution);
+    }
+    conversionTime = sensors.millisToWaitForConversion(resolution);  // 94 ms at 9 bit .. 750 ms at 12 bit
+}
+
+void SensorManager::setSamplePeriod(unsigned long samplePeriodMs) {
+    samplePeriod = samplePeriodMs;
+}
 
-    Serial.print("Dry Bulb Sensor Address: ");
-    printAddress(dryBulbAddress);
-    Serial.println();
+unsigned long SensorManager::getConversionTime() {
+    return conversionTime;
+}
 
-    Serial.print("Wet Bulb Sensor Address: ");
-    printAddress(wetBulbAddress);
-    Serial.println();
+uint8_t SensorManager::getPairCount() {
+    return pairCount;
+}
 
-    sensors.setResolution(dryBulbAddress, 12);
-    sensors.setResolution(wetBulbAddress, 12);
+void SensorManager::rescan() {
+    discover();
+    setResolution(resolution);
+}
 
-    // Request initial temperature reading
-    Serial.println("Requesting initial temperatures...");
-    sensors.requestTemperatures();
-    delay(1000); // Allow sensors to stabilize
-    
-    // Print initial readings
-    float dryTemp = getDryBulbTemperature();
-    float wetTemp = getWetBulbTemperature();
-    Serial.print("Initial Dry Bulb Temperature: ");
-    Serial.println(dryTemp);
-    Serial.print("Initial Wet Bulb Temperature: ");
-    Serial.println(wetTemp);
+bool SensorManager::assignPair(uint8_t pair, const DeviceAddress dryBulb, const DeviceAddress wetBulb) {
+    if (pair >= SENSOR_MAX_PAIRS || pair > pairCount) {
+        return false;
+    }
+    memcpy(dryBulbAddress[pair], dryBulb, sizeof(DeviceAddress));
+    memcpy(wetBulbAddress[pair], wetBulb, sizeof(DeviceAddress));
+    if (pair == pairCount) {
+        pairCount++;
+    }
+    sensors.setResolution(dryBulbAddress[pair], resolution);
+    sensors.setResolution(wetBulbAddress[pair], resolution);
+    saveCache();
+    return true;
+}
+
+// Valid if the CRC matches; sensors that no longer answer are left to
+// replaceMissing(). Parasite powered buses still need begin(), which is what
+// enables the strong pull-up during conversions.
+bool SensorManager::loadCache() {
+    SensorAddressCache cache;
+    EEPROM.get(SENSOR_CACHE_EEPROM_ADDR, cache);
+    if (cache.magic != SENSOR_CACHE_MAGIC || cache.pairCount == 0 || cache.pairCount > SENSOR_MAX_PAIRS
+        || cache.crc != psychroCrc16((const uint8_t*)&cache, offsetof(SensorAddressCache, crc))) {
+        return false;
+    }
+    if (sensors.readPowerSupply()) {
+        return false;
+    }
+
+    pairCount = cache.pairCount;
+    memcpy(dryBulbAddress, cache.dryBulb, sizeof(dryBulbAddress));
+    memcpy(wetBulbAddress, cache.wetBulb, sizeof(wetBulbAddress));
+    return true;
+}
+
+void SensorManager::saveCache() {
+    SensorAddressCache cache;
+    memset(&cache, 0, sizeof(cache));
+    cache.magic = SENSOR_CACHE_MAGIC;
+    cache.pairCount = pairCount;
+    memcpy(cache.dryBulb, dryBulbAddress, sizeof(dryBulbAddress));
+    memcpy(cache.wetBulb, wetBulbAddress, sizeof(wetBulbAddress));
+    cache.crc = psychroCrc16((const uint8_t*)&cache, offsetof(SensorAddressCache, crc));
+
+    // EEPROM.put() only rewrites the bytes that differ, so an unchanged
+    // assignment costs no wear
+    EEPROM.put(SENSOR_CACHE_EEPROM_ADDR, cache);
+}
+
+// Full bus search: consecutive devices in ROM order form the pairs. ROM order
+// says nothing about which sensor is wet or which zone it sits in, so this is
+// only the first-boot default until assignPair() or a pair table sets them.
+void SensorManager::discover() {
+    sensors.begin();
+
+    uint8_t deviceCount = sensors.getDeviceCount();
+    DEBUG_PRINT("Found ");
+    DEBUG_PRINT(deviceCount);
+    DEBUG_PRINTLN(" devices.");
+
+    pairCount = 0;
+    while (pairCount < SENSOR_MAX_PAIRS && pairCount * 2 + 1 < deviceCount) {
+        if (!sensors.getAddress(dryBulbAddress[pairCount], pairCount * 2 + DRY_BULB_SENSOR_INDEX)
+            || !sensors.getAddress(wetBulbAddress[pairCount], pairCount * 2 + WET_BULB_SENSOR_INDEX)) {
+            break;
+        }
+        pairCount++;
+    }
+    if (pairCount > 0) {
+        saveCache();
+    }
+}
+
+// Configure every assigned sensor; those that do not answer are swapped, in
+// pair order, for answering devices that are in no pair. One bus search
+// serves them all, and only when something is missing. Returns the number
+// of sensors replaced.
+uint8_t SensorManager::replaceMissing() {
+    uint8_t* missing[SENSOR_MAX_PAIRS * 2];
+    uint8_t missingCount = 0;
+    for (uint8_t pair = 0; pair < pairCount; pair++) {
+        if (!sensors.setResolution(dryBulbAddress[pair], resolution)) {
+            missing[missingCount++] = dryBulbAddress[pair];
+        }
+        if (!sensors.setResolution(wetBulbAddress[pair], resolution)) {
+            missing[missingCount++] = wetBulbAddress[pair];
+        }
+    }
+    if (missingCount == 0) {
+        return 0;
+    }
+
+    DEBUG_PRINT(missingCount);
+    DEBUG_PRINTLN(" sensors missing, searching the bus");
+    sensors.begin();
+    uint8_t replaced = 0;
+    uint8_t deviceCount = sensors.getDeviceCount();
+    DeviceAddress address;
+    for (uint8_t index = 0; index < deviceCount && replaced < missingCount; index++) {
+        if (!sensors.getAddress(address, index) || isAssigned(address)) {
+            continue;
+        }
+        DEBUG_PRINT("Replacing ");
+        printAddress(missing[replaced]);
+        DEBUG_PRINT(" with ");
+        printAddress(address);
+        DEBUG_PRINTLN();
+        memcpy(missing[replaced], address, sizeof(DeviceAddress));
+        sensors.setResolution(address, resolution);
+        replaced++;
+    }
+    return replaced;
+}
+
+bool SensorManager::isAssigned(const DeviceAddress address) {
+    for (uint8_t pair = 0; pair < pairCount; pair++) {
+        if (memcmp(address, dryBulbAddress[pair], sizeof(DeviceAddress)) == 0
+            || memcmp(address, wetBulbAddress[pair], sizeof(DeviceAddress)) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void SensorManager::startConversion(unsigned long now) {
+    TelemetrySpan span(STAGE_SENSOR_START);
+    sensors.requestTemperatures();  // Returns immediately with setWaitForConversion(false)
+    conversionStart = now;
+    converting = true;
+}
+
+bool SensorManager::conversionComplete(unsigned long now) {
+    if (now - conversionStart >= conversionTime) {
+        return true;
+    }
+    // With external power the sensors hold the bus low until they finish, which
+    // is usually well before the datasheet worst case; parasite power cannot be polled
+    return !sensors.isParasitePowerMode() && sensors.isConversionComplete();
 }
 
-float SensorManager::getDryBulbTemperature() {
-    return sensors.getTempC(dryBulbAddress);
+float SensorManager::getDryBulbTemperature(uint8_t pair) {
+    return pair < pairCount ? dryBulbTemp[pair] : DEVICE_DISCONNECTED_C;
 }
 
-float SensorManager::getWetBulbTemperature() {
-    return sensors.getTempC(wetBulbAddress);
+float SensorManager::getWetBulbTemperature(uint8_t pair) {
+    return pair < pairCount ? wetBulbTemp[pair] : DEVICE_DISCONNECTED_C;
 }
 
-void SensorManager::printAddress(DeviceAddress deviceAddress) {
+void SensorManager::printAddress(const DeviceAddress deviceAddress) {
     for (uint8_t i = 0; i < 8; i++) {
-        if (deviceAddress[i] < 16) Serial.print("0");
-        Serial.print(deviceAddress[i], HEX);
+        if (deviceAddress[i] < 16) DEBUG_PRINT("0");
+        DEBUG_PRINT(deviceAddress[i], HEX);
     }
 }
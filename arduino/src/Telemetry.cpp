@@ -0,0 +1,57 @@
+#include "Telemetry.h"
+
+#ifdef TELEMETRY
+
+#define SRAM_PAINT 0xA5         // Stack bytes still holding this were never used
+#define SRAM_PAINT_MARGIN 32    // Left unpainted below telemetryBegin()'s own frame
+
+PsychroTelemetry telemetry;
+
+#ifdef __AVR__
+extern char __heap_start;
+extern char* __brkval;
+
+static char* heapEnd() {
+    return __brkval ? __brkval : &__heap_start;
+}
+
+void telemetryBegin() {
+    char top;
+    for (char* p = heapEnd(); p < &top - SRAM_PAINT_MARGIN; p++) {
+        *p = SRAM_PAINT;
+    }
+    telemetry.begin(TELEMETRY_PERIOD_MS, millis());
+}
+
+uint16_t telemetryFreeSram() {
+    char top;
+    return &top - heapEnd();
+}
+
+// The stack grows down into the paint, so the untouched run above the heap
+// is what it has never needed. A used byte that happens to equal SRAM_PAINT
+// can only overstate this by a few bytes.
+uint16_t telemetryMinFreeSram() {
+    char top;
+    char* p = heapEnd();
+    while (p < &top && *p == (char)SRAM_PAINT) {
+        p++;
+    }
+    return p - heapEnd();
+}
+#else
+// No heap/stack layout to inspect on the host
+void telemetryBegin() {
+    telemetry.begin(TELEMETRY_PERIOD_MS, millis());
+}
+
+uint16_t telemetryFreeSram() {
+    return 0;
+}
+
+uint16_t telemetryMinFreeSram() {
+    return 0;
+}
+#endif
+
+#endif
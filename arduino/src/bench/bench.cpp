@@ -0,0 +1,248 @@
+// Micro-benchmark and reference report for the psychrometric code.
+//
+// [env:native] runs it on the host against lib/ArduinoMock and reports
+// ns/call. [env:bench_avr] builds it for the Mega and reports CPU cycles per
+// call from Timer1, on the board or cycle-exact under simavr:
+//   pio run -e bench_avr && simavr -m atmega2560 -f 16000000 .pio/build/bench_avr/firmware.elf
+// The numbers are for comparing changes, not absolute guarantees.
+//
+// AVR cycle counts are still outstanding: no bench_avr run on the board or
+// under simavr has been recorded yet, so computeState's cost on the Mega is
+// unmeasured. Record the computeState line here once one has.
+
+// Unit tests build src/ too (test_build_src) and bring their own main()
+#ifndef PIO_UNIT_TESTING
+
+#include <Arduino.h>
+#include "EnvironmentalCalculations.h"
+#include "SensorManager.h"
+#include "DataTransmitter.h"
+
+#ifdef __AVR__
+#include <avr/interrupt.h>
+#define BENCH_UNIT " cycles/call"
+#define BENCH_REPEAT 4
+#else
+#include <stdio.h>
+#include <chrono>
+#define BENCH_UNIT " ns/call"
+#define BENCH_REPEAT 2000
+#endif
+
+// Inputs spanning the sensors' range: saturated, humid, dry and sub-zero air
+static const float benchInputs[][2] = {
+    { -40, -40 }, { -30, -31 }, { -20, -21.5f }, { -10, -12 }, { -5, -9 },
+    { 0, -2 }, { 5, 2 }, { 10, 6 }, { 15, 10 }, { 20, 14 },
+    { 21.13f, 12.31f }, { 22, 18 }, { 25, 20 }, { 30, 22 }, { 35, 30 },
+    { 40, 20 }, { 45, 35 }, { 50, 40 }, { 60, 45 }, { 70, 50 },
+};
+static const uint8_t benchInputCount = sizeof(benchInputs) / sizeof(benchInputs[0]);
+
+// ASHRAE Handbook Fundamentals, Ch. 1 Table 3: saturation pressure (kPa),
+// over ice below 0 °C
+static const float ashraeSaturation[][2] = {
+    { -40, 0.01285f }, { -20, 0.1033f }, { -10, 0.2599f }, { 0, 0.6112f },
+    { 10, 1.228f }, { 20, 2.339f }, { 30, 4.247f }, { 40, 7.384f },
+    { 60, 19.95f }, { 80, 47.41f }, { 100, 101.4f },
+};
+
+static EnvironmentalCalculations envCalc;
+static DataTransmitter dataTransmitter;
+static SensorManager sensorManager;
+static volatile float sink;
+
+static void printText(const char* text) {
+#ifdef __AVR__
+    Serial.print(text);
+#else
+    fputs(text, stdout);
+#endif
+}
+
+static void printNumber(double value, int digits) {
+#ifdef __AVR__
+    Serial.print(value, digits);
+#else
+    printf("%.*f", digits, value);
+#endif
+}
+
+static void printLine() {
+#ifdef __AVR__
+    Serial.println();
+#else
+    putchar('\n');
+#endif
+}
+
+#ifdef __AVR__
+static volatile uint16_t timerOverflows;
+
+ISR(TIMER1_OVF_vect) {
+    timerOverflows++;
+}
+
+static void clockStart() {
+    TCCR1A = 0;
+    TCCR1B = 0;
+    TCNT1 = 0;
+    timerOverflows = 0;
+    TIFR1 = _BV(TOV1);
+    TIMSK1 = _BV(TOIE1);
+    TCCR1B = _BV(CS10);  // CPU clock, no prescaler
+}
+
+static double clockStop() {
+    TCCR1B = 0;
+    uint32_t cycles = ((uint32_t)timerOverflows << 16) | TCNT1;
+    if (TIFR1 & _BV(TOV1)) {
+        cycles += 65536;  // Overflow raced the stop
+    }
+    return cycles;
+}
+#else
+static std::chrono::steady_clock::time_point clockStarted;
+
+static void clockStart() {
+    clockStarted = std::chrono::steady_clock::now();
+}
+
+static double clockStop() {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - clockStarted).count();
+}
+#endif
+
+// Time body(dry, wet) over every input, BENCH_REPEAT times
+template <typename Body>
+static void bench(const char* name, Body body) {
+    clockStart();
+    for (uint16_t r = 0; r < BENCH_REPEAT; r++) {
+        for (uint8_t i = 0; i < benchInputCount; i++) {
+            body(benchInputs[i][0], benchInputs[i][1]);
+        }
+    }
+    double perCall = clockStop() / ((double)BENCH_REPEAT * benchInputCount);
+
+    printText(name);
+    printText(": ");
+    printNumber(perCall, 1);
+    printText(BENCH_UNIT);
+    printLine();
+}
+
+static void benchCalculations() {
+    printText("-- EnvironmentalCalculations (psychro_real)");
+    printLine();
+    bench("computeState", [](float db, float wb) { sink = envCalc.computeState(db, wb).dewPoint; });
+    bench("calculateRelativeHumidity", [](float db, float wb) { sink = envCalc.calculateRelativeHumidity(db, wb); });
+    bench("calculateDewPoint", [](float db, float wb) { sink = envCalc.calculateDewPoint(db, wb); });
+    bench("calculateAbsoluteHumidity", [](float db, float wb) { sink = envCalc.calculateAbsoluteHumidity(db, wb); });
+    bench("calculatePartialPressure", [](float db, float wb) { sink = envCalc.calculatePartialPressure(db, wb); });
+    bench("calculateSpecificVolume", [](float db, float wb) { sink = envCalc.calculateSpecificVolume(db, wb * 0.0005f); });
+    bench("calculateEnthalpy", [](float db, float wb) { sink = envCalc.calculateEnthalpy(db, wb * 0.0005f); });
+    bench("P_ws", [](float db, float) { sink = (float)P_ws(psychro_real(db)); });
+    bench("FindDew", [](float, float wb) { sink = FindDew(psychro_real(P_atm), P_ws(psychro_real(wb))).dewPoint; });
+
+    printText("-- computePsychroState by scalar type");
+    printLine();
+    bench("float", [](float db, float wb) { sink = computePsychroState<float>(db, wb).dewPoint; });
+    bench("double", [](float db, float wb) { sink = computePsychroState<double>(db, wb).dewPoint; });
+    bench("FixedQ16", [](float db, float wb) { sink = computePsychroState<FixedQ16>(db, wb).dewPoint; });
+
+#ifndef __AVR__
+    // Host only: on the board Serial and the sensor bus would dominate
+    printText("-- Firmware path (mocked Serial and sensors)");
+    printLine();
+    bench("DataTransmitter::sendData", [](float db, float wb) {
+        PsychroState state = envCalc.computeState(db, wb);
+        dataTransmitter.sendData(state);
+    });
+    bench("SensorManager::poll", [](float db, float wb) {
+        DallasTemperature::mockSetTemperature(1, db);
+        DallasTemperature::mockSetTemperature(0, wb);
+        mockAdvanceMillis(1000);
+        sensorManager.poll();
+        sink = sensorManager.ready() ? sensorManager.getDryBulbTemperature() : 0;
+    });
+#endif
+}
+
+// Solver steps per 10 °C band of dew point, for Pw exactly at saturation
+static void reportDewIterations() {
+    printText("-- FindDew iterations by dew point band: mean max unconverged");
+    printLine();
+    for (int8_t band = -50; band < 100; band += 10) {
+        uint16_t total = 0;
+        uint8_t worst = 0;
+        uint8_t unconverged = 0;
+        uint8_t count = 0;
+        for (float T = band + 0.25f; T < band + 10; T += 0.5f) {
+            DewPointResult dew = FindDew(psychro_real(P_atm), P_ws(psychro_real(T)));
+            total += dew.iterations;
+            worst = dew.iterations > worst ? dew.iterations : worst;
+            unconverged += dew.converged ? 0 : 1;
+            count++;
+        }
+        printNumber(band, 0);
+        printText("..");
+        printNumber(band + 10, 0);
+        printText(": ");
+        printNumber((double)total / count, 2);
+        printText(" ");
+        printNumber(worst, 0);
+        printText(" ");
+        printNumber(unconverged, 0);
+        printLine();
+    }
+}
+
+// Deviation from published values and from the identities of saturated air
+static void reportReference() {
+    printText("-- P_ws against ASHRAE: T, kPa, relative deviation");
+    printLine();
+    for (uint8_t i = 0; i < sizeof(ashraeSaturation) / sizeof(ashraeSaturation[0]); i++) {
+        float P = (float)P_ws(psychro_real(ashraeSaturation[i][0]));
+        printNumber(ashraeSaturation[i][0], 0);
+        printText(": ");
+        printNumber(P, 5);
+        printText(" ");
+        printNumber(P / ashraeSaturation[i][1] - 1, 5);
+        printLine();
+    }
+
+    printText("-- Saturated air (dry = wet): T, RH - 1, dew point - T");
+    printLine();
+    for (int8_t T = -40; T <= 70; T += 10) {
+        PsychroState state = envCalc.computeState(T, T);
+        printNumber(T, 0);
+        printText(": ");
+        printNumber(state.relativeHumidity - 1, 5);
+        printText(" ");
+        printNumber(state.dewPoint - T, 4);
+        printLine();
+    }
+}
+
+static void runBench() {
+    dataTransmitter.begin(DataTransmitter::FORMAT_BINARY);
+    sensorManager.begin(12, 0);
+    benchCalculations();
+    reportDewIterations();
+    reportReference();
+}
+
+#ifdef __AVR__
+void setup() {
+    Serial.begin(115200);
+    runBench();
+}
+
+void loop() {}
+#else
+int main() {
+    runBench();
+    return 0;
+}
+#endif
+
+#endif
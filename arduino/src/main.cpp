@@ -2,83 +2,177 @@
 #include "SensorManager.h"
 #include "EnvironmentalCalculations.h"
 #include "DataTransmitter.h"
+#include "Debug.h"
+#include "Telemetry.h"
+#include <PsychroReport.h>
+#ifdef SAMPLE_LOG_EEPROM
+#include "EepromLogSpill.h"
+#endif
+#ifdef SENSOR_PAIRS
+#include "SensorPairs.h"
+#endif
+
+#define SENSOR_RESOLUTION 12   // 9..12 bit: 94 ms .. 750 ms per conversion
+
+// Reporting stage, see lib/PsychroReport. Deadbands of 0 and a heartbeat of
+// 1 ms send every sample, as before.
+#define REPORT_FILTER FILTER_IIR
+#define REPORT_WINDOW 4             // Moving average length
+#define REPORT_ALPHA 0.5f           // IIR weight of the newest reading
+#define REPORT_DEADBAND_TEMP 0.1f   // °C, about 1.5 DS18B20 LSB at 12 bit
+#define REPORT_DEADBAND_RH 0.005f   // 0.5 %RH
+#define REPORT_HEARTBEAT_MS 60000   // Longest silence on the link
+#define SAMPLE_PERIOD_FAST_MS 2000  // While values are changing
+#define SAMPLE_PERIOD_SLOW_MS 16000 // Once they have settled
+#define REPORT_STABLE_SAMPLES 5     // Quiet samples before the period doubles
+#define SERIAL_BAUD 9600       // Steady-state rate; backfill bursts may run faster
+
+#ifdef TRANSMIT_BINARY
+#define TRANSMIT_FORMAT DataTransmitter::FORMAT_BINARY
+#else
+#define TRANSMIT_FORMAT DataTransmitter::FORMAT_CSV
+#endif
+
+static_assert(SENSOR_MAX_PAIRS <= PSYCHRO_REPORT_MAX_CHANNELS, "Reporter cannot track every sensor pair");
+static_assert(SENSOR_MAX_PAIRS <= PSYCHRO_FRAME_MAX_CHANNELS, "Sensor pairs do not fit in one multi-state frame");
 
 SensorManager sensorManager;
 EnvironmentalCalculations envCalc;
 DataTransmitter dataTransmitter;
+PsychroReporter reporter;
+#ifdef SAMPLE_LOG_EEPROM
+EepromLogSpill logSpill;
+#define LOG_SPILL &logSpill
+#else
+#define LOG_SPILL 0
+#endif
 
 void setup() {
-    Serial.begin(9600);
-    delay(1000);  // Give serial connection time to establish
-    
-    Serial.println("Starting setup...");
-    sensorManager.begin();
-    dataTransmitter.begin();
-    Serial.println("Setup complete!");
+    telemetryBegin();
+    Serial.begin(SERIAL_BAUD);
+
+    DEBUG_PRINTLN("Starting setup...");
+#ifdef SENSOR_PAIRS
+    sensorManager.setPairTable(sensorPairs, sizeof(sensorPairs) / sizeof(sensorPairs[0]));
+#endif
+    sensorManager.begin(SENSOR_RESOLUTION, SAMPLE_PERIOD_FAST_MS);
+
+    PsychroReportConfig report;
+    report.filter = REPORT_FILTER;
+    report.window = REPORT_WINDOW;
+    report.alpha = REPORT_ALPHA;
+    report.deadbandTemp = REPORT_DEADBAND_TEMP;
+    report.deadbandRH = REPORT_DEADBAND_RH;
+    report.heartbeatMs = REPORT_HEARTBEAT_MS;
+    report.fastPeriodMs = SAMPLE_PERIOD_FAST_MS;
+    report.slowPeriodMs = SAMPLE_PERIOD_SLOW_MS;
+    report.stableSamples = REPORT_STABLE_SAMPLES;
+    reporter.begin(report);
+
+    dataTransmitter.begin(TRANSMIT_FORMAT, SERIAL_BAUD, LOG_SPILL);
+    DEBUG_PRINTLN("Setup complete!");
 }
 
 void loop() {
-    Serial.println("\n--- New Reading ---");
-    
-    // Request temperatures once for both sensors
-    Serial.println("Requesting temperatures...");
-    sensorManager.sensors.requestTemperatures();
-    
-    // Read sensor data
-    float dryBulbTemp = sensorManager.getDryBulbTemperature();
-    float wetBulbTemp = sensorManager.getWetBulbTemperature();
-
-    // Add error checking
-    if (dryBulbTemp == DEVICE_DISCONNECTED_C || wetBulbTemp == DEVICE_DISCONNECTED_C) {
-        Serial.println("Error: Sensor reading failed");
-        delay(2000);
+#ifdef TELEMETRY
+    dataTransmitter.sendTelemetry();
+#endif
+    TelemetrySpan pass(STAGE_IDLE);
+
+    // Serve backfill requests from the host
+    dataTransmitter.poll();
+
+    // Advance the background conversion; nothing to do until a sample lands
+    sensorManager.poll();
+    if (!sensorManager.ready()) {
         return;
     }
+    pass.setStage(STAGE_LOOP);
+
+    DEBUG_PRINTLN("\n--- New Reading ---");
 
-    Serial.print("Raw Readings - Dry: ");
-    Serial.print(dryBulbTemp, 2);  // 2 decimal places
-    Serial.print("°C, Wet: ");
-    Serial.print(wetBulbTemp, 2);  // 2 decimal places
-    Serial.println("°C");
-
-    // Perform calculations
-    float relativeHumidity = envCalc.calculateRelativeHumidity(dryBulbTemp, wetBulbTemp);
-    float absoluteHumidity = envCalc.calculateAbsoluteHumidity(dryBulbTemp, wetBulbTemp);
-    float dewPoint = envCalc.calculateDewPoint(dryBulbTemp, wetBulbTemp);
-    float partialPressure = envCalc.calculatePartialPressure(dryBulbTemp, wetBulbTemp);
-    float specificVolume = envCalc.calculateSpecificVolume(dryBulbTemp, absoluteHumidity);
-    float enthalpy = envCalc.calculateEnthalpy(dryBulbTemp, absoluteHumidity);
-
-    // Print calculated values with increased precision
-    Serial.println("\nCalculated Values:");
-    Serial.print("Relative Humidity: "); 
-    Serial.print(relativeHumidity * 100, 2); 
-    Serial.println("%");
+    // Read every pair; the primary pair must be present, the others are
+    // sent as disconnected when their sensors fail
+    PsychroState states[SENSOR_MAX_PAIRS];
+    uint8_t pairCount = sensorManager.getPairCount();
+    if (pairCount == 0) {
+        return;
+    }
+    for (uint8_t pair = 0; pair < pairCount; pair++) {
+        float dryBulbTemp = sensorManager.getDryBulbTemperature(pair);
+        float wetBulbTemp = sensorManager.getWetBulbTemperature(pair);
+
+        // Add error checking
+        if (dryBulbTemp == DEVICE_DISCONNECTED_C || wetBulbTemp == DEVICE_DISCONNECTED_C) {
+            DEBUG_PRINT("Error: Sensor reading failed on pair ");
+            DEBUG_PRINTLN(pair);
+            if (pair == 0) {
+                return;
+            }
+            memset(&states[pair], 0, sizeof(PsychroState));
+            states[pair].dryBulbTemp = DEVICE_DISCONNECTED_C;
+            states[pair].wetBulbTemp = DEVICE_DISCONNECTED_C;
+            states[pair].dewPoint = DEVICE_DISCONNECTED_C;
+            continue;
+        }
+
+        DEBUG_PRINT("Raw Readings ");
+        DEBUG_PRINT(pair);
+        DEBUG_PRINT(" - Dry: ");
+        DEBUG_PRINT(dryBulbTemp, 2);  // 2 decimal places
+        DEBUG_PRINT("°C, Wet: ");
+        DEBUG_PRINT(wetBulbTemp, 2);  // 2 decimal places
+        DEBUG_PRINTLN("°C");
+
+        TelemetrySpan calc(STAGE_CALC);
+
+        // Smooth the readings before anything is derived from them
+        reporter.filter(pair, dryBulbTemp, wetBulbTemp);
+
+        // Perform calculations
+        states[pair] = envCalc.computeState(dryBulbTemp, wetBulbTemp);
+        telemetryDewPoint(states[pair]);
+    }
+
+    // Sample faster while any zone moves, slower once all have settled
+    bool report = reporter.update(states, pairCount, millis());
+    sensorManager.setSamplePeriod(reporter.samplePeriod());
+
+    // Print calculated values of the primary pair with increased precision
+    TelemetrySpan dump(STAGE_DEBUG);
+    DEBUG_PRINTLN("\nCalculated Values:");
+    DEBUG_PRINT("Relative Humidity: "); 
+    DEBUG_PRINT(states[0].relativeHumidity * 100, 2); 
+    DEBUG_PRINTLN("%");
     
-    Serial.print("Absolute Humidity: "); 
-    Serial.print(absoluteHumidity, 5); 
-    Serial.println(" kg/kg");
+    DEBUG_PRINT("Absolute Humidity: "); 
+    DEBUG_PRINT(states[0].absoluteHumidity, 5); 
+    DEBUG_PRINTLN(" kg/kg");
     
-    Serial.print("Dew Point: "); 
-    Serial.print(dewPoint, 2); 
-    Serial.println("°C");
+    DEBUG_PRINT("Dew Point: "); 
+    DEBUG_PRINT(states[0].dewPoint, 2); 
+    DEBUG_PRINTLN("°C");
     
-    Serial.print("Partial Pressure: "); 
-    Serial.print(partialPressure, 2); 
-    Serial.println(" Pa");
+    DEBUG_PRINT("Partial Pressure: "); 
+    DEBUG_PRINT(states[0].partialPressure, 2); 
+    DEBUG_PRINTLN(" Pa");
     
-    Serial.print("Specific Volume: "); 
-    Serial.print(specificVolume, 3); 
-    Serial.println(" m³/kg");
+    DEBUG_PRINT("Specific Volume: "); 
+    DEBUG_PRINT(states[0].specificVolume, 3); 
+    DEBUG_PRINTLN(" m³/kg");
     
-    Serial.print("Enthalpy: "); 
-    Serial.print(enthalpy, 2); 
-    Serial.println(" kJ/kg");
+    DEBUG_PRINT("Enthalpy: "); 
+    DEBUG_PRINT(states[0].enthalpy, 2); 
+    DEBUG_PRINTLN(" kJ/kg");
+    dump.done();
 
-    // Send formatted data string with full precision
-    dataTransmitter.sendData(dryBulbTemp, wetBulbTemp, relativeHumidity, 
-                           dewPoint, absoluteHumidity, partialPressure, 
-                           specificVolume, enthalpy);
+    // Only samples past a deadband, or the heartbeat, go out
+    if (!report) {
+        DEBUG_PRINTLN("Within deadband, not sent");
+        return;
+    }
 
-    delay(2000);  // Wait 2 seconds before next reading
+    // Send formatted data string with full precision
+    TelemetrySpan transmit(STAGE_TRANSMIT);
+    dataTransmitter.sendData(states, pairCount);
 }
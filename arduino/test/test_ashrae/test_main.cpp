@@ -0,0 +1,106 @@
+// Golden values for the psychrometric equations: ASHRAE saturation
+// pressures, the saturated-air identities and the sample state the original
+// firmware reported (README.md), for every scalar type it can be built with.
+// src/bench prints the same comparisons as its reference report.
+
+#include <unity.h>
+#include <math.h>
+#include <Psychrometrics.h>
+
+#define ASHRAE_MAX_RELATIVE_ERROR 4e-4f
+#define Q16_MAX_ABSOLUTE_ERROR 3e-5f  // kPa, two Q16 LSB; dominates at -40 °C
+
+void setUp() {}
+void tearDown() {}
+
+// ASHRAE Handbook Fundamentals, Ch. 1 Table 3: saturation pressure (kPa),
+// over ice below 0 °C
+static const float ashraeSaturation[][2] = {
+    { -40, 0.01285f }, { -20, 0.1033f }, { -10, 0.2599f }, { 0, 0.6112f },
+    { 10, 1.228f }, { 20, 2.339f }, { 30, 4.247f }, { 40, 7.384f },
+    { 60, 19.95f }, { 80, 47.41f }, { 100, 101.4f },
+};
+static const uint8_t ashraeCount = sizeof(ashraeSaturation) / sizeof(ashraeSaturation[0]);
+
+template <typename Real>
+static void checkSaturation(float absolute) {
+    for (uint8_t i = 0; i < ashraeCount; i++) {
+        float T = ashraeSaturation[i][0];
+        float expected = ashraeSaturation[i][1];
+        float P = (float)P_ws<Real>(Real(T));
+        TEST_ASSERT_FLOAT_WITHIN(expected * ASHRAE_MAX_RELATIVE_ERROR + absolute, expected, P);
+    }
+}
+
+// Dry bulb = wet bulb is saturated air: RH 1, dew point T
+template <typename Real>
+static void checkSaturatedAir(float rh, float dew) {
+    for (int8_t T = -40; T <= 70; T += 10) {
+        PsychroState state = computePsychroState<Real>(T, T);
+        TEST_ASSERT_FLOAT_WITHIN(rh, 1.0f, state.relativeHumidity);
+        TEST_ASSERT_FLOAT_WITHIN(dew, (float)T, state.dewPoint);
+        TEST_ASSERT_TRUE(state.dewPointConverged);
+    }
+}
+
+// README.md's sample reading, as printed by the original firmware. Dew point
+// and specific volume agree to their printed rounding; the vapor pressure
+// came out 2.5e-4 lower then, and RH, humidity ratio and enthalpy with it,
+// which README_RELATIVE_ERROR allows for.
+#define README_RELATIVE_ERROR 3e-4f
+
+template <typename Real>
+static void checkReadmeSample() {
+    PsychroState state = computePsychroState<Real>(22.19f, 13.94f);
+    TEST_ASSERT_FLOAT_WITHIN(0.3941f * README_RELATIVE_ERROR, 0.3941f, state.relativeHumidity);
+    TEST_ASSERT_FLOAT_WITHIN(0.005f, 7.75f, state.dewPoint);
+    TEST_ASSERT_FLOAT_WITHIN(0.00657f * README_RELATIVE_ERROR, 0.00657f, state.absoluteHumidity);
+    TEST_ASSERT_FLOAT_WITHIN(1054.49f * README_RELATIVE_ERROR, 1054.49f, state.partialPressure);
+    TEST_ASSERT_FLOAT_WITHIN(0.0005f, 0.846f, state.specificVolume);
+    TEST_ASSERT_FLOAT_WITHIN(39.01f * README_RELATIVE_ERROR, 39.01f, state.enthalpy);
+}
+
+static void test_saturation_pressure_float() {
+    checkSaturation<float>(0);
+}
+
+static void test_saturation_pressure_double() {
+    checkSaturation<double>(0);
+}
+
+static void test_saturation_pressure_fixed_q16() {
+    checkSaturation<FixedQ16>(Q16_MAX_ABSOLUTE_ERROR);
+}
+
+static void test_saturated_air_float() {
+    checkSaturatedAir<float>(1e-4f, 0.001f);
+}
+
+static void test_saturated_air_double() {
+    checkSaturatedAir<double>(1e-6f, 0.0001f);
+}
+
+static void test_saturated_air_fixed_q16() {
+    checkSaturatedAir<FixedQ16>(2e-3f, 0.05f);
+}
+
+static void test_readme_sample_float() {
+    checkReadmeSample<float>();
+}
+
+static void test_readme_sample_double() {
+    checkReadmeSample<double>();
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_saturation_pressure_float);
+    RUN_TEST(test_saturation_pressure_double);
+    RUN_TEST(test_saturation_pressure_fixed_q16);
+    RUN_TEST(test_saturated_air_float);
+    RUN_TEST(test_saturated_air_double);
+    RUN_TEST(test_saturated_air_fixed_q16);
+    RUN_TEST(test_readme_sample_float);
+    RUN_TEST(test_readme_sample_double);
+    return UNITY_END();
+}
@@ -0,0 +1,275 @@
+// Link outages against the firmware's DataTransmitter and sample log, with
+// the test playing the ingest daemon on the other end of the mock Serial:
+// it drops what is sent while the link is down or at a rate it is not
+// listening at, asks for each gap with a faster replay rate and acks live
+// seqs like ingest/ does. Every outage the log (and its EEPROM spill) can
+// cover must come back complete.
+
+#include <unity.h>
+#include <stdio.h>
+#include <EEPROM.h>
+#include "DataTransmitter.h"
+#include "EepromLogSpill.h"
+
+#define LINK_BAUD 9600
+#define REPLAY_BAUD 115200
+#define SAMPLE_MS 2000       // SAMPLE_PERIOD_FAST_MS in main.cpp
+#define TICK_MS 10           // One loop() pass
+#define ACK_INTERVAL 32      // ingest's STREAM_ACK_INTERVAL
+#define MAX_SEQS 8192
+
+// EepromLogSpill counting the writes that wear the EEPROM
+class CountingSpill : public EepromLogSpill {
+public:
+    void write(uint16_t slot, const PsychroRawSampleFrame& sample) override {
+        writes++;
+        EepromLogSpill::write(slot, sample);
+    }
+
+    uint32_t writes = 0;
+};
+
+// The daemon's side of the link
+struct Host {
+    bool linkUp;
+    unsigned long baud;
+    PsychroFrameDecoder decoder;
+    PsychroSeqFilter filter;
+    bool received[MAX_SEQS];
+    bool synced;
+    uint16_t newest;
+    bool hole;             // A gap whose backfill has not ended
+    uint16_t holeFrom;
+    uint16_t liveSinceAck;
+    uint32_t wrongBaudBytes;
+    uint32_t backfills;
+    uint32_t reportedLost;  // Sum of BEGIN firstSeq - fromSeq
+    uint16_t requestedFrom;
+
+    void reset() {
+        linkUp = true;
+        baud = LINK_BAUD;
+        decoder.reset();
+        filter.reset();
+        memset(received, 0, sizeof(received));
+        synced = false;
+        newest = 0;
+        hole = false;
+        holeFrom = 0;
+        liveSinceAck = 0;
+        wrongBaudBytes = 0;
+        backfills = 0;
+        reportedLost = 0;
+        requestedFrom = 0;
+    }
+
+    void send(uint8_t type, const void* body, size_t length) {
+        uint8_t encoded[PSYCHRO_FRAME_ENCODED_MAX];
+        Serial.mockInput(encoded, psychroEncodeFrame(type, body, length, encoded));
+    }
+
+    void receive(uint8_t byte) {
+        if (!linkUp) {
+            return;
+        }
+        if (Serial.baud != baud) {
+            wrongBaudBytes++;
+            return;
+        }
+        if (decoder.push(byte)) {
+            handleFrame();
+        }
+    }
+
+    void handleFrame() {
+        if (decoder.type() == FRAME_STATE) {
+            PsychroStateFrame frame;
+            TEST_ASSERT_TRUE(decoder.read(frame));
+            live(frame.header.seq);
+            accept(frame.header.seq);
+        } else if (decoder.type() == FRAME_RAW_SAMPLE) {
+            PsychroRawSampleFrame frame;
+            TEST_ASSERT_TRUE(decoder.read(frame));
+            accept(frame.header.seq);
+        } else if (decoder.type() == FRAME_BACKFILL_BEGIN) {
+            PsychroBackfillBeginFrame begin;
+            TEST_ASSERT_TRUE(decoder.read(begin));
+            reportedLost += (uint16_t)(begin.firstSeq - requestedFrom);
+            if (begin.baud) {
+                baud = begin.baud;
+            }
+        } else if (decoder.type() == FRAME_BACKFILL_END) {
+            baud = LINK_BAUD;
+            hole = false;
+        }
+    }
+
+    // A live seq past the expected one opens a gap: ask for it at once
+    void live(uint16_t seq) {
+        uint16_t expected = (uint16_t)(newest + 1);
+        if (synced && seq != expected && psychroSeqBefore(expected, seq)) {
+            if (!hole) {
+                hole = true;
+                holeFrom = expected;
+            }
+            PsychroBackfillRequestFrame request;
+            request.fromSeq = requestedFrom = expected;
+            request.baud = REPLAY_BAUD;
+            send(FRAME_BACKFILL_REQUEST, &request, sizeof(request));
+            backfills++;
+        }
+        synced = true;
+        newest = seq;
+
+        if (++liveSinceAck == ACK_INTERVAL) {
+            liveSinceAck = 0;
+            PsychroLogAckFrame ack;
+            ack.nextSeq = hole ? holeFrom : (uint16_t)(seq + 1);
+            send(FRAME_LOG_ACK, &ack, sizeof(ack));
+        }
+    }
+
+    void accept(uint16_t seq) {
+        TEST_ASSERT_TRUE(seq < MAX_SEQS);
+        if (filter.accept(seq)) {
+            received[seq] = true;
+        }
+    }
+
+    uint32_t missing(uint16_t end) const {
+        uint32_t count = 0;
+        for (uint16_t seq = 0; seq < end; seq++) {
+            if (!received[seq]) {
+                count++;
+            }
+        }
+        return count;
+    }
+};
+
+static Host host;
+
+static void hostReceive(const uint8_t* data, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        host.receive(data[i]);
+    }
+}
+
+// Fixed xorshift32 so every run has the same outages
+static uint32_t rngState = 0x6C8E9CF5;
+
+static uint32_t nextRandom() {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+struct Run {
+    DataTransmitter transmitter;
+    uint16_t seqs;  // Samples sent
+
+    explicit Run(PsychroLogSpill* spill) : seqs(0) {
+        host.reset();
+        Serial.begin(LINK_BAUD);
+        while (Serial.available() > 0) {
+            Serial.read();
+        }
+        transmitter.begin(DataTransmitter::FORMAT_BINARY, LINK_BAUD, spill);
+    }
+
+    // loop() passes for ms, a sample every SAMPLE_MS
+    void run(unsigned long ms) {
+        for (unsigned long t = 0; t < ms; t += TICK_MS) {
+            mockAdvanceMillis(TICK_MS);
+            if (millis() % SAMPLE_MS == 0) {
+                PsychroState state = {};
+                state.dryBulbTemp = 20 + seqs % 10;
+                state.wetBulbTemp = 15;
+                transmitter.sendData(state);
+                seqs++;
+            }
+            transmitter.poll();
+        }
+    }
+
+    // Down for ms, then up long enough for the backfill to finish
+    void outage(unsigned long ms) {
+        host.linkUp = false;
+        run(ms);
+        host.linkUp = true;
+        host.decoder.reset();
+        run(60000);
+        TEST_ASSERT_EQUAL_UINT32(LINK_BAUD, Serial.baud);
+        TEST_ASSERT_EQUAL_UINT32(LINK_BAUD, host.baud);
+    }
+};
+
+void setUp() {
+    mockSerialOutput = hostReceive;
+}
+
+void tearDown() {
+    mockSerialOutput = 0;
+}
+
+// Outages shorter than the SRAM log: nothing is lost, nothing spilled
+static void test_outages_within_sram_log() {
+    CountingSpill spill;
+    Run run(&spill);
+    run.run(120000);
+    for (uint8_t i = 0; i < 20; i++) {
+        unsigned long samples = 10 + nextRandom() % (PSYCHRO_LOG_CAPACITY - ACK_INTERVAL - 10);
+        run.outage(samples * SAMPLE_MS);
+        run.run((30 + nextRandom() % 300) * 1000UL);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(0, host.missing(run.seqs));
+    TEST_ASSERT_EQUAL_UINT32(0, host.wrongBaudBytes);
+    TEST_ASSERT_EQUAL_UINT32(20, host.backfills);
+    TEST_ASSERT_EQUAL_UINT32(0, spill.writes);
+}
+
+// Outages past SRAM but within the EEPROM spill are filled from it, and the
+// spill is not written again while the host listens
+static void test_outages_within_spill() {
+    CountingSpill spill;
+    uint16_t covered = PSYCHRO_LOG_CAPACITY + spill.capacity() - ACK_INTERVAL;
+    Run run(&spill);
+    run.run(120000);
+    for (uint8_t i = 0; i < 6; i++) {
+        unsigned long samples = PSYCHRO_LOG_CAPACITY + nextRandom() % (covered - PSYCHRO_LOG_CAPACITY);
+        run.outage(samples * SAMPLE_MS);
+        uint32_t writes = spill.writes;
+        run.run(1200000);
+        TEST_ASSERT_EQUAL_UINT32(writes, spill.writes);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(0, host.missing(run.seqs));
+    TEST_ASSERT_EQUAL_UINT32(0, host.wrongBaudBytes);
+    TEST_ASSERT_TRUE(spill.writes > 0);
+}
+
+// Without a spill an outage past SRAM loses its oldest samples, and the
+// BEGIN frames account for exactly the samples the host never got
+static void test_overlong_outages_report_loss() {
+    Run run(0);
+    run.run(120000);
+    for (uint8_t i = 0; i < 5; i++) {
+        run.outage((PSYCHRO_LOG_CAPACITY + 50 + nextRandom() % 200) * SAMPLE_MS);
+        run.run(300000);
+    }
+
+    uint32_t missing = host.missing(run.seqs);
+    TEST_ASSERT_TRUE(missing > 0);
+    TEST_ASSERT_EQUAL_UINT32(missing, host.reportedLost);
+    TEST_ASSERT_EQUAL_UINT32(0, host.wrongBaudBytes);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_outages_within_sram_log);
+    RUN_TEST(test_outages_within_spill);
+    RUN_TEST(test_overlong_outages_report_loss);
+    return UNITY_END();
+}
@@ -0,0 +1,198 @@
+// PsychroBatch against the scalar equations it vectorizes: every column of
+// the AVX2 kernel within a small tolerance of computeBatchScalar() wherever
+// the reading is meaningful, NaN in the same places, the tail past the last
+// full vector and every thread split giving the same bits as one thread.
+// Without AVX2 computeBatch() is the scalar path and the checks still hold.
+
+#include <unity.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include <PsychroBatch.h>
+#include <Psychrometrics.h>
+
+#define COLUMNS 6
+#define MIN_RH 0.02f  // Below this the dew point is barely defined
+
+void setUp() {}
+void tearDown() {}
+
+// Allowed |batch - scalar| = absolute + relative * |scalar|, per column
+struct ColumnTolerance {
+    const char* name;
+    float absolute;
+    float relative;
+};
+
+static const ColumnTolerance tolerances[COLUMNS] = {
+    { "relativeHumidity", 5e-5f, 0 },
+    { "dewPoint", 0.002f, 0 },       // °C
+    { "absoluteHumidity", 0, 5e-4f },
+    { "partialPressure", 0, 5e-4f },
+    { "specificVolume", 0, 1e-5f },
+    { "enthalpy", 0.01f, 0 },        // kJ/kg
+};
+
+// One vector of every output column
+struct Columns {
+    std::vector<float> values[COLUMNS];
+    PsychroBatchOut out;
+
+    explicit Columns(size_t n) {
+        for (uint8_t c = 0; c < COLUMNS; c++) {
+            values[c].assign(n, -1.0f);
+        }
+        out.relativeHumidity = values[0].data();
+        out.dewPoint = values[1].data();
+        out.absoluteHumidity = values[2].data();
+        out.partialPressure = values[3].data();
+        out.specificVolume = values[4].data();
+        out.enthalpy = values[5].data();
+    }
+};
+
+#define ODD_INPUTS 5
+
+static std::vector<float> dryBulb;
+static std::vector<float> wetBulb;
+static size_t oddBegin;
+
+// Dry bulb -40..70 °C in 0.5 K steps with every wet bulb down to -50 °C,
+// impossible readings included, then inputs that are not numbers. The
+// count is deliberately not a multiple of 8.
+static void makeInput() {
+    if (!dryBulb.empty()) {
+        return;
+    }
+    for (float db = -40.0f; db <= 70.0f; db += 0.5f) {
+        for (float wb = db; wb >= -50.0f; wb -= 0.5f) {
+            dryBulb.push_back(db);
+            wetBulb.push_back(wb);
+        }
+    }
+    const float odd[ODD_INPUTS][2] = { { NAN, 15 }, { 25, NAN }, { INFINITY, 15 }, { 25, -INFINITY }, { NAN, NAN } };
+    oddBegin = dryBulb.size();
+    for (uint8_t i = 0; i < ODD_INPUTS; i++) {
+        dryBulb.push_back(odd[i][0]);
+        wetBulb.push_back(odd[i][1]);
+    }
+    if (dryBulb.size() % 8 == 0) {
+        dryBulb.push_back(20);
+        wetBulb.push_back(15);
+    }
+}
+
+static bool sameBits(const float* a, const float* b, size_t n) {
+    return memcmp(a, b, n * sizeof(float)) == 0;
+}
+
+static void test_columns_agree() {
+    makeInput();
+    size_t n = dryBulb.size();
+    Columns batch(n);
+    Columns scalar(n);
+    computeBatch(dryBulb.data(), wetBulb.data(), n, batch.out, 1);
+    computeBatchScalar(dryBulb.data(), wetBulb.data(), n, scalar.out);
+
+    char summary[160];
+    snprintf(summary, sizeof(summary), "%zu readings, %s kernel", n, psychroBatchHasAvx2() ? "AVX2" : "scalar");
+    TEST_MESSAGE(summary);
+
+    for (uint8_t c = 0; c < COLUMNS; c++) {
+        const ColumnTolerance& tolerance = tolerances[c];
+        const float* expected = scalar.values[c].data();
+        const float* actual = batch.values[c].data();
+        float worst = 0;
+        size_t misplacedNan = 0;
+        size_t outside = 0;
+        for (size_t i = 0; i < n; i++) {
+            if (isnan(actual[i]) != isnan(expected[i])) {
+                misplacedNan++;
+                continue;
+            }
+            if (!(scalar.out.relativeHumidity[i] >= MIN_RH) || isnan(expected[i])) {
+                continue;
+            }
+            float error = fabsf(actual[i] - expected[i]);
+            worst = fmaxf(worst, error);
+            if (!(error <= tolerance.absolute + tolerance.relative * fabsf(expected[i]))) {
+                outside++;
+            }
+        }
+        snprintf(summary, sizeof(summary), "%s: worst %g, %zu outside tolerance, %zu NaN misplaced",
+                 tolerance.name, worst, outside, misplacedNan);
+        TEST_MESSAGE(summary);
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(0, misplacedNan, tolerance.name);
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(0, outside, tolerance.name);
+    }
+
+    // Inputs that are not numbers give no dew point
+    for (size_t i = oddBegin; i < oddBegin + ODD_INPUTS; i++) {
+        TEST_ASSERT_TRUE(isnan(batch.out.dewPoint[i]));
+    }
+}
+
+// Every element comes out the same whatever n is: those in full vectors as
+// in a longer run, those in the tail as from the scalar path
+static void test_tails() {
+    makeInput();
+    size_t n = dryBulb.size();
+    Columns full(n);
+    Columns scalar(n);
+    computeBatch(dryBulb.data(), wetBulb.data(), n, full.out, 1);
+    computeBatchScalar(dryBulb.data(), wetBulb.data(), n, scalar.out);
+
+    for (size_t length = 1; length <= 41; length++) {
+        Columns part(length);
+        size_t offset = n / 2 - n / 2 % 8;
+        computeBatch(dryBulb.data() + offset, wetBulb.data() + offset, length, part.out, 1);
+        size_t vectored = length - length % 8;
+        for (uint8_t c = 0; c < COLUMNS; c++) {
+            TEST_ASSERT_TRUE_MESSAGE(sameBits(part.values[c].data(), full.values[c].data() + offset, vectored),
+                                     tolerances[c].name);
+            TEST_ASSERT_TRUE_MESSAGE(sameBits(part.values[c].data() + vectored,
+                                              scalar.values[c].data() + offset + vectored, length - vectored),
+                                     tolerances[c].name);
+        }
+    }
+}
+
+// Slices start on multiples of 8, so a split changes no result; a null
+// column is left alone
+static void test_thread_split() {
+    makeInput();
+    size_t n = dryBulb.size();
+    Columns single(n);
+    computeBatch(dryBulb.data(), wetBulb.data(), n, single.out, 1);
+
+    const unsigned threadCounts[] = { 2, 3, 4, 7, 0 };
+    for (uint8_t t = 0; t < 5; t++) {
+        Columns split(n);
+        computeBatch(dryBulb.data(), wetBulb.data(), n, split.out, threadCounts[t]);
+        for (uint8_t c = 0; c < COLUMNS; c++) {
+            TEST_ASSERT_TRUE_MESSAGE(sameBits(split.values[c].data(), single.values[c].data(), n), tolerances[c].name);
+        }
+    }
+
+    Columns dewOnly(n);
+    float* untouched = dewOnly.out.enthalpy;
+    dewOnly.out.relativeHumidity = 0;
+    dewOnly.out.absoluteHumidity = 0;
+    dewOnly.out.partialPressure = 0;
+    dewOnly.out.specificVolume = 0;
+    dewOnly.out.enthalpy = 0;
+    computeBatch(dryBulb.data(), wetBulb.data(), n, dewOnly.out, 3);
+    TEST_ASSERT_TRUE(sameBits(dewOnly.values[1].data(), single.values[1].data(), n));
+    for (size_t i = 0; i < n; i++) {
+        TEST_ASSERT_EQUAL_FLOAT(-1.0f, untouched[i]);
+    }
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_columns_agree);
+    RUN_TEST(test_tails);
+    RUN_TEST(test_thread_split);
+    return UNITY_END();
+}
@@ -0,0 +1,56 @@
+// FindDew over the whole sensor range: every saturation pressure from
+// -50 to 100 °C must solve back to its temperature within the step cap.
+
+#include <unity.h>
+#include <math.h>
+#include <stdio.h>
+#include <Psychrometrics.h>
+
+#define DEW_ITERATION_CAP 12  // maxDewIterations in Psychrometrics.cpp
+#define SWEEP_STEP 0.01
+
+void setUp() {}
+void tearDown() {}
+
+template <typename Real>
+static void sweep(double tolerance) {
+    uint8_t worst = 0;
+    double worstError = 0;
+    for (int i = 0; i <= 15000; i++) {
+        double T = -50 + i * SWEEP_STEP;
+        DewPointResult dew = FindDew<Real>(Real(P_atm), P_ws<Real>(Real(T)));
+        char message[64];
+        snprintf(message, sizeof(message), "at %.2f °C", T);
+        TEST_ASSERT_TRUE_MESSAGE(dew.converged, message);
+        TEST_ASSERT_LESS_OR_EQUAL_MESSAGE(DEW_ITERATION_CAP, dew.iterations, message);
+        TEST_ASSERT_FLOAT_WITHIN_MESSAGE(tolerance, T, dew.dewPoint, message);
+        worst = dew.iterations > worst ? dew.iterations : worst;
+        worstError = fabs(dew.dewPoint - T) > worstError ? fabs(dew.dewPoint - T) : worstError;
+    }
+    char summary[64];
+    snprintf(summary, sizeof(summary), "worst %u steps, %.2e °C", worst, worstError);
+    TEST_MESSAGE(summary);
+}
+
+static void test_find_dew_double() {
+    sweep<double>(0.001);
+}
+
+static void test_find_dew_float() {
+    sweep<float>(0.01);
+}
+
+// Vapor pressures outside the bracket end at its edge, flagged rather than looping
+static void test_find_dew_out_of_range() {
+    DewPointResult dew = FindDew<float>(float(P_atm), 1e-12f);
+    TEST_ASSERT_LESS_OR_EQUAL(DEW_ITERATION_CAP, dew.iterations);
+    TEST_ASSERT_FALSE(isnan(dew.dewPoint));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_find_dew_double);
+    RUN_TEST(test_find_dew_float);
+    RUN_TEST(test_find_dew_out_of_range);
+    return UNITY_END();
+}
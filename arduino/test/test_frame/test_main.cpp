@@ -0,0 +1,224 @@
+// PsychroFrame's COBS/CRC framing: every encodable frame round-trips, and
+// corrupted or random input never comes out as a frame that was not sent.
+// Field values go on the wire rounded, clamped to the field and with a
+// sentinel for non-finite values.
+
+#include <unity.h>
+#include <math.h>
+#include <string.h>
+#include <PsychroFrame.h>
+
+#define FUZZ_FRAMES 2000
+#define NOISE_BYTES 200000
+
+void setUp() {}
+void tearDown() {}
+
+// Fixed xorshift32 so every run feeds the decoder the same bytes
+static uint32_t rngState = 0x2545F491;
+
+static uint32_t nextRandom() {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+// A body of length bytes, zero-heavy so COBS has groups to split
+static void randomBody(uint8_t* body, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        uint32_t r = nextRandom();
+        body[i] = (r & 3) == 0 ? 0 : (uint8_t)(r >> 8);
+    }
+}
+
+// Feed length bytes; returns the frames delivered, the last one in decoder
+static uint32_t feed(PsychroFrameDecoder& decoder, const uint8_t* bytes, size_t length) {
+    uint32_t delivered = 0;
+    for (size_t i = 0; i < length; i++) {
+        if (decoder.push(bytes[i])) {
+            delivered++;
+        }
+    }
+    return delivered;
+}
+
+static bool isFrame(const PsychroFrameDecoder& decoder, uint8_t type, const uint8_t* body, size_t length) {
+    return decoder.type() == type && decoder.bodyLength() == length && memcmp(decoder.body(), body, length) == 0;
+}
+
+static void test_crc_check_value() {
+    const uint8_t check[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+    TEST_ASSERT_EQUAL_HEX16(0x29B1, psychroCrc16(check, sizeof(check)));
+}
+
+static void test_round_trip() {
+    uint8_t body[PSYCHRO_FRAME_MAX];
+    uint8_t encoded[PSYCHRO_FRAME_ENCODED_MAX];
+    PsychroFrameDecoder decoder;
+
+    for (size_t length = 0; length + 3 <= PSYCHRO_FRAME_MAX; length++) {
+        for (uint8_t fill = 0; fill < 3; fill++) {
+            if (fill == 0) {
+                memset(body, 0, length);
+            } else if (fill == 1) {
+                memset(body, 0xFF, length);
+            } else {
+                randomBody(body, length);
+            }
+            uint8_t type = (uint8_t)(nextRandom() | 1);
+
+            size_t n = psychroEncodeFrame(type, body, length, encoded);
+            TEST_ASSERT_TRUE(n > 0 && n <= PSYCHRO_FRAME_ENCODED_MAX);
+            TEST_ASSERT_NULL(memchr(encoded, 0, n - 1));
+            TEST_ASSERT_EQUAL_UINT8(0, encoded[n - 1]);
+
+            TEST_ASSERT_EQUAL_UINT32(1, feed(decoder, encoded, n));
+            TEST_ASSERT_TRUE(isFrame(decoder, type, body, length));
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, decoder.crcErrors + decoder.frameErrors);
+    TEST_ASSERT_EQUAL_UINT(0, psychroEncodeFrame(FRAME_STATE, body, PSYCHRO_FRAME_MAX - 2, encoded));
+}
+
+// Every single-bit error in a frame is caught, and the frame after it decodes
+static void test_bit_flips() {
+    uint8_t body[PSYCHRO_FRAME_MAX];
+    uint8_t encoded[PSYCHRO_FRAME_ENCODED_MAX];
+    uint8_t next[PSYCHRO_FRAME_ENCODED_MAX];
+    PsychroFrameDecoder decoder;
+
+    const uint8_t nextBody[] = { 1, 2, 0, 3 };
+    size_t nextLength = psychroEncodeFrame(FRAME_STATE, nextBody, sizeof(nextBody), next);
+
+    for (uint32_t i = 0; i < FUZZ_FRAMES / 10; i++) {
+        size_t length = nextRandom() % (PSYCHRO_FRAME_MAX - 2);
+        randomBody(body, length);
+        size_t n = psychroEncodeFrame(FRAME_MULTI_STATE, body, length, encoded);
+
+        for (size_t byte = 0; byte < n - 1; byte++) {
+            for (uint8_t bit = 0; bit < 8; bit++) {
+                encoded[byte] ^= (uint8_t)(1 << bit);
+                uint32_t delivered = feed(decoder, encoded, n);
+                encoded[byte] ^= (uint8_t)(1 << bit);
+
+                TEST_ASSERT_EQUAL_UINT32(0, delivered);
+                TEST_ASSERT_EQUAL_UINT32(1, feed(decoder, next, nextLength));
+                TEST_ASSERT_TRUE(isFrame(decoder, FRAME_STATE, nextBody, sizeof(nextBody)));
+            }
+        }
+    }
+}
+
+// Frames with random bytes overwritten, dropped or inserted, back to back:
+// whatever the decoder delivers must be one of the frames that was sent
+static void test_corrupted_stream() {
+    uint8_t bodies[FUZZ_FRAMES][8];
+    uint8_t encoded[PSYCHRO_FRAME_ENCODED_MAX + 4];
+    PsychroFrameDecoder decoder;
+    uint32_t delivered = 0;
+    uint32_t intact = 0;
+
+    for (uint32_t i = 0; i < FUZZ_FRAMES; i++) {
+        randomBody(bodies[i], sizeof(bodies[i]));
+        size_t n = psychroEncodeFrame(FRAME_STATE, bodies[i], sizeof(bodies[i]), encoded);
+
+        uint32_t damage = nextRandom() % 4;  // One frame in four arrives intact
+        if (damage == 0) {
+            intact++;
+        }
+        for (uint32_t d = 0; d < damage; d++) {
+            size_t at = nextRandom() % n;
+            switch (nextRandom() % 3) {
+            case 0:
+                encoded[at] = (uint8_t)nextRandom();
+                break;
+            case 1:
+                memmove(encoded + at, encoded + at + 1, n - at - 1);
+                n--;
+                break;
+            default:
+                memmove(encoded + at + 1, encoded + at, n - at);
+                encoded[at] = (uint8_t)nextRandom();
+                n++;
+                break;
+            }
+            if (n < 2 || n > PSYCHRO_FRAME_ENCODED_MAX) {
+                break;
+            }
+        }
+
+        for (size_t b = 0; b < n; b++) {
+            if (decoder.push(encoded[b])) {
+                delivered++;
+                TEST_ASSERT_TRUE(isFrame(decoder, FRAME_STATE, bodies[i], sizeof(bodies[i])));
+            }
+        }
+    }
+    // A damaged frame can take the intact one after it down with it, when
+    // its delimiter was lost, but no further
+    TEST_ASSERT_TRUE(delivered >= intact / 2);
+}
+
+// Line noise: no frame is accepted unless its CRC matched, and the decoder
+// never writes past its buffer (the sanitizer build checks that)
+static void test_noise() {
+    PsychroFrameDecoder decoder;
+    uint32_t delivered = 0;
+
+    for (uint32_t i = 0; i < NOISE_BYTES; i++) {
+        uint32_t r = nextRandom();
+        uint8_t byte = (r & 0x1F) == 0 ? 0 : (uint8_t)(r >> 8);
+        if (decoder.push(byte)) {
+            delivered++;
+            size_t length = decoder.bodyLength() + 1;
+            const uint8_t* frame = decoder.body() - 1;
+            uint16_t crc = psychroCrc16(frame, length);
+            TEST_ASSERT_EQUAL_UINT8(crc & 0xFF, frame[length]);
+            TEST_ASSERT_EQUAL_UINT8(crc >> 8, frame[length + 1]);
+        }
+    }
+    // One CRC in 65536 passes by chance
+    TEST_ASSERT_TRUE(delivered <= 4);
+    TEST_ASSERT_TRUE(decoder.crcErrors + decoder.frameErrors > 0);
+}
+
+// NaN and infinities become the field's sentinel; finite values never reach
+// it, however far out of range, and never wrap
+static void test_wire_values() {
+    const float nonFinite[] = { NAN, INFINITY, -INFINITY };
+    for (uint8_t i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL_INT16(PSYCHRO_MISSING_INT16, psychroWireInt16(nonFinite[i], PSYCHRO_SCALE_TEMP));
+        TEST_ASSERT_EQUAL_UINT16(PSYCHRO_MISSING_UINT16, psychroWireUint16(nonFinite[i], PSYCHRO_SCALE_RH));
+        TEST_ASSERT_TRUE(psychroWireInt32(nonFinite[i], PSYCHRO_SCALE_ENTHALPY) == PSYCHRO_MISSING_INT32);
+        TEST_ASSERT_TRUE(psychroWireUint32(nonFinite[i], PSYCHRO_SCALE_PRESSURE) == PSYCHRO_MISSING_UINT32);
+    }
+
+    TEST_ASSERT_EQUAL_INT16(2501, psychroWireInt16(25.005f, PSYCHRO_SCALE_TEMP));
+    TEST_ASSERT_EQUAL_INT16(-1250, psychroWireInt16(-12.5f, PSYCHRO_SCALE_TEMP));
+    TEST_ASSERT_EQUAL_INT16(PSYCHRO_TEMP_DISCONNECTED, psychroWireInt16(-127.0f, PSYCHRO_SCALE_TEMP));
+    TEST_ASSERT_EQUAL_INT16(32767, psychroWireInt16(400.0f, PSYCHRO_SCALE_TEMP));
+    TEST_ASSERT_EQUAL_INT16(-32767, psychroWireInt16(-400.0f, PSYCHRO_SCALE_TEMP));
+    TEST_ASSERT_EQUAL_INT16(-32767, psychroWireInt16(-3e38f, PSYCHRO_SCALE_TEMP));
+
+    TEST_ASSERT_EQUAL_UINT16(5074, psychroWireUint16(0.50741f, PSYCHRO_SCALE_RH));
+    TEST_ASSERT_EQUAL_UINT16(0, psychroWireUint16(-0.013f, PSYCHRO_SCALE_RH));  // RH of an impossible reading
+    TEST_ASSERT_EQUAL_UINT16(65534, psychroWireUint16(7.0f, PSYCHRO_SCALE_RH));
+
+    TEST_ASSERT_TRUE(psychroWireUint32(1608.18f, PSYCHRO_SCALE_PRESSURE) == 160818);
+    TEST_ASSERT_TRUE(psychroWireUint32(-259.7f, PSYCHRO_SCALE_PRESSURE) == 0);
+    TEST_ASSERT_TRUE(psychroWireUint32(3e38f, PSYCHRO_SCALE_PRESSURE) == 2147483520ul);
+    TEST_ASSERT_TRUE(psychroWireInt32(-50.8f, PSYCHRO_SCALE_ENTHALPY) == -5080);
+    TEST_ASSERT_TRUE(psychroWireInt32(-3e38f, PSYCHRO_SCALE_ENTHALPY) == -2147483520L);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_crc_check_value);
+    RUN_TEST(test_round_trip);
+    RUN_TEST(test_bit_flips);
+    RUN_TEST(test_corrupted_stream);
+    RUN_TEST(test_noise);
+    RUN_TEST(test_wire_values);
+    return UNITY_END();
+}
@@ -0,0 +1,152 @@
+// PsychroLog's SRAM ring and spill: a host that keeps acknowledging never
+// causes a spill write, and an outage spills only what SRAM cannot hold.
+
+#include <unity.h>
+#include <PsychroLog.h>
+
+#define SPILL_CAPACITY 256
+#define ACK_INTERVAL 32  // ingest's STREAM_ACK_INTERVAL
+
+void setUp() {}
+void tearDown() {}
+
+// A RAM spill that counts its writes, standing in for EepromLogSpill
+class CountingSpill : public PsychroLogSpill {
+public:
+    CountingSpill() : writes(0) {}
+
+    uint16_t capacity() const override { return SPILL_CAPACITY; }
+    void write(uint16_t slot, const PsychroRawSampleFrame& sample) override {
+        slots[slot] = sample;
+        writes++;
+    }
+    void read(uint16_t slot, PsychroRawSampleFrame& sample) const override {
+        sample = slots[slot];
+    }
+
+    uint32_t writes;
+
+private:
+    PsychroRawSampleFrame slots[SPILL_CAPACITY];
+};
+
+static PsychroRawSampleFrame sampleWithSeq(uint16_t seq) {
+    PsychroRawSampleFrame sample;
+    sample.header.seq = seq;
+    sample.header.timestamp = (uint32_t)seq * 2000;
+    sample.dryBulbTemp = (int16_t)(2000 + seq % 100);
+    sample.wetBulbTemp = (int16_t)(1500 + seq % 100);
+    return sample;
+}
+
+// Every seq from first up to the log's end comes back as it was pushed
+static void assertHolds(const PsychroLog& log, uint16_t first) {
+    TEST_ASSERT_EQUAL_UINT16(first, log.oldestSeq());
+    for (uint16_t seq = first; seq != log.endSeq(); seq++) {
+        PsychroRawSampleFrame sample;
+        TEST_ASSERT_TRUE(log.get(seq, sample));
+        TEST_ASSERT_EQUAL_UINT16(seq, sample.header.seq);
+        TEST_ASSERT_EQUAL_INT16(sampleWithSeq(seq).dryBulbTemp, sample.dryBulbTemp);
+    }
+}
+
+// Without any acknowledge there is no host to replay to: drop, don't spill
+static void test_no_host_never_spills() {
+    CountingSpill spill;
+    PsychroLog log;
+    log.setSpill(&spill);
+
+    for (uint16_t seq = 0; seq < 1000; seq++) {
+        log.push(sampleWithSeq(seq));
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, spill.writes);
+    TEST_ASSERT_EQUAL_UINT16(PSYCHRO_LOG_CAPACITY, log.size());
+    assertHolds(log, 1000 - PSYCHRO_LOG_CAPACITY);
+}
+
+// A backfill, then a host that acks every ACK_INTERVAL live seqs: the log
+// stays short and the spill is never written
+static void test_acking_host_never_spills() {
+    CountingSpill spill;
+    PsychroLog log;
+    log.setSpill(&spill);
+
+    for (uint16_t seq = 0; seq < 100; seq++) {
+        log.push(sampleWithSeq(seq));
+    }
+    log.acknowledge(40);  // The backfill request
+    TEST_ASSERT_EQUAL_UINT16(60, log.size());
+
+    for (uint16_t seq = 100; seq < 5000; seq++) {
+        log.push(sampleWithSeq(seq));
+        if (seq % ACK_INTERVAL == 0) {
+            log.acknowledge(seq + 1);
+        }
+        TEST_ASSERT_TRUE(log.size() < PSYCHRO_LOG_CAPACITY);
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, spill.writes);
+}
+
+// The acks stop: SRAM fills, then each further sample spills exactly once,
+// and the whole outage can be read back from the acked seq on
+static void test_outage_spills_overflow_only() {
+    CountingSpill spill;
+    PsychroLog log;
+    log.setSpill(&spill);
+
+    uint16_t seq = 0;
+    for (; seq < 200; seq++) {
+        log.push(sampleWithSeq(seq));
+        if (seq % ACK_INTERVAL == 0) {
+            log.acknowledge(seq + 1);
+        }
+    }
+    uint16_t acked = 193;  // The last ack, at seq 192
+    uint16_t outage = PSYCHRO_LOG_CAPACITY + 100;
+    for (uint16_t i = 0; i < outage; i++, seq++) {
+        log.push(sampleWithSeq(seq));
+    }
+
+    uint16_t held = seq - acked;
+    TEST_ASSERT_EQUAL_UINT16(held, log.size());
+    TEST_ASSERT_EQUAL_UINT32(held - PSYCHRO_LOG_CAPACITY, spill.writes);
+    assertHolds(log, acked);
+
+    // The host is back and asks for the gap; acks resume and writes stop
+    log.acknowledge(acked);
+    log.acknowledge(seq);
+    TEST_ASSERT_EQUAL_UINT16(0, log.size());
+    uint32_t writes = spill.writes;
+    for (uint16_t i = 0; i < 1000; i++, seq++) {
+        log.push(sampleWithSeq(seq));
+        if (seq % ACK_INTERVAL == 0) {
+            log.acknowledge(seq + 1);
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(writes, spill.writes);
+}
+
+// A full spill overwrites its oldest samples; the log still reads back in order
+static void test_spill_wraps() {
+    CountingSpill spill;
+    PsychroLog log;
+    log.setSpill(&spill);
+
+    log.push(sampleWithSeq(0));
+    log.acknowledge(1);
+    uint16_t seq = 1;
+    for (; seq < 2000; seq++) {
+        log.push(sampleWithSeq(seq));
+    }
+    TEST_ASSERT_EQUAL_UINT16(SPILL_CAPACITY + PSYCHRO_LOG_CAPACITY, log.size());
+    assertHolds(log, seq - log.size());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_no_host_never_spills);
+    RUN_TEST(test_acking_host_never_spills);
+    RUN_TEST(test_outage_spills_overflow_only);
+    RUN_TEST(test_spill_wraps);
+    return UNITY_END();
+}
@@ -0,0 +1,77 @@
+// The PROGMEM P_ws table (scripts/pws_table.py) against the exact
+// Hyland-Wexler formula it was fitted to, over the table's whole range.
+// The bounds are the ones quoted in PwsTable.h plus rounding of the type.
+
+#include <unity.h>
+#include <math.h>
+#include <stdio.h>
+#include <Psychrometrics.h>
+#include <PwsTable.h>
+
+#define TABLE_MAX_RELATIVE_ERROR 1.5e-5   // float and double, PwsTable.h quotes 1.39e-5
+#define TABLE_MAX_ABSOLUTE_ERROR_Q16 3.3e-5  // kPa, PwsTable.h quotes 1.74e-5 plus one Q16 LSB
+// A Q16 temperature puts t within half an LSB (3e-6 of a segment), which the
+// segment's slope turns into up to 1.5e-6 of P_ws on top of the table's own error
+#define TABLE_Q16_POSITION_ERROR 1.5e-6
+#define SWEEP_STEP 0.01
+
+void setUp() {}
+void tearDown() {}
+
+static double exactPws(double T) {
+    return exp(lnP_ws<double>(T, 0));
+}
+
+// Worst deviation of P_ws<Real> over the table, as a fraction of
+// absolute + relative * P_ws, where the bound is exactly 1
+template <typename Real>
+static double worstError(double absolute, double relative) {
+    double worst = 0;
+    double worstAt = 0;
+    double end = PWS_TABLE_T_MIN + PWS_TABLE_SEGMENTS * PWS_TABLE_STEP;
+    for (double T = PWS_TABLE_T_MIN; T < end; T += SWEEP_STEP) {
+        Real t = Real(T);
+        double exact = exactPws((double)(float)t);  // At the temperature the type can hold
+        double error = fabs((double)(float)P_ws<Real>(t) - exact) / (absolute + relative * exact);
+        if (error > worst) {
+            worst = error;
+            worstAt = T;
+        }
+    }
+    char summary[64];
+    snprintf(summary, sizeof(summary), "worst %.3g of the bound at %.2f °C", worst, worstAt);
+    TEST_MESSAGE(summary);
+    return worst;
+}
+
+#ifdef PWS_BACKEND_TABLE
+static void test_table_double() {
+    TEST_ASSERT_TRUE(worstError<double>(0, TABLE_MAX_RELATIVE_ERROR) <= 1);
+}
+
+static void test_table_float() {
+    TEST_ASSERT_TRUE(worstError<float>(0, TABLE_MAX_RELATIVE_ERROR) <= 1);
+}
+#endif
+
+// FixedQ16 always uses its Q16 copy of the table
+static void test_table_q16() {
+    TEST_ASSERT_TRUE(worstError<FixedQ16>(TABLE_MAX_ABSOLUTE_ERROR_Q16, TABLE_Q16_POSITION_ERROR) <= 1);
+}
+
+// Outside the table P_ws falls back to the exact formula
+static void test_outside_table() {
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 1.0f, (float)(P_ws<double>(-60.0) / exactPws(-60.0)));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 1.0f, (float)(P_ws<double>(110.0) / exactPws(110.0)));
+}
+
+int main() {
+    UNITY_BEGIN();
+#ifdef PWS_BACKEND_TABLE
+    RUN_TEST(test_table_double);
+    RUN_TEST(test_table_float);
+#endif
+    RUN_TEST(test_table_q16);
+    RUN_TEST(test_outside_table);
+    return UNITY_END();
+}
@@ -0,0 +1,112 @@
+// computePsychroState for each scalar type the firmware can be built with
+// (-D PSYCHRO_REAL=float, double or FixedQ16) over the dry/wet bulb range
+// the sensors report. RH is held against the double evaluation, the dew
+// point against the exact Hyland-Wexler inverse of its vapor pressure.
+// Readings the double evaluation finds impossible (no water vapor left)
+// must not come out of the other types as a plausible humidity either.
+
+#include <unity.h>
+#include <math.h>
+#include <stdio.h>
+#include <Psychrometrics.h>
+
+#define DEW_MAX_ERROR 0.1f  // °C
+#define RH_MAX_ERROR 0.002f
+#define MIN_RH 0.02f        // Below this the dew point is barely defined
+#define MIN_DEW -50.0f      // The bottom of the P_ws table FixedQ16 relies on
+#define MIN_WET -50.0f      // Wet bulb sweep floor, likewise
+
+void setUp() {}
+void tearDown() {}
+
+// Bisect exact P_ws(T) = Pw (unit: Pa) to well below float resolution
+static double exactDew(double Pw) {
+    double lo = -100;
+    double hi = 100;
+    for (uint8_t i = 0; i < 60; i++) {
+        double mid = (lo + hi) / 2;
+        if (exp(lnP_ws<double>(mid, 0)) < Pw / 1000) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return (lo + hi) / 2;
+}
+
+struct Accuracy {
+    float dewError;
+    float rhError;
+    uint16_t unconverged;
+    uint16_t impossible;  // Readings with no vapor left that still gave a humidity
+};
+
+// Dry bulb -40..70 °C in 0.5 K steps, wet bulb anywhere from it down to -50 °C
+// (a 120 K depression at 70 °C)
+template <typename Real>
+static Accuracy accuracy() {
+    Accuracy result = { 0, 0, 0, 0 };
+    float worstDb = 0;
+    float worstWb = 0;
+    for (float db = -40.0f; db <= 70.0f; db += 0.5f) {
+        for (float wb = db; wb >= MIN_WET; wb -= 0.5f) {
+            PsychroState exact = computePsychroState<double>(db, wb);
+            PsychroState state = computePsychroState<Real>(db, wb);
+            if (!(exact.relativeHumidity > 0)) {
+                if (state.relativeHumidity >= MIN_RH) {
+                    result.impossible++;
+                }
+                continue;
+            }
+            double dew = exactDew(exact.partialPressure);
+            if (!(exact.relativeHumidity >= MIN_RH && dew >= MIN_DEW)) {
+                continue;
+            }
+
+            float dewError = fabs(state.dewPoint - dew);
+            if (!(dewError <= result.dewError)) {
+                result.dewError = dewError;
+                worstDb = db;
+                worstWb = wb;
+            }
+            result.rhError = fmaxf(result.rhError, fabsf(state.relativeHumidity - exact.relativeHumidity));
+            if (!state.dewPointConverged) {
+                result.unconverged++;
+            }
+        }
+    }
+    char summary[128];
+    snprintf(summary, sizeof(summary), "dew %.4f °C (at %.1f/%.1f °C), RH %.5f, %u unconverged, %u impossible",
+             result.dewError, worstDb, worstWb, result.rhError, result.unconverged, result.impossible);
+    TEST_MESSAGE(summary);
+    return result;
+}
+
+template <typename Real>
+static void checkAccuracy() {
+    Accuracy result = accuracy<Real>();
+    TEST_ASSERT_FLOAT_WITHIN(DEW_MAX_ERROR, 0, result.dewError);
+    TEST_ASSERT_FLOAT_WITHIN(RH_MAX_ERROR, 0, result.rhError);
+    TEST_ASSERT_EQUAL_UINT16(0, result.unconverged);
+    TEST_ASSERT_EQUAL_UINT16(0, result.impossible);
+}
+
+static void test_float() {
+    checkAccuracy<float>();
+}
+
+static void test_double() {
+    checkAccuracy<double>();
+}
+
+static void test_fixed_q16() {
+    checkAccuracy<FixedQ16>();
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_float);
+    RUN_TEST(test_double);
+    RUN_TEST(test_fixed_q16);
+    return UNITY_END();
+}
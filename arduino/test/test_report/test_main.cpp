@@ -0,0 +1,145 @@
+// PsychroReporter replayed over a recorded hour of readings (trace.h) with
+// main.cpp's settings: how few samples it sends, and how far a receiver
+// holding the last reported state strays from the filtered and raw signals.
+
+#include <unity.h>
+#include <math.h>
+#include <stdio.h>
+#include <PsychroReport.h>
+#include "trace.h"
+
+#define TRACE_ROW_MS 2000
+
+// main.cpp's defaults
+#define REPORT_ALPHA 0.5f
+#define REPORT_DEADBAND_TEMP 0.1f
+#define REPORT_DEADBAND_RH 0.005f
+#define REPORT_HEARTBEAT_MS 60000
+#define REPORT_PERIOD_FAST_MS 2000
+#define REPORT_PERIOD_SLOW_MS 16000
+#define REPORT_STABLE_SAMPLES 5
+
+#define MIN_REDUCTION 10        // Trace rows per report
+#define MAX_RAW_TEMP_ERROR 0.25f // °C, filter lag and noise on top of the deadband
+#define MAX_RAW_RH_ERROR 0.012f
+
+void setUp() {}
+void tearDown() {}
+
+static PsychroReportConfig defaultConfig() {
+    PsychroReportConfig config;
+    config.filter = FILTER_IIR;
+    config.window = 1;
+    config.alpha = REPORT_ALPHA;
+    config.deadbandTemp = REPORT_DEADBAND_TEMP;
+    config.deadbandRH = REPORT_DEADBAND_RH;
+    config.heartbeatMs = REPORT_HEARTBEAT_MS;
+    config.fastPeriodMs = REPORT_PERIOD_FAST_MS;
+    config.slowPeriodMs = REPORT_PERIOD_SLOW_MS;
+    config.stableSamples = REPORT_STABLE_SAMPLES;
+    return config;
+}
+
+// Worst distance of the held state from each signal over the replay
+struct Replay {
+    uint32_t reports;
+    unsigned long longestSilence;
+    float filteredTemp;  // At each sample, right after update()
+    float filteredRH;
+    float rawTemp;       // At every trace row
+    float rawRH;
+};
+
+static Replay replay(const PsychroReportConfig& config) {
+    PsychroReporter reporter;
+    reporter.begin(config);
+    Replay result = { 0, 0, 0, 0, 0, 0 };
+
+    PsychroState held = {};
+    unsigned long lastReport = 0;
+    unsigned long nextSample = 0;
+    for (uint16_t row = 0; row < traceRowCount; row++) {
+        unsigned long now = (unsigned long)row * TRACE_ROW_MS;
+        float rawDry = traceRows[row][0] / 100.0f;
+        float rawWet = traceRows[row][1] / 100.0f;
+
+        if (now >= nextSample) {
+            float dry = rawDry;
+            float wet = rawWet;
+            reporter.filter(0, dry, wet);
+            PsychroState state = computePsychroState(dry, wet);
+            if (reporter.update(&state, 1, now)) {
+                if (reporter.reports > 1 && now - lastReport > result.longestSilence) {
+                    result.longestSilence = now - lastReport;
+                }
+                held = state;
+                lastReport = now;
+            }
+            result.filteredTemp = fmaxf(result.filteredTemp, fabsf(held.dryBulbTemp - dry));
+            result.filteredTemp = fmaxf(result.filteredTemp, fabsf(held.wetBulbTemp - wet));
+            result.filteredRH = fmaxf(result.filteredRH, fabsf(held.relativeHumidity - state.relativeHumidity));
+            nextSample = now + reporter.samplePeriod();
+        }
+
+        PsychroState raw = computePsychroState(rawDry, rawWet);
+        result.rawTemp = fmaxf(result.rawTemp, fabsf(held.dryBulbTemp - rawDry));
+        result.rawTemp = fmaxf(result.rawTemp, fabsf(held.wetBulbTemp - rawWet));
+        result.rawRH = fmaxf(result.rawRH, fabsf(held.relativeHumidity - raw.relativeHumidity));
+    }
+    result.reports = reporter.reports;
+
+    char summary[128];
+    snprintf(summary, sizeof(summary), "%u rows, %lu reports; filtered %.3f °C %.4f RH; raw %.3f °C %.4f RH",
+             traceRowCount, (unsigned long)result.reports, result.filteredTemp, result.filteredRH,
+             result.rawTemp, result.rawRH);
+    TEST_MESSAGE(summary);
+    return result;
+}
+
+// No deadband and a 1 ms heartbeat is the old send-every-sample behaviour
+static void test_every_sample() {
+    PsychroReportConfig config = defaultConfig();
+    config.filter = FILTER_NONE;
+    config.deadbandTemp = 0;
+    config.deadbandRH = 0;
+    config.heartbeatMs = 1;
+    config.slowPeriodMs = REPORT_PERIOD_FAST_MS;
+    Replay result = replay(config);
+    TEST_ASSERT_EQUAL_UINT32(traceRowCount, result.reports);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0, result.rawTemp);
+}
+
+static void test_reduction() {
+    Replay result = replay(defaultConfig());
+    TEST_ASSERT_TRUE(result.reports * MIN_REDUCTION <= traceRowCount);
+}
+
+// The deadband holds against what the reporter saw, at every sample
+static void test_error_against_filtered() {
+    Replay result = replay(defaultConfig());
+    TEST_ASSERT_TRUE(result.filteredTemp <= REPORT_DEADBAND_TEMP + 1e-4f);
+    TEST_ASSERT_TRUE(result.filteredRH <= REPORT_DEADBAND_RH + 1e-6f);
+}
+
+// Against the raw readings, filter lag and sensor noise come on top
+static void test_error_against_raw() {
+    Replay result = replay(defaultConfig());
+    TEST_ASSERT_TRUE(result.rawTemp <= MAX_RAW_TEMP_ERROR);
+    TEST_ASSERT_TRUE(result.rawRH <= MAX_RAW_RH_ERROR);
+}
+
+// A quiet link still hears from the device every heartbeat, give or take a sample period
+static void test_heartbeat() {
+    Replay result = replay(defaultConfig());
+    TEST_ASSERT_TRUE(result.longestSilence <= REPORT_HEARTBEAT_MS + REPORT_PERIOD_SLOW_MS);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_every_sample);
+    RUN_TEST(test_reduction);
+    RUN_TEST(test_error_against_filtered);
+    RUN_TEST(test_error_against_raw);
+    RUN_TEST(test_heartbeat);
+    return UNITY_END();
+}
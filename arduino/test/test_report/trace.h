@@ -0,0 +1,239 @@
+// One hour of readings from webapp/measurements.db (rows 10901-12700, about
+// 2 s apart): dry and wet bulb in 0.01 °C, as the firmware sent them.
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+
+static const int16_t traceRows[][2] = {
+    { 1900, 1100 }, { 1900, 1100 }, { 1900, 1094 }, { 1900, 1100 }, { 1900, 1100 }, { 1900, 1100 }, { 1900, 1100 }, { 1900, 1106 },
+    { 1894, 1094 }, { 1900, 1094 }, { 1900, 1100 }, { 1900, 1106 }, { 1900, 1100 }, { 1900, 1100 }, { 1900, 1106 }, { 1894, 1100 },
+    { 1900, 1106 }, { 1900, 1100 }, { 1900, 1100 }, { 1900, 1106 }, { 1900, 1100 }, { 1900, 1100 }, { 1900, 1100 }, { 1900, 1100 },
+    { 1900, 1100 }, { 1894, 1100 }, { 1900, 1100 }, { 1894, 1094 }, { 1894, 1094 }, { 1900, 1100 }, { 1900, 1100 }, { 1894, 1100 },
+    { 1900, 1100 }, { 1900, 1106 }, { 1900, 1100 }, { 1894, 1100 }, { 1900, 1100 }, { 1900, 1100 }, { 1894, 1100 }, { 1900, 1100 },
+    { 1900, 1100 }, { 1900, 1100 }, { 1900, 1100 }, { 1900, 1106 }, { 1900, 1100 }, { 1900, 1100 }, { 1894, 1100 }, { 1900, 1100 },
+    { 1900, 1100 }, { 1900, 1106 }, { 1900, 1100 }, { 1900, 1100 }, { 1900, 1100 }, { 1900, 1100 }, { 1900, 1100 }, { 1900, 1106 },
+    { 1900, 1106 }, { 1900, 1100 }, { 1900, 1100 }, { 1900, 1100 }, { 1900, 1100 }, { 1900, 1100 }, { 1900, 1106 }, { 1894, 1100 },
+    { 1900, 1100 }, { 1900, 1100 }, { 1900, 1106 }, { 1900, 1100 }, { 1900, 1100 }, { 1900, 1106 }, { 1900, 1100 }, { 1900, 1100 },
+    { 1900, 1106 }, { 1900, 1106 }, { 1900, 1106 }, { 1900, 1100 }, { 1900, 1106 }, { 1900, 1106 }, { 1900, 1106 }, { 1900, 1106 },
+    { 1900, 1106 }, { 1900, 1106 }, { 1900, 1106 }, { 1900, 1106 }, { 1900, 1106 }, { 1900, 1106 }, { 1900, 1106 }, { 1900, 1106 },
+    { 1900, 1106 }, { 1900, 1106 }, { 1900, 1100 }, { 1900, 1106 }, { 1900, 1106 }, { 1900, 1106 }, { 1900, 1106 }, { 1900, 1106 },
+    { 1900, 1100 }, { 1900, 1100 }, { 1900, 1100 }, { 1900, 1100 }, { 1900, 1106 }, { 1900, 1100 }, { 1900, 1106 }, { 1900, 1100 },
+    { 1900, 1106 }, { 1900, 1106 }, { 1900, 1106 }, { 1900, 1106 }, { 1900, 1106 }, { 1900, 1106 }, { 1900, 1106 }, { 1900, 1106 },
+    { 1900, 1106 }, { 1900, 1106 }, { 1900, 1106 }, { 1900, 1106 }, { 1900, 1106 }, { 1900, 1106 }, { 1900, 1113 }, { 1900, 1106 },
+    { 1900, 1113 }, { 1900, 1106 }, { 1900, 1113 }, { 1900, 1106 }, { 1900, 1106 }, { 1900, 1106 }, { 1900, 1106 }, { 1900, 1106 },
+    { 1900, 1106 }, { 1900, 1106 }, { 1900, 1106 }, { 1900, 1106 }, { 1900, 1106 }, { 1900, 1106 }, { 1900, 1106 }, { 1900, 1113 },
+    { 1900, 1106 }, { 1900, 1106 }, { 1900, 1113 }, { 1900, 1106 }, { 1900, 1106 }, { 1900, 1106 }, { 1900, 1106 }, { 1900, 1106 },
+    { 1900, 1106 }, { 1900, 1106 }, { 1900, 1113 }, { 1900, 1106 }, { 1900, 1106 }, { 1900, 1106 }, { 1900, 1106 }, { 1900, 1106 },
+    { 1900, 1106 }, { 1900, 1106 }, { 1900, 1106 }, { 1900, 1106 }, { 1906, 1106 }, { 1900, 1106 }, { 1900, 1106 }, { 1900, 1106 },
+    { 1906, 1106 }, { 1906, 1106 }, { 1906, 1106 }, { 1906, 1106 }, { 1906, 1106 }, { 1900, 1106 }, { 1900, 1106 }, { 1906, 1106 },
+    { 1906, 1106 }, { 1900, 1106 }, { 1900, 1100 }, { 1906, 1106 }, { 1906, 1106 }, { 1906, 1106 }, { 1906, 1106 }, { 1906, 1106 },
+    { 1906, 1100 }, { 1906, 1106 }, { 1906, 1106 }, { 1906, 1106 }, { 1906, 1100 }, { 1906, 1106 }, { 1900, 1106 }, { 1906, 1100 },
+    { 1906, 1113 }, { 1906, 1106 }, { 1906, 1106 }, { 1900, 1113 }, { 1906, 1113 }, { 1906, 1113 }, { 1906, 1106 }, { 1906, 1113 },
+    { 1906, 1106 }, { 1906, 1106 }, { 1906, 1113 }, { 1906, 1106 }, { 1913, 1106 }, { 1906, 1113 }, { 1906, 1106 }, { 1913, 1106 },
+    { 1906, 1106 }, { 1906, 1100 }, { 1906, 1106 }, { 1906, 1106 }, { 1906, 1106 }, { 1906, 1106 }, { 1906, 1113 }, { 1913, 1106 },
+    { 1906, 1106 }, { 1906, 1106 }, { 1906, 1106 }, { 1906, 1113 }, { 1913, 1106 }, { 1913, 1106 }, { 1913, 1106 }, { 1913, 1106 },
+    { 1913, 1106 }, { 1913, 1106 }, { 1906, 1113 }, { 1906, 1106 }, { 1906, 1113 }, { 1906, 1113 }, { 1906, 1113 }, { 1906, 1113 },
+    { 1906, 1113 }, { 1906, 1113 }, { 1906, 1113 }, { 1906, 1113 }, { 1906, 1113 }, { 1906, 1113 }, { 1906, 1113 }, { 1906, 1113 },
+    { 1906, 1113 }, { 1906, 1113 }, { 1906, 1113 }, { 1906, 1113 }, { 1906, 1113 }, { 1906, 1113 }, { 1906, 1113 }, { 1906, 1119 },
+    { 1906, 1113 }, { 1906, 1113 }, { 1906, 1113 }, { 1906, 1113 }, { 1906, 1119 }, { 1906, 1119 }, { 1906, 1119 }, { 1906, 1119 },
+    { 1906, 1119 }, { 1906, 1119 }, { 1906, 1119 }, { 1906, 1119 }, { 1906, 1119 }, { 1906, 1119 }, { 1906, 1113 }, { 1900, 1119 },
+    { 1906, 1119 }, { 1906, 1119 }, { 1906, 1119 }, { 1906, 1113 }, { 1906, 1119 }, { 1906, 1119 }, { 1906, 1113 }, { 1906, 1119 },
+    { 1906, 1113 }, { 1913, 1119 }, { 1906, 1119 }, { 1913, 1119 }, { 1906, 1113 }, { 1906, 1113 }, { 1906, 1113 }, { 1906, 1113 },
+    { 1906, 1113 }, { 1906, 1119 }, { 1906, 1119 }, { 1906, 1119 }, { 1906, 1113 }, { 1906, 1119 }, { 1913, 1113 }, { 1906, 1113 },
+    { 1906, 1113 }, { 1913, 1113 }, { 1913, 1119 }, { 1913, 1113 }, { 1913, 1119 }, { 1913, 1119 }, { 1913, 1113 }, { 1913, 1119 },
+    { 1906, 1113 }, { 1906, 1119 }, { 1906, 1113 }, { 1913, 1119 }, { 1906, 1119 }, { 1913, 1119 }, { 1913, 1119 }, { 1913, 1113 },
+    { 1906, 1119 }, { 1913, 1119 }, { 1913, 1113 }, { 1913, 1113 }, { 1913, 1119 }, { 1913, 1119 }, { 1913, 1119 }, { 1913, 1119 },
+    { 1913, 1113 }, { 1906, 1113 }, { 1913, 1119 }, { 1906, 1113 }, { 1913, 1119 }, { 1913, 1113 }, { 1913, 1119 }, { 1913, 1119 },
+    { 1913, 1119 }, { 1913, 1119 }, { 1913, 1113 }, { 1913, 1113 }, { 1913, 1119 }, { 1913, 1119 }, { 1913, 1119 }, { 1913, 1119 },
+    { 1913, 1119 }, { 1913, 1119 }, { 1913, 1119 }, { 1913, 1113 }, { 1913, 1119 }, { 1913, 1119 }, { 1913, 1119 }, { 1913, 1119 },
+    { 1913, 1119 }, { 1913, 1119 }, { 1913, 1119 }, { 1919, 1119 }, { 1913, 1113 }, { 1913, 1119 }, { 1913, 1113 }, { 1913, 1119 },
+    { 1919, 1113 }, { 1913, 1119 }, { 1913, 1119 }, { 1919, 1119 }, { 1913, 1113 }, { 1913, 1113 }, { 1913, 1113 }, { 1913, 1113 },
+    { 1913, 1119 }, { 1913, 1113 }, { 1913, 1119 }, { 1919, 1113 }, { 1913, 1113 }, { 1919, 1119 }, { 1919, 1119 }, { 1919, 1119 },
+    { 1919, 1119 }, { 1919, 1119 }, { 1919, 1119 }, { 1919, 1119 }, { 1919, 1119 }, { 1913, 1119 }, { 1913, 1119 }, { 1913, 1113 },
+    { 1919, 1119 }, { 1919, 1119 }, { 1919, 1119 }, { 1913, 1119 }, { 1919, 1119 }, { 1919, 1119 }, { 1919, 1119 }, { 1919, 1119 },
+    { 1919, 1119 }, { 1919, 1119 }, { 1919, 1119 }, { 1919, 1119 }, { 1919, 1119 }, { 1919, 1119 }, { 1913, 1119 }, { 1913, 1119 },
+    { 1919, 1119 }, { 1913, 1119 }, { 1919, 1119 }, { 1913, 1119 }, { 1913, 1119 }, { 1919, 1125 }, { 1913, 1119 }, { 1913, 1119 },
+    { 1919, 1119 }, { 1913, 1119 }, { 1919, 1119 }, { 1919, 1119 }, { 1919, 1119 }, { 1919, 1125 }, { 1919, 1125 }, { 1919, 1119 },
+    { 1913, 1119 }, { 1919, 1119 }, { 1913, 1119 }, { 1919, 1125 }, { 1919, 1119 }, { 1919, 1119 }, { 1919, 1119 }, { 1919, 1119 },
+    { 1919, 1119 }, { 1919, 1119 }, { 1919, 1119 }, { 1919, 1119 }, { 1919, 1119 }, { 1919, 1119 }, { 1919, 1119 }, { 1919, 1119 },
+    { 1919, 1119 }, { 1919, 1119 }, { 1919, 1119 }, { 1919, 1119 }, { 1919, 1119 }, { 1919, 1119 }, { 1919, 1119 }, { 1919, 1119 },
+    { 1919, 1119 }, { 1919, 1119 }, { 1919, 1119 }, { 1919, 1119 }, { 1919, 1119 }, { 1919, 1119 }, { 1919, 1113 }, { 1919, 1119 },
+    { 1919, 1113 }, { 1919, 1119 }, { 1919, 1113 }, { 1919, 1113 }, { 1919, 1113 }, { 1919, 1119 }, { 1919, 1113 }, { 1919, 1113 },
+    { 1919, 1113 }, { 1925, 1113 }, { 1919, 1113 }, { 1919, 1119 }, { 1919, 1113 }, { 1919, 1113 }, { 1919, 1119 }, { 1919, 1113 },
+    { 1919, 1113 }, { 1919, 1119 }, { 1919, 1113 }, { 1919, 1113 }, { 1919, 1113 }, { 1919, 1113 }, { 1919, 1113 }, { 1919, 1113 },
+    { 1919, 1113 }, { 1919, 1119 }, { 1919, 1113 }, { 1919, 1113 }, { 1919, 1113 }, { 1919, 1113 }, { 1919, 1113 }, { 1919, 1113 },
+    { 1919, 1113 }, { 1919, 1113 }, { 1919, 1113 }, { 1919, 1119 }, { 1919, 1113 }, { 1919, 1113 }, { 1913, 1113 }, { 1919, 1113 },
+    { 1919, 1113 }, { 1919, 1113 }, { 1913, 1113 }, { 1913, 1113 }, { 1919, 1113 }, { 1919, 1113 }, { 1919, 1113 }, { 1919, 1113 },
+    { 1919, 1113 }, { 1919, 1113 }, { 1919, 1113 }, { 1919, 1113 }, { 1919, 1113 }, { 1919, 1113 }, { 1919, 1113 }, { 1919, 1113 },
+    { 1919, 1113 }, { 1919, 1119 }, { 1919, 1113 }, { 1919, 1113 }, { 1919, 1119 }, { 1919, 1113 }, { 1919, 1119 }, { 1919, 1113 },
+    { 1919, 1113 }, { 1919, 1113 }, { 1913, 1113 }, { 1919, 1113 }, { 1913, 1113 }, { 1913, 1113 }, { 1913, 1113 }, { 1913, 1113 },
+    { 1913, 1113 }, { 1913, 1119 }, { 1913, 1119 }, { 1913, 1113 }, { 1913, 1119 }, { 1913, 1119 }, { 1913, 1125 }, { 1913, 1125 },
+    { 1913, 1125 }, { 1913, 1125 }, { 1913, 1125 }, { 1913, 1125 }, { 1913, 1125 }, { 1919, 1125 }, { 1919, 1125 }, { 1919, 1125 },
+    { 1913, 1125 }, { 1913, 1119 }, { 1913, 1119 }, { 1913, 1119 }, { 1913, 1125 }, { 1913, 1125 }, { 1913, 1119 }, { 1913, 1125 },
+    { 1913, 1119 }, { 1913, 1125 }, { 1913, 1125 }, { 1913, 1119 }, { 1913, 1125 }, { 1913, 1119 }, { 1913, 1119 }, { 1913, 1125 },
+    { 1913, 1125 }, { 1919, 1119 }, { 1919, 1119 }, { 1919, 1119 }, { 1913, 1125 }, { 1913, 1119 }, { 1913, 1119 }, { 1913, 1119 },
+    { 1919, 1119 }, { 1913, 1119 }, { 1913, 1119 }, { 1919, 1119 }, { 1919, 1125 }, { 1919, 1125 }, { 1919, 1125 }, { 1919, 1119 },
+    { 1919, 1119 }, { 1919, 1119 }, { 1919, 1119 }, { 1919, 1125 }, { 1919, 1125 }, { 1919, 1119 }, { 1919, 1119 }, { 1919, 1119 },
+    { 1919, 1119 }, { 1919, 1119 }, { 1919, 1119 }, { 1919, 1119 }, { 1919, 1119 }, { 1919, 1125 }, { 1919, 1125 }, { 1919, 1125 },
+    { 1919, 1125 }, { 1925, 1119 }, { 1925, 1125 }, { 1919, 1125 }, { 1925, 1125 }, { 1925, 1125 }, { 1925, 1125 }, { 1919, 1125 },
+    { 1919, 1125 }, { 1925, 1125 }, { 1925, 1125 }, { 1925, 1125 }, { 1925, 1125 }, { 1925, 1125 }, { 1925, 1125 }, { 1925, 1125 },
+    { 1919, 1125 }, { 1925, 1125 }, { 1919, 1125 }, { 1925, 1125 }, { 1925, 1125 }, { 1925, 1125 }, { 1925, 1125 }, { 1925, 1125 },
+    { 1919, 1125 }, { 1919, 1125 }, { 1919, 1125 }, { 1919, 1125 }, { 1919, 1125 }, { 1919, 1125 }, { 1919, 1125 }, { 1925, 1125 },
+    { 1919, 1125 }, { 1925, 1125 }, { 1925, 1125 }, { 1925, 1125 }, { 1925, 1125 }, { 1925, 1125 }, { 1925, 1125 }, { 1925, 1125 },
+    { 1925, 1131 }, { 1925, 1125 }, { 1919, 1131 }, { 1919, 1125 }, { 1925, 1125 }, { 1925, 1125 }, { 1925, 1131 }, { 1925, 1125 },
+    { 1925, 1125 }, { 1925, 1125 }, { 1925, 1125 }, { 1925, 1131 }, { 1925, 1131 }, { 1925, 1125 }, { 1925, 1125 }, { 1925, 1125 },
+    { 1931, 1125 }, { 1925, 1131 }, { 1931, 1125 }, { 1925, 1125 }, { 1925, 1125 }, { 1925, 1125 }, { 1925, 1125 }, { 1925, 1125 },
+    { 1925, 1125 }, { 1925, 1125 }, { 1925, 1125 }, { 1925, 1125 }, { 1925, 1125 }, { 1931, 1125 }, { 1925, 1125 }, { 1931, 1125 },
+    { 1931, 1125 }, { 1931, 1125 }, { 1931, 1125 }, { 1931, 1125 }, { 1931, 1125 }, { 1925, 1125 }, { 1925, 1125 }, { 1931, 1125 },
+    { 1931, 1125 }, { 1931, 1125 }, { 1931, 1125 }, { 1925, 1125 }, { 1931, 1125 }, { 1931, 1125 }, { 1925, 1131 }, { 1931, 1125 },
+    { 1931, 1125 }, { 1931, 1131 }, { 1931, 1125 }, { 1931, 1125 }, { 1931, 1125 }, { 1931, 1125 }, { 1925, 1125 }, { 1931, 1131 },
+    { 1931, 1125 }, { 1931, 1125 }, { 1931, 1131 }, { 1931, 1131 }, { 1931, 1125 }, { 1931, 1131 }, { 1931, 1131 }, { 1931, 1131 },
+    { 1938, 1131 }, { 1931, 1131 }, { 1931, 1131 }, { 1931, 1131 }, { 1931, 1131 }, { 1938, 1131 }, { 1938, 1131 }, { 1931, 1131 },
+    { 1931, 1131 }, { 1931, 1131 }, { 1931, 1131 }, { 1931, 1131 }, { 1931, 1131 }, { 1931, 1131 }, { 1931, 1131 }, { 1931, 1138 },
+    { 1931, 1138 }, { 1931, 1138 }, { 1931, 1131 }, { 1938, 1138 }, { 1938, 1138 }, { 1938, 1138 }, { 1938, 1138 }, { 1938, 1138 },
+    { 1931, 1138 }, { 1931, 1138 }, { 1931, 1138 }, { 1931, 1138 }, { 1938, 1138 }, { 1931, 1138 }, { 1931, 1138 }, { 1938, 1138 },
+    { 1938, 1131 }, { 1938, 1131 }, { 1938, 1131 }, { 1938, 1131 }, { 1938, 1131 }, { 1938, 1125 }, { 1938, 1131 }, { 1938, 1131 },
+    { 1938, 1138 }, { 1938, 1131 }, { 1938, 1138 }, { 1938, 1131 }, { 1938, 1131 }, { 1938, 1131 }, { 1938, 1138 }, { 1938, 1138 },
+    { 1938, 1138 }, { 1938, 1138 }, { 1938, 1131 }, { 1938, 1138 }, { 1944, 1138 }, { 1938, 1138 }, { 1938, 1138 }, { 1938, 1138 },
+    { 1938, 1138 }, { 1938, 1144 }, { 1944, 1144 }, { 1944, 1138 }, { 1938, 1144 }, { 1938, 1138 }, { 1938, 1138 }, { 1938, 1144 },
+    { 1938, 1144 }, { 1938, 1144 }, { 1938, 1144 }, { 1938, 1144 }, { 1938, 1144 }, { 1938, 1144 }, { 1938, 1144 }, { 1938, 1144 },
+    { 1944, 1144 }, { 1944, 1144 }, { 1944, 1138 }, { 1938, 1144 }, { 1944, 1144 }, { 1944, 1144 }, { 1938, 1144 }, { 1938, 1144 },
+    { 1938, 1144 }, { 1938, 1144 }, { 1944, 1144 }, { 1938, 1144 }, { 1938, 1144 }, { 1944, 1144 }, { 1944, 1144 }, { 1938, 1144 },
+    { 1938, 1150 }, { 1944, 1144 }, { 1944, 1144 }, { 1944, 1144 }, { 1944, 1144 }, { 1944, 1144 }, { 1944, 1144 }, { 1944, 1144 },
+    { 1938, 1144 }, { 1938, 1144 }, { 1944, 1144 }, { 1938, 1144 }, { 1944, 1144 }, { 1944, 1144 }, { 1944, 1144 }, { 1944, 1138 },
+    { 1944, 1144 }, { 1944, 1144 }, { 1944, 1144 }, { 1944, 1144 }, { 1944, 1138 }, { 1944, 1138 }, { 1944, 1144 }, { 1944, 1144 },
+    { 1950, 1144 }, { 1944, 1144 }, { 1944, 1144 }, { 1944, 1144 }, { 1944, 1144 }, { 1944, 1150 }, { 1944, 1144 }, { 1944, 1144 },
+    { 1944, 1150 }, { 1944, 1150 }, { 1944, 1150 }, { 1944, 1144 }, { 1944, 1150 }, { 1944, 1144 }, { 1944, 1144 }, { 1944, 1144 },
+    { 1950, 1144 }, { 1950, 1150 }, { 1950, 1144 }, { 1944, 1144 }, { 1944, 1144 }, { 1944, 1144 }, { 1944, 1144 }, { 1944, 1144 },
+    { 1950, 1144 }, { 1944, 1144 }, { 1944, 1144 }, { 1950, 1144 }, { 1950, 1144 }, { 1950, 1144 }, { 1950, 1144 }, { 1950, 1144 },
+    { 1950, 1144 }, { 1950, 1144 }, { 1950, 1150 }, { 1950, 1150 }, { 1944, 1144 }, { 1950, 1144 }, { 1944, 1144 }, { 1950, 1144 },
+    { 1950, 1150 }, { 1950, 1150 }, { 1950, 1150 }, { 1950, 1144 }, { 1950, 1144 }, { 1950, 1150 }, { 1950, 1150 }, { 1950, 1150 },
+    { 1956, 1150 }, { 1950, 1150 }, { 1950, 1150 }, { 1950, 1150 }, { 1956, 1156 }, { 1950, 1150 }, { 1950, 1156 }, { 1950, 1150 },
+    { 1950, 1150 }, { 1950, 1156 }, { 1950, 1150 }, { 1950, 1150 }, { 1950, 1150 }, { 1950, 1150 }, { 1956, 1150 }, { 1950, 1156 },
+    { 1950, 1156 }, { 1950, 1150 }, { 1950, 1150 }, { 1956, 1150 }, { 1956, 1156 }, { 1956, 1156 }, { 1956, 1156 }, { 1950, 1156 },
+    { 1950, 1156 }, { 1950, 1150 }, { 1956, 1150 }, { 1956, 1156 }, { 1950, 1150 }, { 1956, 1150 }, { 1956, 1150 }, { 1950, 1150 },
+    { 1956, 1150 }, { 1950, 1156 }, { 1956, 1156 }, { 1956, 1150 }, { 1956, 1150 }, { 1956, 1150 }, { 1956, 1156 }, { 1956, 1150 },
+    { 1956, 1156 }, { 1956, 1156 }, { 1950, 1156 }, { 1956, 1156 }, { 1956, 1156 }, { 1950, 1156 }, { 1956, 1156 }, { 1956, 1156 },
+    { 1956, 1156 }, { 1956, 1150 }, { 1956, 1150 }, { 1956, 1150 }, { 1956, 1156 }, { 1956, 1156 }, { 1963, 1156 }, { 1963, 1150 },
+    { 1956, 1150 }, { 1963, 1150 }, { 1956, 1156 }, { 1963, 1156 }, { 1950, 1150 }, { 1956, 1150 }, { 1956, 1150 }, { 1956, 1150 },
+    { 1956, 1150 }, { 1963, 1156 }, { 1956, 1156 }, { 1956, 1150 }, { 1956, 1150 }, { 1963, 1150 }, { 1963, 1156 }, { 1956, 1156 },
+    { 1963, 1156 }, { 1963, 1150 }, { 1963, 1150 }, { 1963, 1150 }, { 1963, 1150 }, { 1963, 1156 }, { 1963, 1150 }, { 1956, 1156 },
+    { 1956, 1150 }, { 1956, 1150 }, { 1956, 1150 }, { 1963, 1150 }, { 1956, 1150 }, { 1963, 1150 }, { 1963, 1156 }, { 1963, 1150 },
+    { 1963, 1150 }, { 1963, 1156 }, { 1963, 1156 }, { 1963, 1156 }, { 1963, 1150 }, { 1963, 1150 }, { 1963, 1150 }, { 1963, 1156 },
+    { 1963, 1150 }, { 1963, 1156 }, { 1963, 1156 }, { 1963, 1150 }, { 1963, 1150 }, { 1963, 1156 }, { 1963, 1156 }, { 1963, 1150 },
+    { 1969, 1150 }, { 1963, 1150 }, { 1969, 1150 }, { 1963, 1156 }, { 1969, 1150 }, { 1963, 1150 }, { 1969, 1150 }, { 1963, 1156 },
+    { 1963, 1150 }, { 1963, 1156 }, { 1963, 1156 }, { 1963, 1150 }, { 1963, 1150 }, { 1963, 1150 }, { 1963, 1150 }, { 1963, 1150 },
+    { 1963, 1150 }, { 1963, 1150 }, { 1969, 1144 }, { 1969, 1150 }, { 1969, 1144 }, { 1969, 1150 }, { 1963, 1150 }, { 1969, 1144 },
+    { 1969, 1150 }, { 1969, 1150 }, { 1963, 1150 }, { 1969, 1150 }, { 1969, 1150 }, { 1963, 1150 }, { 1963, 1150 }, { 1969, 1150 },
+    { 1963, 1150 }, { 1963, 1150 }, { 1963, 1150 }, { 1969, 1150 }, { 1969, 1150 }, { 1969, 1150 }, { 1963, 1150 }, { 1969, 1150 },
+    { 1969, 1150 }, { 1969, 1150 }, { 1969, 1150 }, { 1969, 1150 }, { 1969, 1150 }, { 1969, 1150 }, { 1969, 1150 }, { 1963, 1150 },
+    { 1963, 1150 }, { 1963, 1150 }, { 1969, 1150 }, { 1963, 1150 }, { 1969, 1156 }, { 1969, 1150 }, { 1969, 1150 }, { 1969, 1150 },
+    { 1969, 1150 }, { 1969, 1150 }, { 1969, 1150 }, { 1969, 1150 }, { 1969, 1150 }, { 1969, 1150 }, { 1969, 1150 }, { 1969, 1150 },
+    { 1969, 1150 }, { 1969, 1156 }, { 1963, 1150 }, { 1963, 1156 }, { 1963, 1156 }, { 1963, 1156 }, { 1969, 1156 }, { 1969, 1156 },
+    { 1969, 1150 }, { 1969, 1156 }, { 1969, 1150 }, { 1969, 1156 }, { 1969, 1150 }, { 1969, 1150 }, { 1969, 1150 }, { 1969, 1150 },
+    { 1969, 1150 }, { 1969, 1156 }, { 1969, 1150 }, { 1969, 1150 }, { 1963, 1150 }, { 1963, 1150 }, { 1963, 1150 }, { 1969, 1156 },
+    { 1963, 1156 }, { 1969, 1150 }, { 1969, 1150 }, { 1969, 1150 }, { 1969, 1150 }, { 1969, 1150 }, { 1969, 1150 }, { 1969, 1144 },
+    { 1969, 1144 }, { 1969, 1144 }, { 1969, 1150 }, { 1969, 1150 }, { 1963, 1150 }, { 1963, 1150 }, { 1969, 1150 }, { 1963, 1150 },
+    { 1969, 1150 }, { 1969, 1156 }, { 1969, 1150 }, { 1969, 1150 }, { 1969, 1150 }, { 1969, 1150 }, { 1969, 1150 }, { 1969, 1150 },
+    { 1969, 1150 }, { 1969, 1150 }, { 1969, 1150 }, { 1969, 1150 }, { 1969, 1150 }, { 1969, 1150 }, { 1969, 1150 }, { 1969, 1150 },
+    { 1969, 1150 }, { 1969, 1150 }, { 1969, 1150 }, { 1969, 1156 }, { 1969, 1156 }, { 1969, 1156 }, { 1969, 1156 }, { 1975, 1156 },
+    { 1969, 1156 }, { 1969, 1156 }, { 1969, 1150 }, { 1975, 1156 }, { 1969, 1156 }, { 1969, 1156 }, { 1969, 1156 }, { 1969, 1156 },
+    { 1969, 1156 }, { 1969, 1156 }, { 1969, 1156 }, { 1969, 1156 }, { 1975, 1156 }, { 1969, 1156 }, { 1975, 1156 }, { 1975, 1156 },
+    { 1975, 1163 }, { 1975, 1163 }, { 1975, 1156 }, { 1975, 1156 }, { 1975, 1156 }, { 1975, 1156 }, { 1969, 1156 }, { 1975, 1156 },
+    { 1969, 1156 }, { 1969, 1156 }, { 1969, 1156 }, { 1969, 1156 }, { 1969, 1156 }, { 1969, 1156 }, { 1969, 1156 }, { 1975, 1156 },
+    { 1969, 1156 }, { 1969, 1156 }, { 1969, 1156 }, { 1975, 1156 }, { 1975, 1163 }, { 1975, 1163 }, { 1969, 1156 }, { 1969, 1163 },
+    { 1969, 1156 }, { 1969, 1156 }, { 1969, 1163 }, { 1969, 1156 }, { 1963, 1156 }, { 1969, 1156 }, { 1963, 1156 }, { 1963, 1156 },
+    { 1969, 1156 }, { 1963, 1163 }, { 1969, 1156 }, { 1969, 1156 }, { 1969, 1156 }, { 1969, 1156 }, { 1969, 1156 }, { 1969, 1163 },
+    { 1969, 1156 }, { 1969, 1156 }, { 1969, 1156 }, { 1969, 1163 }, { 1969, 1163 }, { 1969, 1163 }, { 1969, 1163 }, { 1963, 1163 },
+    { 1969, 1163 }, { 1969, 1163 }, { 1969, 1163 }, { 1969, 1163 }, { 1969, 1169 }, { 1969, 1169 }, { 1969, 1169 }, { 1969, 1163 },
+    { 1969, 1169 }, { 1969, 1169 }, { 1969, 1169 }, { 1969, 1163 }, { 1969, 1163 }, { 1969, 1163 }, { 1969, 1156 }, { 1969, 1156 },
+    { 1969, 1156 }, { 1963, 1156 }, { 1963, 1156 }, { 1963, 1156 }, { 1963, 1150 }, { 1963, 1156 }, { 1963, 1156 }, { 1963, 1156 },
+    { 1963, 1156 }, { 1963, 1156 }, { 1969, 1156 }, { 1963, 1156 }, { 1969, 1156 }, { 1963, 1156 }, { 1963, 1156 }, { 1963, 1156 },
+    { 1969, 1156 }, { 1963, 1156 }, { 1963, 1156 }, { 1963, 1156 }, { 1963, 1156 }, { 1963, 1156 }, { 1963, 1156 }, { 1963, 1156 },
+    { 1956, 1156 }, { 1963, 1156 }, { 1963, 1156 }, { 1963, 1156 }, { 1963, 1156 }, { 1969, 1156 }, { 1963, 1156 }, { 1963, 1156 },
+    { 1963, 1156 }, { 1963, 1156 }, { 1963, 1156 }, { 1963, 1150 }, { 1963, 1156 }, { 1963, 1150 }, { 1956, 1156 }, { 1956, 1150 },
+    { 1956, 1150 }, { 1956, 1150 }, { 1956, 1150 }, { 1950, 1150 }, { 1956, 1150 }, { 1956, 1150 }, { 1956, 1150 }, { 1950, 1150 },
+    { 1950, 1150 }, { 1950, 1144 }, { 1950, 1144 }, { 1944, 1144 }, { 1944, 1144 }, { 1944, 1144 }, { 1944, 1144 }, { 1944, 1144 },
+    { 1938, 1144 }, { 1938, 1138 }, { 1938, 1138 }, { 1938, 1138 }, { 1938, 1138 }, { 1938, 1138 }, { 1931, 1138 }, { 1931, 1138 },
+    { 1931, 1131 }, { 1931, 1131 }, { 1931, 1138 }, { 1931, 1131 }, { 1931, 1125 }, { 1925, 1125 }, { 1925, 1125 }, { 1931, 1125 },
+    { 1925, 1125 }, { 1925, 1119 }, { 1919, 1125 }, { 1919, 1119 }, { 1919, 1119 }, { 1919, 1119 }, { 1913, 1119 }, { 1913, 1119 },
+    { 1913, 1113 }, { 1913, 1113 }, { 1913, 1119 }, { 1906, 1119 }, { 1906, 1119 }, { 1906, 1113 }, { 1906, 1113 }, { 1900, 1113 },
+    { 1900, 1113 }, { 1900, 1113 }, { 1900, 1106 }, { 1894, 1106 }, { 1894, 1106 }, { 1894, 1100 }, { 1894, 1100 }, { 1894, 1100 },
+    { 1894, 1100 }, { 1888, 1100 }, { 1894, 1100 }, { 1888, 1100 }, { 1888, 1100 }, { 1888, 1100 }, { 1888, 1100 }, { 1881, 1094 },
+    { 1881, 1094 }, { 1881, 1094 }, { 1881, 1100 }, { 1881, 1094 }, { 1881, 1094 }, { 1881, 1094 }, { 1881, 1094 }, { 1881, 1100 },
+    { 1881, 1100 }, { 1881, 1100 }, { 1881, 1100 }, { 1881, 1100 }, { 1888, 1100 }, { 1888, 1106 }, { 1881, 1100 }, { 1881, 1106 },
+    { 1881, 1106 }, { 1888, 1106 }, { 1888, 1106 }, { 1888, 1106 }, { 1888, 1106 }, { 1888, 1113 }, { 1888, 1113 }, { 1888, 1113 },
+    { 1888, 1113 }, { 1888, 1113 }, { 1888, 1113 }, { 1894, 1119 }, { 1888, 1113 }, { 1888, 1119 }, { 1888, 1119 }, { 1888, 1119 },
+    { 1888, 1119 }, { 1888, 1119 }, { 1888, 1119 }, { 1894, 1119 }, { 1894, 1119 }, { 1894, 1119 }, { 1894, 1119 }, { 1894, 1119 },
+    { 1894, 1119 }, { 1888, 1125 }, { 1894, 1119 }, { 1894, 1119 }, { 1894, 1119 }, { 1894, 1119 }, { 1894, 1119 }, { 1888, 1125 },
+    { 1894, 1119 }, { 1894, 1125 }, { 1894, 1119 }, { 1894, 1119 }, { 1894, 1125 }, { 1894, 1125 }, { 1894, 1119 }, { 1894, 1119 },
+    { 1894, 1125 }, { 1894, 1125 }, { 1894, 1125 }, { 1894, 1125 }, { 1894, 1125 }, { 1894, 1125 }, { 1894, 1125 }, { 1894, 1125 },
+    { 1894, 1125 }, { 1894, 1125 }, { 1894, 1125 }, { 1894, 1131 }, { 1894, 1131 }, { 1894, 1125 }, { 1894, 1131 }, { 1894, 1131 },
+    { 1894, 1131 }, { 1900, 1131 }, { 1900, 1131 }, { 1900, 1131 }, { 1900, 1131 }, { 1900, 1131 }, { 1900, 1131 }, { 1900, 1131 },
+    { 1900, 1131 }, { 1900, 1138 }, { 1900, 1131 }, { 1900, 1131 }, { 1900, 1131 }, { 1900, 1131 }, { 1900, 1138 }, { 1900, 1131 },
+    { 1900, 1131 }, { 1900, 1131 }, { 1900, 1131 }, { 1900, 1131 }, { 1900, 1131 }, { 1900, 1131 }, { 1900, 1131 }, { 1906, 1131 },
+    { 1900, 1125 }, { 1900, 1131 }, { 1900, 1131 }, { 1906, 1131 }, { 1900, 1131 }, { 1906, 1131 }, { 1906, 1131 }, { 1906, 1125 },
+    { 1906, 1125 }, { 1906, 1125 }, { 1906, 1125 }, { 1906, 1131 }, { 1906, 1131 }, { 1906, 1131 }, { 1906, 1125 }, { 1906, 1125 },
+    { 1906, 1131 }, { 1906, 1131 }, { 1906, 1131 }, { 1906, 1125 }, { 1906, 1125 }, { 1906, 1125 }, { 1906, 1125 }, { 1906, 1125 },
+    { 1906, 1125 }, { 1906, 1125 }, { 1906, 1125 }, { 1906, 1119 }, { 1900, 1119 }, { 1900, 1119 }, { 1900, 1119 }, { 1900, 1119 },
+    { 1900, 1119 }, { 1900, 1119 }, { 1906, 1125 }, { 1906, 1125 }, { 1906, 1119 }, { 1906, 1125 }, { 1900, 1125 }, { 1906, 1125 },
+    { 1906, 1125 }, { 1900, 1125 }, { 1906, 1125 }, { 1906, 1125 }, { 1906, 1125 }, { 1900, 1125 }, { 1906, 1125 }, { 1906, 1125 },
+    { 1906, 1125 }, { 1906, 1125 }, { 1906, 1125 }, { 1906, 1125 }, { 1906, 1125 }, { 1906, 1131 }, { 1906, 1125 }, { 1913, 1125 },
+    { 1906, 1125 }, { 1906, 1125 }, { 1913, 1125 }, { 1906, 1125 }, { 1913, 1125 }, { 1913, 1125 }, { 1906, 1119 }, { 1906, 1119 },
+    { 1906, 1119 }, { 1906, 1125 }, { 1913, 1125 }, { 1913, 1125 }, { 1913, 1125 }, { 1913, 1119 }, { 1913, 1125 }, { 1913, 1125 },
+    { 1913, 1125 }, { 1913, 1125 }, { 1913, 1119 }, { 1913, 1119 }, { 1913, 1119 }, { 1906, 1125 }, { 1906, 1119 }, { 1906, 1119 },
+    { 1906, 1119 }, { 1906, 1113 }, { 1906, 1119 }, { 1906, 1119 }, { 1900, 1119 }, { 1900, 1119 }, { 1900, 1119 }, { 1900, 1113 },
+    { 1894, 1113 }, { 1894, 1113 }, { 1894, 1113 }, { 1894, 1113 }, { 1894, 1113 }, { 1894, 1113 }, { 1894, 1113 }, { 1888, 1106 },
+    { 1888, 1113 }, { 1888, 1106 }, { 1888, 1113 }, { 1888, 1106 }, { 1888, 1106 }, { 1888, 1106 }, { 1888, 1100 }, { 1888, 1100 },
+    { 1881, 1100 }, { 1881, 1094 }, { 1881, 1094 }, { 1881, 1094 }, { 1881, 1094 }, { 1881, 1094 }, { 1881, 1088 }, { 1881, 1088 },
+    { 1881, 1094 }, { 1881, 1088 }, { 1881, 1088 }, { 1881, 1088 }, { 1881, 1094 }, { 1881, 1094 }, { 1881, 1094 }, { 1881, 1094 },
+    { 1881, 1094 }, { 1881, 1100 }, { 1881, 1094 }, { 1881, 1094 }, { 1881, 1100 }, { 1881, 1100 }, { 1881, 1100 }, { 1881, 1100 },
+    { 1881, 1100 }, { 1881, 1106 }, { 1881, 1100 }, { 1881, 1106 }, { 1881, 1100 }, { 1881, 1106 }, { 1888, 1106 }, { 1881, 1106 },
+    { 1888, 1106 }, { 1888, 1113 }, { 1888, 1113 }, { 1888, 1113 }, { 1888, 1119 }, { 1888, 1113 }, { 1888, 1119 }, { 1888, 1119 },
+    { 1888, 1125 }, { 1888, 1119 }, { 1894, 1125 }, { 1894, 1119 }, { 1894, 1125 }, { 1894, 1119 }, { 1894, 1125 }, { 1894, 1125 },
+    { 1894, 1125 }, { 1894, 1125 }, { 1894, 1125 }, { 1894, 1131 }, { 1894, 1131 }, { 1894, 1138 }, { 1900, 1131 }, { 1900, 1131 },
+    { 1900, 1131 }, { 1900, 1138 }, { 1900, 1138 }, { 1900, 1138 }, { 1906, 1138 }, { 1906, 1138 }, { 1906, 1144 }, { 1906, 1144 },
+    { 1906, 1144 }, { 1906, 1144 }, { 1913, 1144 }, { 1913, 1144 }, { 1913, 1144 }, { 1913, 1150 }, { 1913, 1150 }, { 1913, 1156 },
+    { 1919, 1150 }, { 1913, 1150 }, { 1919, 1150 }, { 1919, 1156 }, { 1919, 1156 }, { 1919, 1163 }, { 1919, 1163 }, { 1919, 1156 },
+    { 1919, 1163 }, { 1919, 1163 }, { 1919, 1163 }, { 1925, 1163 }, { 1925, 1163 }, { 1925, 1163 }, { 1925, 1163 }, { 1931, 1169 },
+    { 1931, 1169 }, { 1931, 1169 }, { 1931, 1169 }, { 1931, 1169 }, { 1931, 1169 }, { 1931, 1169 }, { 1938, 1169 }, { 1938, 1169 },
+    { 1931, 1169 }, { 1938, 1175 }, { 1938, 1169 }, { 1938, 1169 }, { 1938, 1169 }, { 1938, 1169 }, { 1938, 1175 }, { 1938, 1169 },
+    { 1944, 1169 }, { 1944, 1175 }, { 1944, 1175 }, { 1944, 1175 }, { 1944, 1175 }, { 1944, 1175 }, { 1950, 1175 }, { 1944, 1175 },
+    { 1950, 1175 }, { 1950, 1175 }, { 1950, 1175 }, { 1950, 1175 }, { 1950, 1175 }, { 1950, 1175 }, { 1950, 1175 }, { 1950, 1175 },
+    { 1950, 1175 }, { 1950, 1175 }, { 1956, 1181 }, { 1956, 1175 }, { 1956, 1175 }, { 1956, 1181 }, { 1956, 1181 }, { 1963, 1181 },
+    { 1963, 1181 }, { 1963, 1181 }, { 1969, 1181 }, { 1963, 1188 }, { 1963, 1181 }, { 1963, 1181 }, { 1963, 1181 }, { 1963, 1188 },
+    { 1969, 1188 }, { 1969, 1188 }, { 1969, 1188 }, { 1969, 1188 }, { 1969, 1188 }, { 1969, 1188 }, { 1975, 1188 }, { 1975, 1194 },
+    { 1975, 1194 }, { 1975, 1188 }, { 1975, 1188 }, { 1975, 1194 }, { 1981, 1194 }, { 1981, 1194 }, { 1975, 1194 }, { 1975, 1194 },
+    { 1975, 1200 }, { 1975, 1194 }, { 1975, 1194 }, { 1981, 1194 }, { 1981, 1200 }, { 1981, 1200 }, { 1981, 1200 }, { 1981, 1200 },
+    { 1981, 1200 }, { 1981, 1200 }, { 1988, 1206 }, { 1988, 1200 }, { 1988, 1200 }, { 1988, 1200 }, { 1988, 1206 }, { 1994, 1200 },
+    { 1988, 1206 }, { 1988, 1206 }, { 1988, 1206 }, { 1988, 1206 }, { 1988, 1206 }, { 1994, 1206 }, { 1988, 1206 }, { 1994, 1206 },
+    { 1994, 1206 }, { 1994, 1206 }, { 1994, 1206 }, { 1994, 1206 }, { 1994, 1206 }, { 1994, 1206 }, { 2000, 1213 }, { 2000, 1213 },
+    { 2000, 1206 }, { 2000, 1206 }, { 2000, 1206 }, { 2000, 1206 }, { 2000, 1213 }, { 2000, 1213 }, { 2000, 1213 }, { 2000, 1213 },
+    { 2000, 1213 }, { 2000, 1206 }, { 2000, 1213 }, { 2006, 1206 }, { 2006, 1213 }, { 2006, 1213 }, { 2013, 1206 }, { 2013, 1206 },
+    { 2006, 1213 }, { 2006, 1213 }, { 2006, 1213 }, { 2013, 1213 }, { 2013, 1213 }, { 2013, 1206 }, { 2013, 1213 }, { 2013, 1213 },
+    { 2013, 1213 }, { 2006, 1213 }, { 2013, 1213 }, { 2013, 1213 }, { 2013, 1213 }, { 2013, 1213 }, { 2013, 1213 }, { 2013, 1213 },
+    { 2013, 1213 }, { 2019, 1213 }, { 2019, 1213 }, { 2019, 1213 }, { 2019, 1213 }, { 2019, 1213 }, { 2019, 1213 }, { 2019, 1206 },
+    { 2019, 1213 }, { 2019, 1213 }, { 2019, 1213 }, { 2019, 1213 }, { 2019, 1213 }, { 2019, 1213 }, { 2019, 1213 }, { 2019, 1213 },
+    { 2019, 1213 }, { 2013, 1213 }, { 2019, 1213 }, { 2019, 1213 }, { 2019, 1213 }, { 2019, 1213 }, { 2019, 1213 }, { 2019, 1213 },
+    { 2025, 1213 }, { 2019, 1213 }, { 2019, 1213 }, { 2019, 1213 }, { 2025, 1213 }, { 2025, 1213 }, { 2025, 1213 }, { 2019, 1213 },
+    { 2019, 1213 }, { 2025, 1213 }, { 2019, 1219 }, { 2019, 1213 }, { 2025, 1219 }, { 2019, 1219 }, { 2019, 1219 }, { 2025, 1219 },
+    { 2025, 1219 }, { 2025, 1219 }, { 2025, 1219 }, { 2025, 1219 }, { 2031, 1219 }, { 2031, 1225 }, { 2031, 1219 }, { 2031, 1219 },
+    { 2031, 1219 }, { 2031, 1225 }, { 2031, 1219 }, { 2031, 1225 }, { 2031, 1225 }, { 2031, 1225 }, { 2025, 1225 }, { 2031, 1225 },
+    { 2031, 1225 }, { 2031, 1225 }, { 2031, 1225 }, { 2038, 1225 }, { 2038, 1225 }, { 2038, 1225 }, { 2038, 1225 }, { 2038, 1231 },
+    { 2038, 1225 }, { 2038, 1225 }, { 2038, 1225 }, { 2038, 1225 }, { 2038, 1225 }, { 2038, 1231 }, { 2038, 1225 }, { 2038, 1231 },
+    { 2038, 1231 }, { 2038, 1231 }, { 2038, 1231 }, { 2038, 1231 }, { 2038, 1231 }, { 2038, 1238 }, { 2044, 1231 }, { 2044, 1231 },
+    { 2044, 1231 }, { 2044, 1231 }, { 2044, 1238 }, { 2044, 1231 }, { 2044, 1231 }, { 2044, 1231 }, { 2044, 1231 }, { 2044, 1231 },
+    { 2044, 1238 }, { 2044, 1238 }, { 2050, 1238 }, { 2050, 1238 }, { 2044, 1238 }, { 2050, 1238 }, { 2044, 1238 }, { 2050, 1238 },
+    { 2050, 1238 }, { 2050, 1238 }, { 2050, 1238 }, { 2050, 1238 }, { 2050, 1238 }, { 2050, 1244 }, { 2050, 1244 }, { 2050, 1244 },
+    { 2050, 1244 }, { 2050, 1238 }, { 2050, 1244 }, { 2050, 1244 }, { 2050, 1244 }, { 2050, 1244 }, { 2050, 1244 }, { 2050, 1244 },
+    { 2056, 1244 }, { 2050, 1244 }, { 2056, 1244 }, { 2050, 1244 }, { 2056, 1250 }, { 2056, 1250 }, { 2056, 1250 }, { 2056, 1244 },
+    { 2056, 1250 }, { 2056, 1250 }, { 2063, 1250 }, { 2056, 1244 }, { 2056, 1244 }, { 2063, 1250 }, { 2063, 1250 }, { 2063, 1250 },
+    { 2056, 1250 }, { 2056, 1250 }, { 2056, 1250 }, { 2056, 1256 }, { 2063, 1244 }, { 2056, 1244 }, { 2056, 1250 }, { 2063, 1250 },
+    { 2063, 1250 }, { 2063, 1250 }, { 2063, 1244 }, { 2063, 1250 }, { 2063, 1250 }, { 2063, 1250 }, { 2063, 1250 }, { 2063, 1244 },
+};
+
+static const uint16_t traceRowCount = sizeof(traceRows) / sizeof(traceRows[0]);
+
+#endif
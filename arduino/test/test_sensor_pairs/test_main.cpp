@@ -0,0 +1,141 @@
+// SensorManager's pair assignment on the mock bus: a pair table decides the
+// roles whatever the ROM order, the EEPROM cache keeps them across boots, and
+// a sensor that disappears is replaced on its own without a bus search
+// reshuffling the pairs that still answer.
+
+#include <unity.h>
+#include <EEPROM.h>
+#include "SensorManager.h"
+
+#define DEVICES 4
+
+// Bus devices 0..3, deliberately not in the order the pairs use them
+static const DeviceAddress zone0Dry = { 0x28, 0xC4, 0x11, 0x00, 0x00, 0x00, 0x00, 0x01 };
+static const DeviceAddress zone0Wet = { 0x28, 0x07, 0x22, 0x00, 0x00, 0x00, 0x00, 0x02 };
+static const DeviceAddress zone1Dry = { 0x28, 0x3A, 0x33, 0x00, 0x00, 0x00, 0x00, 0x03 };
+static const DeviceAddress zone1Wet = { 0x28, 0x91, 0x44, 0x00, 0x00, 0x00, 0x00, 0x04 };
+static const DeviceAddress spare = { 0x28, 0x55, 0x55, 0x00, 0x00, 0x00, 0x00, 0x05 };
+
+static const SensorPairAddresses table[] = {
+    { { 0x28, 0xC4, 0x11, 0x00, 0x00, 0x00, 0x00, 0x01 }, { 0x28, 0x07, 0x22, 0x00, 0x00, 0x00, 0x00, 0x02 } },
+    { { 0x28, 0x3A, 0x33, 0x00, 0x00, 0x00, 0x00, 0x03 }, { 0x28, 0x91, 0x44, 0x00, 0x00, 0x00, 0x00, 0x04 } },
+};
+
+// Each device reads a distinct temperature, so a reading names its sensor
+static void placeDevice(uint8_t index, const DeviceAddress address, float celsius) {
+    DallasTemperature::mockSetAddress(index, address);
+    DallasTemperature::mockSetTemperature(index, celsius);
+}
+
+void setUp() {
+    for (uint16_t i = 0; i < EEPROM.length(); i++) {
+        EEPROM.write(i, 0xFF);
+    }
+    DallasTemperature::mockSetDeviceCount(DEVICES);
+    placeDevice(0, zone1Wet, 11);
+    placeDevice(1, zone0Dry, 20);
+    placeDevice(2, zone1Dry, 21);
+    placeDevice(3, zone0Wet, 10);
+}
+
+void tearDown() {}
+
+// One conversion, then the readings of every pair
+static void sample(SensorManager& manager) {
+    mockAdvanceMillis(1000);
+    manager.poll();
+    TEST_ASSERT_TRUE(manager.ready());
+}
+
+static void assertZones(SensorManager& manager, float wet1) {
+    sample(manager);
+    TEST_ASSERT_EQUAL_UINT8(2, manager.getPairCount());
+    TEST_ASSERT_EQUAL_FLOAT(20, manager.getDryBulbTemperature(0));
+    TEST_ASSERT_EQUAL_FLOAT(10, manager.getWetBulbTemperature(0));
+    TEST_ASSERT_EQUAL_FLOAT(21, manager.getDryBulbTemperature(1));
+    TEST_ASSERT_EQUAL_FLOAT(wet1, manager.getWetBulbTemperature(1));
+}
+
+// The table wins over ROM order and needs no search; the cache then
+// remembers it for boots without one
+static void test_table_assigns_roles() {
+    unsigned searches = DallasTemperature::mockSearches;
+    SensorManager manager;
+    manager.setPairTable(table, 2);
+    manager.begin(12, 2000);
+    TEST_ASSERT_TRUE(manager.cachedBoot);
+    TEST_ASSERT_EQUAL_UINT(searches, DallasTemperature::mockSearches);
+    assertZones(manager, 11);
+
+    SensorManager rebooted;
+    rebooted.begin(12, 2000);
+    TEST_ASSERT_TRUE(rebooted.cachedBoot);
+    TEST_ASSERT_EQUAL_UINT(searches, DallasTemperature::mockSearches);
+    assertZones(rebooted, 11);
+}
+
+// A replaced wet bulb is found by itself; the other three sensors keep their
+// roles and the cache takes the new address
+static void test_missing_sensor_replaced_alone() {
+    SensorManager manager;
+    manager.setPairTable(table, 2);
+    manager.begin(12, 2000);
+
+    placeDevice(0, spare, 12);
+    unsigned searches = DallasTemperature::mockSearches;
+    SensorManager rebooted;
+    rebooted.begin(12, 2000);
+    TEST_ASSERT_FALSE(rebooted.cachedBoot);
+    TEST_ASSERT_TRUE(DallasTemperature::mockSearches > searches);
+    assertZones(rebooted, 12);
+
+    searches = DallasTemperature::mockSearches;
+    SensorManager again;
+    again.begin(12, 2000);
+    TEST_ASSERT_TRUE(again.cachedBoot);
+    TEST_ASSERT_EQUAL_UINT(searches, DallasTemperature::mockSearches);
+    assertZones(again, 12);
+}
+
+// With nothing to replace it with, a missing sensor reads disconnected and
+// the rest of the assignment stands
+static void test_missing_sensor_without_spare() {
+    SensorManager manager;
+    manager.setPairTable(table, 2);
+    manager.begin(12, 2000);
+
+    DallasTemperature::mockSetDeviceCount(DEVICES - 1);  // zone0Wet, device 3, is gone
+    SensorManager rebooted;
+    rebooted.begin(12, 2000);
+    sample(rebooted);
+    TEST_ASSERT_EQUAL_UINT8(2, rebooted.getPairCount());
+    TEST_ASSERT_EQUAL_FLOAT(20, rebooted.getDryBulbTemperature(0));
+    TEST_ASSERT_EQUAL_FLOAT(DEVICE_DISCONNECTED_C, rebooted.getWetBulbTemperature(0));
+    TEST_ASSERT_EQUAL_FLOAT(21, rebooted.getDryBulbTemperature(1));
+    TEST_ASSERT_EQUAL_FLOAT(11, rebooted.getWetBulbTemperature(1));
+}
+
+// assignPair() corrects a ROM-order first boot, and the correction survives
+static void test_assign_pair_persists() {
+    SensorManager manager;
+    manager.begin(12, 2000);
+    TEST_ASSERT_FALSE(manager.cachedBoot);
+    TEST_ASSERT_EQUAL_UINT8(2, manager.getPairCount());
+    TEST_ASSERT_TRUE(manager.assignPair(0, zone0Dry, zone0Wet));
+    TEST_ASSERT_TRUE(manager.assignPair(1, zone1Dry, zone1Wet));
+    TEST_ASSERT_FALSE(manager.assignPair(3, zone1Dry, zone1Wet));
+
+    SensorManager rebooted;
+    rebooted.begin(12, 2000);
+    TEST_ASSERT_TRUE(rebooted.cachedBoot);
+    assertZones(rebooted, 11);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_table_assigns_roles);
+    RUN_TEST(test_missing_sensor_replaced_alone);
+    RUN_TEST(test_missing_sensor_without_spare);
+    RUN_TEST(test_assign_pair_persists);
+    return UNITY_END();
+}
@@ -0,0 +1,81 @@
+#ifndef CHART_GEOMETRY_H
+#define CHART_GEOMETRY_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+// Line geometry of the psychrometric chart in webapp/static/psychrometrics.js,
+// precomputed so the browser only has to draw it. The chart is in IP units:
+// x is dry bulb in °F, y is vapor pressure in psia. Saturation comes from the
+// firmware's P_ws (lib/Psychrometrics); the straight-line relations for
+// humidity ratio, enthalpy, volume and wet bulb are the ones the chart uses.
+
+#define CHART_MAGIC "PSYC"
+#define CHART_VERSION 1
+#define CHART_MIN_TEMP 32.0     // °F, left edge of every chart
+#define CHART_QUANT 65535       // Coordinates are stored as uint16 over the chart domain
+#define CHART_TOLERANCE 1e-4    // Default simplification tolerance, fraction of the domain
+
+// Line families in file order. Each line carries one value (the temperature,
+// ratio, RH, ...) and optionally one label anchor with the curve's slope
+// there in psia/°F; the client turns that into a rotation for its scales.
+enum ChartFamily {
+    CHART_BOUNDARY,         // Chart outline along the saturation curve, one closed line
+    CHART_TEMP,             // Constant dry bulb
+    CHART_HUMIDITY,         // Constant humidity ratio
+    CHART_RH,               // Constant relative humidity, value in %
+    CHART_VOLUME,           // Constant specific volume, ft^3/lb
+    CHART_ENTHALPY,         // Constant enthalpy, Btu/lb
+    CHART_WET_BULB,         // Constant wet bulb, °F
+    CHART_ENTHALPY_BORDER,  // The enthalpy scale's border, one line
+    CHART_FAMILIES
+};
+
+struct ChartConfig {
+    double totalPressure;  // psia
+    double maxTemp;        // °F
+    double maxW;           // lb/lb
+};
+
+struct ChartPoint {
+    double temp;  // °F
+    double pv;    // psia
+};
+
+struct ChartLine {
+    double value;
+    double labelTemp;   // NAN when the line has no label
+    double labelPv;
+    double labelSlope;  // psia/°F
+    std::vector<ChartPoint> points;
+};
+
+struct ChartGeometry {
+    ChartConfig config;
+    double maxPv;                // psia at maxW
+    double tempAtCutoff;         // °F where saturation reaches maxPv
+    double upperLeftBorderTemp;  // Corners of the enthalpy border
+    double bottomLeftBorderPv;
+    std::vector<ChartLine> families[CHART_FAMILIES];
+};
+
+// Every line family for one pressure and range, at the sampling steps of
+// psychrometrics.js. Points above maxPv are clamped to it, as the chart does.
+void buildChartGeometry(const ChartConfig& config, ChartGeometry& out);
+
+// Little endian, every field 4-byte aligned so the client can view it with
+// typed arrays in place:
+//   "PSYC", uint16 version, uint16 family count,
+//   float32 pressure, maxTemp, maxW, maxPv, tempAtCutoff, upperLeftBorderTemp, bottomLeftBorderPv,
+//   then per family: uint32 line count, and per line
+//     float32 value, labelTemp, labelPv, labelSlope, uint32 point count,
+//     uint16 [temp, pv] pairs scaled over [CHART_MIN_TEMP, maxTemp] x [0, maxPv].
+// Lines are simplified (Douglas-Peucker) to within tolerance of the domain
+// in both axes before quantizing.
+void encodeChartGeometry(const ChartGeometry& geometry, double tolerance, std::vector<uint8_t>& out);
+
+// FNV-1a 64 over the encoded file, for its cache-busting name
+uint64_t chartContentHash(const std::vector<uint8_t>& data);
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef HISTORY_QUERY_H
+#define HISTORY_QUERY_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+#include <sqlite3.h>
+#include "RollupStore.h"
+
+#define HISTORY_TIER_RAW -1      // tier() when the samples table itself was read
+#define HISTORY_SOURCE_FACTOR 8  // Source rows read per point returned, at most
+#define HISTORY_MAX_POINTS 5000
+
+struct HistoryPoint {
+    int64_t timestamp;  // UTC epoch ms; the middle of the bucket for rollup tiers
+    double values[ROLLUP_FIELDS];
+};
+
+// Read side of the samples and rollup tables, for webapp/server.js history
+// requests. query() picks the finest source that needs at most
+// HISTORY_SOURCE_FACTOR rows per requested point (raw samples while they
+// are sparse enough, then 10 s, 1 min and 10 min buckets) and reduces it
+// with largest-triangle-three-buckets. The work per request therefore
+// depends on the point count and window, not on how many raw rows exist.
+class HistoryQuery {
+public:
+    HistoryQuery();
+    ~HistoryQuery();
+
+    bool open(const char* path);
+    void close();
+    const char* error() const;
+
+    // Up to maxPoints points of channel in [from, to), oldest first
+    bool query(uint8_t channel, int64_t from, int64_t to, size_t maxPoints, std::vector<HistoryPoint>& out);
+
+    int tier() const { return sourceTier; }
+    size_t sourceRows() const { return source.size(); }
+
+private:
+    sqlite3* db;
+    sqlite3_stmt* rawCount;
+    sqlite3_stmt* select[ROLLUP_TIERS + 1];  // Raw samples first, then the tiers
+    int sourceTier;
+    std::vector<HistoryPoint> source;
+
+    int chooseTier(uint8_t channel, int64_t from, int64_t to, size_t maxPoints);
+};
+
+// Largest-triangle-three-buckets over dry and wet bulb together: in every
+// bucket the point spanning the largest summed triangle area of the two
+// series is kept, so a peak in either survives. First and last are kept.
+void historyDownsample(const std::vector<HistoryPoint>& in, size_t maxPoints, std::vector<HistoryPoint>& out);
+
+// One point as a JSON object shaped like a webapp/db.js measurements row
+size_t historyFormatPoint(const HistoryPoint& point, char* out, size_t size);
+
+#endif
@@ -0,0 +1,13 @@
+#ifndef INGEST_CLOCK_H
+#define INGEST_CLOCK_H
+
+#include <stdint.h>
+
+// UTC wall clock, for row timestamps
+int64_t ingestWallClockMs();
+
+// Monotonic clock, for deadlines and latencies
+int64_t ingestMonotonicMs();
+int64_t ingestMonotonicUs();
+
+#endif
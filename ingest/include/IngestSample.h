@@ -0,0 +1,29 @@
+#ifndef INGEST_SAMPLE_H
+#define INGEST_SAMPLE_H
+
+#include <stdint.h>
+#include <PsychroFrame.h>
+#include <Psychrometrics.h>
+
+// One decoded state, whatever format it arrived in
+struct IngestSample {
+    int64_t timestamp;   // UTC epoch ms; device time mapped to host time for replays
+    int32_t seq;         // Device seq, -1 for CSV lines which carry none
+    uint8_t channel;     // Sensor pair, 0 is the primary
+    bool live;           // false for samples replayed from the device log
+    PsychroState state;
+};
+
+// Receives every sample the parser accepts, in arrival order
+class IngestSink {
+public:
+    virtual ~IngestSink() {}
+    virtual void onSample(const IngestSample& sample) = 0;
+
+    // Profiling reports from TELEMETRY firmware builds, kept apart from the
+    // samples. timestamp is UTC epoch ms like IngestSample's.
+    virtual void onTelemetry(const PsychroTelemetryFrame&, int64_t) {}
+    virtual void onTelemetrySpan(const PsychroTelemetrySpanFrame&, int64_t) {}
+};
+
+#endif
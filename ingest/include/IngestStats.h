@@ -0,0 +1,27 @@
+#ifndef INGEST_STATS_H
+#define INGEST_STATS_H
+
+#include <stdint.h>
+
+#define LATENCY_BUCKETS 32  // Bucket i holds values in [2^(i-1), 2^i) us
+
+// Fixed-size log2 histogram, cheap enough to update on every commit
+class LatencyHistogram {
+public:
+    LatencyHistogram();
+
+    void add(int64_t micros);
+    void reset();
+
+    // Upper bound of the bucket holding the given quantile (0..1), in us
+    int64_t quantile(double q) const;
+    int64_t max() const { return maxMicros; }
+    uint64_t count() const { return total; }
+
+private:
+    uint64_t buckets[LATENCY_BUCKETS];
+    uint64_t total;
+    int64_t maxMicros;
+};
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef ROLLUP_STORE_H
+#define ROLLUP_STORE_H
+
+#include <stdint.h>
+#include <sqlite3.h>
+#include <PsychroFrame.h>
+#include "IngestSample.h"
+
+#define ROLLUP_TIERS 3   // 10 s, 1 min, 10 min
+#define ROLLUP_FIELDS 8  // The state columns of the samples table, in table order
+
+// Width and table of each tier, finest first
+extern const int64_t rollupWidthMs[ROLLUP_TIERS];
+extern const char* const rollupTables[ROLLUP_TIERS];
+extern const char* const rollupFields[ROLLUP_FIELDS];
+
+// Column values of a sample in samples-table units (relative humidity in %)
+void rollupValues(const PsychroState& state, double values[ROLLUP_FIELDS]);
+
+// Min/max/mean tiers over the samples table, maintained as rows are added.
+//
+// Each (channel, tier) keeps its current bucket in memory. flush(), called
+// inside SampleStore's transaction right before COMMIT, merges every open
+// bucket into its table with an upsert (counts add, means are weighted by
+// count, min/max combine) and empties the accumulator. Flushing a bucket
+// twice is therefore harmless, and a replayed sample that falls into an
+// older bucket is simply merged on its own. Tables are created, and filled
+// from existing samples, on first open.
+//
+// Non-finite values (a dew point that did not converge, stored as NULL)
+// are left out of their field's mean, min and max. Each field keeps its own
+// count of the values it holds, <field>_count, which weights the merge;
+// count is the number of rows.
+class RollupStore {
+public:
+    RollupStore();
+    ~RollupStore();
+
+    bool open(sqlite3* db);
+    void close();
+
+    bool add(const IngestSample& sample);
+    bool flush();
+    // Merge the samples in [from, to) into every tier straight from the
+    // table, e.g. rows imported by SampleStore; call inside a transaction
+    bool rollUp(int64_t from, int64_t to);
+    // Forget what was added since the last flush, when its transaction is rolled back
+    void discard();
+
+    uint64_t upserts;
+
+private:
+    struct Bucket {
+        int64_t start;  // Epoch ms; -1 while unused
+        uint32_t count;
+        uint32_t valid[ROLLUP_FIELDS];  // Finite values in sum, min and max
+        double sum[ROLLUP_FIELDS];
+        double min[ROLLUP_FIELDS];
+        double max[ROLLUP_FIELDS];
+    };
+
+    sqlite3* db;
+    sqlite3_stmt* upsert[ROLLUP_TIERS];
+    Bucket buckets[PSYCHRO_FRAME_MAX_CHANNELS][ROLLUP_TIERS];
+
+    bool createTier(uint8_t tier);
+    bool rollUpTier(uint8_t tier, int64_t from, int64_t to);
+    bool write(uint8_t tier, uint8_t channel, const Bucket& bucket);
+    static void clear(Bucket& bucket, int64_t start);
+    static void accumulate(Bucket& bucket, const double values[ROLLUP_FIELDS]);
+};
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef SAMPLE_STORE_H
+#define SAMPLE_STORE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sqlite3.h>
+#include "IngestSample.h"
+#include "IngestStats.h"
+#include "RollupStore.h"
+
+// Batched writer for the samples table in webapp/measurements.db.
+//
+// Rows go into one open transaction through a single prepared INSERT, which
+// is committed once batchSize rows are in or the oldest row has waited
+// commitIntervalMs, whichever comes first. The database runs in WAL mode
+// with synchronous=NORMAL, so the Node server can read while rows are being
+// written and a commit costs no fsync until the next checkpoint.
+//
+// Timestamps are UTC epoch ms. Units follow the measurements table written
+// by webapp/db.js: relative humidity in %, everything else as PsychroState.
+// Rows that table holds from before the first sample are imported on open.
+// The rollup tiers are updated in the same transaction, so they never lag
+// behind committed samples. A failed statement rolls the whole batch back,
+// rollups included, and the next add() starts a new one.
+class SampleStore {
+public:
+    SampleStore();
+    ~SampleStore();
+
+    bool open(const char* path, size_t batchSize, int64_t commitIntervalMs);
+    void close();
+
+    bool add(const IngestSample& sample);
+
+    // Commit if the open batch is due; call whenever the event loop wakes
+    bool tick(int64_t monotonicNow);
+    bool commit();
+
+    // ms until tick() has work to do, or -1 if no batch is open
+    int64_t msUntilCommit(int64_t monotonicNow) const;
+
+    const char* error() const;
+
+    uint64_t rows;               // Rows committed
+    uint64_t rowsLost;           // Rows rolled back with a failed batch
+    uint64_t commits;
+    LatencyHistogram commitTime; // Rollup flush and COMMIT
+    LatencyHistogram rowDelay;   // Oldest row's wait from add() to durable
+    RollupStore rollups;
+
+private:
+    sqlite3* db;
+    sqlite3_stmt* insert;
+    sqlite3_stmt* begin;
+    sqlite3_stmt* end;
+    size_t batchSize;
+    int64_t commitIntervalMs;
+
+    size_t pending;         // Rows in the open transaction
+    int64_t batchStartUs;   // Monotonic time of its first row
+    char failure[128];      // sqlite3_errmsg() of the statement that failed the batch
+
+    bool exec(const char* sql);
+    void rollback();
+    bool importMeasurements();
+    bool step(sqlite3_stmt* statement);
+};
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef SERIAL_SOURCE_H
+#define SERIAL_SOURCE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+// The byte stream from the board: a serial device, or a pty, FIFO or
+// capture file standing in for it. Terminals are put in raw mode at the
+// given baud and are the only kind that can be written back to.
+class SerialSource {
+public:
+    SerialSource();
+    ~SerialSource();
+
+    bool open(const char* path, unsigned long baud);
+    void close();
+
+    // Change a terminal's rate in place, e.g. to follow a backfill replay
+    bool setBaud(unsigned long baud);
+    unsigned long baud() const { return rate; }
+    static bool supportsBaud(unsigned long baud);
+
+    int fd() const { return handle; }
+    bool isOpen() const { return handle >= 0; }
+    bool writable() const { return terminal; }
+    bool regularFile() const { return file; }
+
+    // Bytes read, 0 at end of stream or on hangup (close and reopen), -1 if
+    // nothing is available yet
+    ssize_t read(uint8_t* buffer, size_t length);
+    bool write(const uint8_t* data, size_t length);
+
+private:
+    int handle;
+    bool terminal;
+    bool file;
+    unsigned long rate;
+};
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef STATE_PUBLISHER_H
+#define STATE_PUBLISHER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <PsychroFrame.h>
+#include "IngestSample.h"
+
+#define PUBLISHER_MAX_CLIENTS 16
+#define PUBLISHER_MESSAGE_MAX 384
+
+// Publishes live samples on a unix stream socket as newline-delimited JSON,
+// in the shape webapp/server.js sends to browsers plus channel and seq. A
+// new client first gets the latest state of every channel. Sends never
+// block: a client whose socket buffer is full is dropped and has to
+// reconnect, so a stalled reader cannot hold up ingestion.
+class StatePublisher {
+public:
+    StatePublisher();
+    ~StatePublisher();
+
+    bool open(const char* path);
+    void close();
+
+    int listenFd() const { return listener; }
+    void acceptClients();
+    void publish(const IngestSample& sample);
+
+    uint64_t published;
+    uint64_t dropped;  // Clients that went away or fell behind
+
+private:
+    int listener;
+    char path[108];
+    int clients[PUBLISHER_MAX_CLIENTS];
+    uint8_t clientCount;
+
+    char latest[PSYCHRO_FRAME_MAX_CHANNELS][PUBLISHER_MESSAGE_MAX];
+    size_t latestLength[PSYCHRO_FRAME_MAX_CHANNELS];
+
+    bool send(int client, const char* message, size_t length);
+    void drop(uint8_t index);
+};
+
+#endif
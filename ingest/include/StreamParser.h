@@ -0,0 +1,95 @@
+#ifndef STREAM_PARSER_H
+#define STREAM_PARSER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <PsychroFrame.h>
+#include "IngestSample.h"
+
+#define STREAM_LINE_MAX 128        // Longest CSV line kept; longer ones are dropped
+#define STREAM_BACKFILL_RETRY_MS 5000  // Wait before asking for the same gap again
+#define STREAM_ACK_INTERVAL 32         // Live seqs between log acks, well within the device's SRAM log
+#define STREAM_REPLAY_TIMEOUT_MS 2000  // Silence at a replay rate before falling back to the link rate
+
+// Turns the raw byte stream from the board into IngestSamples without
+// allocating. CSV mode takes the firmware's 8-field lines and skips anything
+// else (debug output). Binary mode decodes PsychroFrame frames, drops
+// duplicate seqs and notices gaps that a backfill request could close.
+// Telemetry frames go to the sink's onTelemetry*() in either mode; CSV mode
+// gets them as '#' lines of hex.
+class StreamParser {
+public:
+    enum Format {
+        FORMAT_CSV,
+        FORMAT_BINARY,
+    };
+
+    explicit StreamParser(Format format = FORMAT_CSV);
+
+    // Feed bytes as they arrive; now is the UTC wall clock in ms
+    void push(const uint8_t* data, size_t length, int64_t now, IngestSink& sink);
+
+    // True once per gap in the live seqs; fromSeq is the first missing one
+    bool backfillWanted(uint16_t& fromSeq, int64_t monotonicNow);
+
+    // True every STREAM_ACK_INTERVAL live seqs; nextSeq is the first seq not
+    // held yet, which is the start of a gap until its backfill has ended
+    bool ackWanted(uint16_t& nextSeq);
+
+    // The rate the device has switched the link to for a backfill replay, 0
+    // for the configured one: a BEGIN frame's baud until its END
+    unsigned long replayBaud() const { return replayRate; }
+
+    // True once no frame has decoded at the replay rate for
+    // STREAM_REPLAY_TIMEOUT_MS, i.e. the END was lost or the rate never got
+    // through. The replay is given up on and its gap asked for again.
+    bool replayTimedOut(int64_t monotonicNow);
+
+    // Forget seqs and device time, e.g. after reopening the device
+    void reset();
+
+    uint64_t lines;        // CSV lines accepted
+    uint64_t frames;       // Frames accepted
+    uint64_t skipped;      // Lines or frames that were not samples
+    uint64_t invalid;      // Samples out of range or malformed
+    uint64_t duplicates;   // Seqs seen before
+    uint64_t deviceResets; // Seq and device time restarted
+    uint64_t telemetry;    // Telemetry frames accepted
+    uint64_t replayTimeouts; // Replays given up on by replayTimedOut()
+
+    uint64_t crcErrors() const { return decoder.crcErrors; }
+    uint64_t frameErrors() const { return decoder.frameErrors; }
+
+private:
+    Format format;
+
+    char line[STREAM_LINE_MAX];
+    size_t lineLength;
+    bool lineOverflow;
+
+    PsychroFrameDecoder decoder;
+    PsychroSeqFilter seqs;
+    bool synced;             // A live seq has been seen since reset()
+    uint32_t lastDeviceTime; // header.timestamp of the newest live frame
+    int64_t deviceOffset;    // Host UTC ms minus device millis()
+    bool gap;
+    uint16_t gapFrom;
+    int64_t lastBackfillAt;
+    bool hole;               // A gap whose backfill has not ended yet
+    uint16_t holeFrom;
+    uint16_t liveSinceAck;
+    unsigned long replayRate;
+    uint32_t replayFrames;   // decoder.frames when replayActiveAt was taken
+    int64_t replayActiveAt;  // Monotonic ms of the last frame at the replay rate, 0 before the first check
+
+    void pushCsv(uint8_t byte, int64_t now, IngestSink& sink);
+    void parseLine(int64_t now, IngestSink& sink);
+    void parseHexFrame(int64_t now, IngestSink& sink);
+    void handleFrame(int64_t now, IngestSink& sink);
+    void handleTelemetry(uint8_t type, const uint8_t* body, size_t length, int64_t now, IngestSink& sink);
+    bool acceptSeq(const PsychroFrameHeader& header, bool live, int64_t now);
+    void emit(IngestSink& sink, const PsychroFrameHeader& header, bool live, uint8_t channel,
+              float dryBulbTemp, float wetBulbTemp, int64_t now);
+};
+
+#endif
@@ -0,0 +1,486 @@
+#include "ChartGeometry.h"
+#include <math.h>
+#include <string.h>
+#include <utility>
+#include "Psychrometrics.h"
+
+#define PSI_PER_KPA 0.1450377377
+#define RDA 53.35                 // Dry air gas constant, ft-lbf / lb-R
+#define SOLVER_MAX_ITERATIONS 500
+
+static const double constantRhValues[] = { 10, 20, 30, 40, 50, 60, 70, 80, 90 };
+static const double wetBulbLabelRh = 0.55;  // RH the wet bulb labels sit on
+static const double volumeLabelRh = 0.35;
+
+// Saturation pressure (psia) at temp (°F) from the firmware's P_ws; the
+// slope in psia/°F if asked for
+static double satPress(double temp, double* slope = 0) {
+    double dP_dT;
+    double P = P_ws_slope<double>((temp - 32) / 1.8, &dP_dT);
+    if (slope) {
+        *slope = dP_dT * PSI_PER_KPA / 1.8;
+    }
+    return P * PSI_PER_KPA;
+}
+
+static double wFromPv(double pv, double totalPressure) {
+    return 0.621945 * pv / (totalPressure - pv);
+}
+
+static double pvFromW(double w, double totalPressure) {
+    if (w < 0.000001) {
+        return 0;
+    }
+    return totalPressure / (1 + 0.621945 / w);
+}
+
+static double satHumidityRatio(double temp, double totalPressure) {
+    return wFromPv(satPress(temp), totalPressure);
+}
+
+static double wFromWetBulb(double wetBulb, double temp, double totalPressure) {
+    double wSat = satHumidityRatio(wetBulb, totalPressure);
+    return ((1093 - 0.556 * wetBulb) * wSat - 0.24 * (temp - wetBulb)) / (1093 + 0.444 * temp - wetBulb);
+}
+
+static double tempFromWetBulbW(double wetBulb, double w, double totalPressure) {
+    double wSat = satHumidityRatio(wetBulb, totalPressure);
+    return ((1093 - 0.556 * wetBulb) * wSat + 0.24 * wetBulb - w * (1093 - wetBulb)) / (0.444 * w + 0.24);
+}
+
+static double vFromTempW(double temp, double w, double totalPressure) {
+    return 0.370486 * (temp + 459.67) * (1 + 1.607858 * w) / totalPressure;
+}
+
+static double tempFromVW(double v, double w, double totalPressure) {
+    return v * totalPressure / (0.370486 * (1 + 1.607858 * w)) - 459.67;
+}
+
+static double wFromTempV(double temp, double v, double totalPressure) {
+    return (totalPressure * v / (0.370486 * (temp + 459.67)) - 1) / 1.607858;
+}
+
+static double enthalpyFromTempPv(double temp, double pv, double totalPressure) {
+    return 0.24 * temp + wFromPv(pv, totalPressure) * (1061 + 0.445 * temp);
+}
+
+static double tempFromEnthalpyPv(double h, double pv, double totalPressure) {
+    double w = wFromPv(pv, totalPressure);
+    return (h - w * 1061) / (0.24 + w * 0.445);
+}
+
+static double wFromEnthalpyTemp(double h, double temp) {
+    return (h - 0.24 * temp) / (1061 + 0.445 * temp);
+}
+
+static double pvFromEnthalpyTemp(double h, double temp, double totalPressure) {
+    return pvFromW(wFromEnthalpyTemp(h, temp), totalPressure);
+}
+
+// Dry bulb where saturation times rh reaches pv
+static double tempFromRhPv(double rh, double pv) {
+    double temp = 80;
+    for (int i = 0; i < SOLVER_MAX_ITERATIONS; i++) {
+        double slope;
+        double residual = satPress(temp, &slope) - pv / rh;
+        if (fabs(residual) <= 0.00001) {
+            break;
+        }
+        temp -= residual / slope;
+    }
+    return temp;
+}
+
+// Dry bulb on the rh curve where the specific volume is v
+static double tempFromVRh(double v, double rh, double totalPressure) {
+    double temp = 80;
+    for (int i = 0; i < SOLVER_MAX_ITERATIONS; i++) {
+        double slope;
+        double residual = satPress(temp, &slope) * rh - (totalPressure - RDA * (temp + 459.67) / (v * 144));
+        if (fabs(residual) <= 0.0001) {
+            break;
+        }
+        temp -= residual / (rh * slope + RDA / (v * 144));
+    }
+    return temp;
+}
+
+// Dry bulb on the rh curve where the wet bulb is wetBulb (bisection)
+static double tempFromWetBulbRh(double wetBulb, double rh, double totalPressure) {
+    double low = 0;
+    double high = 200;
+    double temp = (low + high) / 2;
+    for (int i = 0; i < SOLVER_MAX_ITERATIONS; i++) {
+        temp = (low + high) / 2;
+        double residual = wFromWetBulb(wetBulb, temp, totalPressure) - wFromPv(rh * satPress(temp), totalPressure);
+        if (fabs(residual) < 0.00001) {
+            break;
+        }
+        if (residual > 0) {
+            low = temp;
+        } else {
+            high = temp;
+        }
+    }
+    return temp;
+}
+
+static double wetBulbFromTempW(double temp, double w, double totalPressure) {
+    double low = 0;
+    double high = temp;
+    double wetBulb = (low + high) / 2;
+    for (int i = 0; i < SOLVER_MAX_ITERATIONS; i++) {
+        double residual = wFromWetBulb(wetBulb, temp, totalPressure) - w;
+        if (fabs(residual) <= 0.000001) {
+            break;
+        }
+        if (residual > 0) {
+            high = wetBulb;
+        } else {
+            low = wetBulb;
+        }
+        wetBulb = (low + high) / 2;
+    }
+    return wetBulb;
+}
+
+static double satTempAtEnthalpy(double h, double totalPressure) {
+    double low = 0;
+    double high = 200;
+    double temp = (low + high) / 2;
+    for (int i = 0; i < SOLVER_MAX_ITERATIONS; i++) {
+        temp = (low + high) / 2;
+        double wSat = satHumidityRatio(temp, totalPressure);
+        double w = wFromEnthalpyTemp(h, temp);
+        if (wSat > w) {
+            high = temp;
+        } else {
+            low = temp;
+        }
+        if (fabs(wSat - w) <= 0.00005) {
+            break;
+        }
+    }
+    return temp;
+}
+
+// d(pv)/d(temp) along a constant wet bulb line
+static double wetBulbSlope(double temp, double wetBulb, double totalPressure) {
+    double wSat = satHumidityRatio(wetBulb, totalPressure);
+    double high = (1093 - 0.556 * wetBulb) * wSat - 0.24 * (temp - wetBulb);
+    double low = 1093 + 0.444 * temp - wetBulb;
+    double dw_dT = (low * -0.24 - high * 0.444) / (low * low);
+    double w = wFromWetBulb(wetBulb, temp, totalPressure);
+    double dpv_dw = 200000 * totalPressure / (200000 * w + 124389)
+                  - 40000000000.0 * totalPressure * w / pow(200000 * w + 124389, 2);
+    return dpv_dw * dw_dT;
+}
+
+// Where a constant enthalpy line meets the sloped left edge of the enthalpy border
+static double tempAtEnthalpyBorder(const ChartGeometry& g, double h) {
+    double P = g.config.totalPressure;
+    double rise = g.maxPv - g.bottomLeftBorderPv;
+    double run = g.upperLeftBorderTemp - CHART_MIN_TEMP;
+    double temp = 80;
+    for (int i = 0; i < SOLVER_MAX_ITERATIONS; i++) {
+        double residual = g.bottomLeftBorderPv + rise / run * (temp - CHART_MIN_TEMP) - pvFromEnthalpyTemp(h, temp, P);
+        if (fabs(residual) <= 0.0001) {
+            break;
+        }
+        double d = 1807179 * temp + 50000000 * h + 32994182250.0;
+        double slope = rise / run - (1807179 * (12000000 * temp - 50000000 * h) * P / (d * d) - 12000000 * P / d);
+        temp -= residual / slope;
+    }
+    return temp;
+}
+
+// min, then every multiple of step strictly between, then max; the chart's range()
+static std::vector<double> range(double min, double max, double step) {
+    std::vector<double> values;
+    if (fmod(min, step) != 0) {
+        values.push_back(min);
+    }
+    double base = step * ceil(min / step);
+    for (int n = 0; base + n * step < max; n++) {
+        values.push_back(base + n * step);
+    }
+    values.push_back(max);
+    return values;
+}
+
+static ChartLine line(double value) {
+    ChartLine l;
+    l.value = value;
+    l.labelTemp = NAN;
+    l.labelPv = NAN;
+    l.labelSlope = NAN;
+    return l;
+}
+
+static void point(ChartLine& l, double temp, double pv) {
+    ChartPoint p = { temp, pv };
+    l.points.push_back(p);
+}
+
+void buildChartGeometry(const ChartConfig& config, ChartGeometry& g) {
+    const double P = config.totalPressure;
+    const double minTemp = CHART_MIN_TEMP;
+    const double maxTemp = config.maxTemp;
+
+    g.config = config;
+    g.maxPv = pvFromW(config.maxW, P);
+    g.tempAtCutoff = tempFromRhPv(1, g.maxPv);
+    g.upperLeftBorderTemp = g.tempAtCutoff - 0.05 * (maxTemp - minTemp);
+    g.bottomLeftBorderPv = satPress(minTemp) + 0.05 * g.maxPv;
+    for (int f = 0; f < CHART_FAMILIES; f++) {
+        g.families[f].clear();
+    }
+
+    ChartLine boundary = line(0);
+    point(boundary, maxTemp, 0);
+    point(boundary, minTemp, 0);
+    point(boundary, minTemp, satPress(minTemp));
+    for (double temp : range(minTemp, g.tempAtCutoff, 0.1)) {
+        point(boundary, temp, satPress(temp));
+    }
+    point(boundary, g.tempAtCutoff, g.maxPv);
+    point(boundary, maxTemp, satPress(g.tempAtCutoff));
+    point(boundary, maxTemp, 0);
+    g.families[CHART_BOUNDARY].push_back(boundary);
+
+    for (double temp : range(minTemp, maxTemp, 1)) {
+        ChartLine l = line(temp);
+        point(l, temp, 0);
+        point(l, temp, satPress(temp));
+        g.families[CHART_TEMP].push_back(l);
+    }
+
+    double maxW = wFromPv(g.maxPv, P);
+    for (double w = 0.002; w < maxW; w += 0.002) {
+        double pv = pvFromW(w, P);
+        ChartLine l = line(w);
+        point(l, pv < satPress(minTemp) ? minTemp : tempFromRhPv(1, pv), pv);
+        point(l, maxTemp, pv);
+        g.families[CHART_HUMIDITY].push_back(l);
+    }
+
+    // RH labels step down and left from 60 % of the width, 15 % of it apart
+    double labelStep = floor((maxTemp - minTemp) * 0.15 / 9 + 0.5);
+    double labelStart = floor(minTemp + (maxTemp - minTemp) * 0.6 + 0.5);
+    for (size_t i = 0; i < sizeof(constantRhValues) / sizeof(constantRhValues[0]); i++) {
+        double rh = constantRhValues[i] / 100;
+        double end = rh * satPress(maxTemp) < g.maxPv ? maxTemp : tempFromRhPv(rh, g.maxPv);
+        ChartLine l = line(constantRhValues[i]);
+        for (double temp : range(minTemp, end, 0.5)) {
+            point(l, temp, rh * satPress(temp));
+        }
+        double slope;
+        l.labelTemp = labelStart - i * labelStep;
+        l.labelPv = rh * satPress(l.labelTemp, &slope);
+        l.labelSlope = rh * slope;
+        g.families[CHART_RH].push_back(l);
+    }
+
+    double minV = vFromTempW(minTemp, 0, P);
+    double maxV = vFromTempW(maxTemp, maxW, P);
+    double firstVCutoff = vFromTempW(minTemp, satHumidityRatio(minTemp, P), P);
+    double secondVCutoff = vFromTempW(g.tempAtCutoff, maxW, P);
+    for (double v : range(ceil(minV / 0.1) * 0.1, floor(maxV / 0.1) * 0.1, 0.1)) {
+        double lower;
+        double upper;
+        if (v < firstVCutoff) {
+            lower = minTemp;
+            upper = tempFromVW(v, 0, P);
+        } else if (v < secondVCutoff) {
+            lower = tempFromVRh(v, 1, P);
+            upper = fmin(tempFromVW(v, 0, P), maxTemp);
+        } else {
+            lower = tempFromVW(v, maxW, P);
+            upper = fmin(tempFromVW(v, 0, P), maxTemp);
+        }
+        ChartLine l = line(floor(v * 10 + 0.5) / 10);
+        point(l, lower, pvFromW(wFromTempV(lower, v, P), P));
+        point(l, upper, pvFromW(wFromTempV(upper, v, P), P));
+        l.labelTemp = tempFromVRh(v, volumeLabelRh, P);
+        l.labelPv = volumeLabelRh * satPress(l.labelTemp);
+        l.labelSlope = -RDA / v / 144;
+        g.families[CHART_VOLUME].push_back(l);
+    }
+
+    // Lines on multiples of 5 run on to the dry air axis; the rest stop at saturation
+    double firstBoundaryEnthalpy = enthalpyFromTempPv(minTemp, g.bottomLeftBorderPv, P);
+    double secondBoundaryEnthalpy = enthalpyFromTempPv(g.upperLeftBorderTemp, g.maxPv, P);
+    double minH = enthalpyFromTempPv(minTemp, 0, P);
+    double maxH = enthalpyFromTempPv(maxTemp, g.maxPv, P);
+    for (double h : range(ceil(minH), floor(maxH), 0.2)) {
+        bool major = fmod(h, 5) == 0;
+        double start;
+        if (h < firstBoundaryEnthalpy) {
+            start = minTemp;
+        } else if (h < secondBoundaryEnthalpy) {
+            start = tempAtEnthalpyBorder(g, h);
+        } else {
+            start = tempFromEnthalpyPv(h, g.maxPv, P);
+        }
+        double end = major ? fmin(h / 0.24, maxTemp) : satTempAtEnthalpy(h, P);
+        ChartLine l = line(h);
+        for (double temp : range(start, end, 0.25)) {
+            point(l, temp, pvFromEnthalpyTemp(h, temp, P));
+        }
+        if (major && h < secondBoundaryEnthalpy) {
+            l.labelTemp = tempAtEnthalpyBorder(g, h);
+            l.labelPv = pvFromEnthalpyTemp(h, l.labelTemp, P);
+        }
+        g.families[CHART_ENTHALPY].push_back(l);
+    }
+
+    double minWetBulb = wetBulbFromTempW(minTemp, 0, P);
+    double maxWetBulb = wetBulbFromTempW(maxTemp, maxW, P);
+    double bottomRightWetBulb = wetBulbFromTempW(maxTemp, 0, P);
+    for (double wetBulb : range(ceil(minWetBulb), floor(maxWetBulb), 1)) {
+        double lower;
+        double upper;
+        if (wetBulb < minTemp) {
+            lower = minTemp;
+            upper = tempFromWetBulbW(wetBulb, 0, P);
+        } else if (wetBulb < bottomRightWetBulb) {
+            lower = wetBulb;
+            upper = tempFromWetBulbW(wetBulb, 0, P);
+        } else if (wetBulb < g.tempAtCutoff) {
+            lower = wetBulb;
+            upper = maxTemp;
+        } else {
+            lower = tempFromWetBulbW(wetBulb, maxW, P);
+            upper = maxTemp;
+        }
+        ChartLine l = line(wetBulb);
+        for (double temp : range(lower, upper, 3)) {
+            point(l, temp, pvFromW(wFromWetBulb(wetBulb, temp, P), P));
+        }
+        l.labelTemp = tempFromWetBulbRh(wetBulb, wetBulbLabelRh, P);
+        l.labelPv = wetBulbLabelRh * satPress(l.labelTemp);
+        l.labelSlope = wetBulbSlope(l.labelTemp, wetBulb, P);
+        g.families[CHART_WET_BULB].push_back(l);
+    }
+
+    ChartLine border = line(0);
+    point(border, minTemp, satPress(minTemp));
+    point(border, minTemp, g.bottomLeftBorderPv);
+    point(border, g.upperLeftBorderTemp, g.maxPv);
+    point(border, g.tempAtCutoff, g.maxPv);
+    g.families[CHART_ENTHALPY_BORDER].push_back(border);
+}
+
+// Douglas-Peucker over points already scaled to the unit square
+static void simplify(const std::vector<ChartPoint>& in, double tolerance, std::vector<bool>& keep) {
+    keep.assign(in.size(), false);
+    if (in.empty()) {
+        return;
+    }
+    keep.front() = true;
+    keep.back() = true;
+    std::vector<std::pair<size_t, size_t> > spans;
+    spans.push_back(std::make_pair((size_t)0, in.size() - 1));
+    while (!spans.empty()) {
+        size_t first = spans.back().first;
+        size_t last = spans.back().second;
+        spans.pop_back();
+
+        double dx = in[last].temp - in[first].temp;
+        double dy = in[last].pv - in[first].pv;
+        double length = sqrt(dx * dx + dy * dy);
+        double worst = 0;
+        size_t worstIndex = first;
+        for (size_t i = first + 1; i < last; i++) {
+            double ex = in[i].temp - in[first].temp;
+            double ey = in[i].pv - in[first].pv;
+            double distance = length > 0 ? fabs(ex * dy - ey * dx) / length : sqrt(ex * ex + ey * ey);
+            if (distance > worst) {
+                worst = distance;
+                worstIndex = i;
+            }
+        }
+        if (worst > tolerance) {
+            keep[worstIndex] = true;
+            spans.push_back(std::make_pair(first, worstIndex));
+            spans.push_back(std::make_pair(worstIndex, last));
+        }
+    }
+}
+
+static void putU16(std::vector<uint8_t>& out, uint16_t value) {
+    out.push_back((uint8_t)value);
+    out.push_back((uint8_t)(value >> 8));
+}
+
+static void putU32(std::vector<uint8_t>& out, uint32_t value) {
+    putU16(out, (uint16_t)value);
+    putU16(out, (uint16_t)(value >> 16));
+}
+
+static void putF32(std::vector<uint8_t>& out, double value) {
+    float f = (float)value;
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+    putU32(out, bits);
+}
+
+static uint16_t quantize(double unit) {
+    return (uint16_t)floor(fmin(fmax(unit, 0), 1) * CHART_QUANT + 0.5);
+}
+
+void encodeChartGeometry(const ChartGeometry& g, double tolerance, std::vector<uint8_t>& out) {
+    out.clear();
+    for (int i = 0; i < 4; i++) {
+        out.push_back((uint8_t)CHART_MAGIC[i]);
+    }
+    putU16(out, CHART_VERSION);
+    putU16(out, CHART_FAMILIES);
+    putF32(out, g.config.totalPressure);
+    putF32(out, g.config.maxTemp);
+    putF32(out, g.config.maxW);
+    putF32(out, g.maxPv);
+    putF32(out, g.tempAtCutoff);
+    putF32(out, g.upperLeftBorderTemp);
+    putF32(out, g.bottomLeftBorderPv);
+
+    double tempSpan = g.config.maxTemp - CHART_MIN_TEMP;
+    std::vector<ChartPoint> scaled;
+    std::vector<bool> keep;
+    for (int f = 0; f < CHART_FAMILIES; f++) {
+        putU32(out, (uint32_t)g.families[f].size());
+        for (const ChartLine& l : g.families[f]) {
+            // Clamped into the domain first, as the chart clips pv at maxPv
+            scaled.resize(l.points.size());
+            for (size_t i = 0; i < l.points.size(); i++) {
+                scaled[i].temp = fmin(fmax((l.points[i].temp - CHART_MIN_TEMP) / tempSpan, 0), 1);
+                scaled[i].pv = fmin(fmax(l.points[i].pv / g.maxPv, 0), 1);
+            }
+            simplify(scaled, tolerance, keep);
+
+            uint32_t count = 0;
+            for (size_t i = 0; i < keep.size(); i++) {
+                count += keep[i];
+            }
+            putF32(out, l.value);
+            putF32(out, l.labelTemp);
+            putF32(out, l.labelPv);
+            putF32(out, l.labelSlope);
+            putU32(out, count);
+            for (size_t i = 0; i < scaled.size(); i++) {
+                if (keep[i]) {
+                    putU16(out, quantize(scaled[i].temp));
+                    putU16(out, quantize(scaled[i].pv));
+                }
+            }
+        }
+    }
+}
+
+uint64_t chartContentHash(const std::vector<uint8_t>& data) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < data.size(); i++) {
+        hash = (hash ^ data[i]) * 1099511628211ULL;
+    }
+    return hash;
+}
@@ -0,0 +1,201 @@
+#include "HistoryQuery.h"
+#include <math.h>
+#include <stdio.h>
+#include <time.h>
+
+#define DRY_BULB 0
+#define WET_BULB 1
+
+// Printed precision of each rollupFields column
+static const int fieldDecimals[ROLLUP_FIELDS] = { 2, 2, 2, 2, 5, 2, 3, 2 };
+
+HistoryQuery::HistoryQuery() : db(0), rawCount(0), sourceTier(HISTORY_TIER_RAW) {
+    for (uint8_t i = 0; i <= ROLLUP_TIERS; i++) {
+        select[i] = 0;
+    }
+}
+
+HistoryQuery::~HistoryQuery() {
+    close();
+}
+
+bool HistoryQuery::open(const char* path) {
+    if (sqlite3_open_v2(path, &db, SQLITE_OPEN_READONLY, 0) != SQLITE_OK) {
+        return false;
+    }
+    sqlite3_busy_timeout(db, 5000);
+
+    // Raw row count in a window, estimated from the 1 min tier's counts
+    if (sqlite3_prepare_v3(db, "SELECT coalesce(sum(count), 0) FROM rollup_1m WHERE channel = ? AND ts >= ? AND ts < ?",
+                           -1, SQLITE_PREPARE_PERSISTENT, &rawCount, 0) != SQLITE_OK) {
+        return false;
+    }
+
+    char sql[1024];
+    for (int i = 0; i <= ROLLUP_TIERS; i++) {
+        const char* table = i == 0 ? "samples" : rollupTables[i - 1];
+        long long offset = i == 0 ? 0 : rollupWidthMs[i - 1] / 2;
+        int length = snprintf(sql, sizeof(sql), "SELECT ts + %lld", offset);
+        for (uint8_t field = 0; field < ROLLUP_FIELDS; field++) {
+            length += snprintf(sql + length, sizeof(sql) - length, ", %s", rollupFields[field]);
+        }
+        snprintf(sql + length, sizeof(sql) - length, " FROM %s WHERE channel = ? AND ts >= ? AND ts < ? ORDER BY ts",
+                 table);
+        if (sqlite3_prepare_v3(db, sql, -1, SQLITE_PREPARE_PERSISTENT, &select[i], 0) != SQLITE_OK) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void HistoryQuery::close() {
+    sqlite3_finalize(rawCount);
+    rawCount = 0;
+    for (uint8_t i = 0; i <= ROLLUP_TIERS; i++) {
+        sqlite3_finalize(select[i]);
+        select[i] = 0;
+    }
+    if (db) {
+        sqlite3_close(db);
+        db = 0;
+    }
+}
+
+const char* HistoryQuery::error() const {
+    return db ? sqlite3_errmsg(db) : "database not open";
+}
+
+bool HistoryQuery::query(uint8_t channel, int64_t from, int64_t to, size_t maxPoints,
+                         std::vector<HistoryPoint>& out) {
+    if (maxPoints < 2) {
+        maxPoints = 2;
+    } else if (maxPoints > HISTORY_MAX_POINTS) {
+        maxPoints = HISTORY_MAX_POINTS;
+    }
+    sourceTier = chooseTier(channel, from, to, maxPoints);
+
+    // Buckets are selected by start time, so widen the window to the one that holds from
+    int64_t start = sourceTier == HISTORY_TIER_RAW ? from : from - from % rollupWidthMs[sourceTier];
+    sqlite3_stmt* statement = select[sourceTier + 1];
+    sqlite3_bind_int(statement, 1, channel);
+    sqlite3_bind_int64(statement, 2, start);
+    sqlite3_bind_int64(statement, 3, to);
+
+    source.clear();
+    int result;
+    while ((result = sqlite3_step(statement)) == SQLITE_ROW) {
+        HistoryPoint point;
+        point.timestamp = sqlite3_column_int64(statement, 0);
+        for (uint8_t field = 0; field < ROLLUP_FIELDS; field++) {
+            // NULL: a non-finite value, or a bucket without a finite one
+            point.values[field] = sqlite3_column_type(statement, 1 + field) == SQLITE_NULL
+                ? NAN : sqlite3_column_double(statement, 1 + field);
+        }
+        source.push_back(point);
+    }
+    sqlite3_reset(statement);
+    if (result != SQLITE_DONE) {
+        return false;
+    }
+
+    historyDownsample(source, maxPoints, out);
+    return true;
+}
+
+int HistoryQuery::chooseTier(uint8_t channel, int64_t from, int64_t to, size_t maxPoints) {
+    int64_t budget = (int64_t)(maxPoints * HISTORY_SOURCE_FACTOR);
+
+    sqlite3_bind_int(rawCount, 1, channel);
+    sqlite3_bind_int64(rawCount, 2, from - from % rollupWidthMs[1]);
+    sqlite3_bind_int64(rawCount, 3, to);
+    int64_t rows = sqlite3_step(rawCount) == SQLITE_ROW ? sqlite3_column_int64(rawCount, 0) : 0;
+    sqlite3_reset(rawCount);
+    if (rows <= budget) {
+        return HISTORY_TIER_RAW;
+    }
+
+    for (int tier = 0; tier < ROLLUP_TIERS - 1; tier++) {
+        if ((to - from) / rollupWidthMs[tier] <= budget) {
+            return tier;
+        }
+    }
+    return ROLLUP_TIERS - 1;
+}
+
+void historyDownsample(const std::vector<HistoryPoint>& in, size_t maxPoints, std::vector<HistoryPoint>& out) {
+    out.clear();
+    size_t count = in.size();
+    if (count <= maxPoints || maxPoints < 3) {
+        out = in;
+        return;
+    }
+    out.reserve(maxPoints);
+    out.push_back(in[0]);
+
+    // Interior points fall into maxPoints - 2 buckets of equal width
+    double width = (double)(count - 2) / (maxPoints - 2);
+    size_t previous = 0;
+    for (size_t bucket = 0; bucket < maxPoints - 2; bucket++) {
+        size_t first = (size_t)(bucket * width) + 1;
+        size_t last = (size_t)((bucket + 1) * width) + 1;
+        size_t nextFirst = last;
+        size_t nextLast = (size_t)((bucket + 2) * width) + 1;
+        if (nextLast > count) {
+            nextLast = count;
+        }
+
+        // The third corner is the mean of the next bucket (the last point for the final bucket)
+        double nextTime = 0, nextDry = 0, nextWet = 0;
+        for (size_t i = nextFirst; i < nextLast; i++) {
+            nextTime += in[i].timestamp;
+            nextDry += in[i].values[DRY_BULB];
+            nextWet += in[i].values[WET_BULB];
+        }
+        size_t nextCount = nextLast - nextFirst;
+        nextTime /= nextCount;
+        nextDry /= nextCount;
+        nextWet /= nextCount;
+
+        const HistoryPoint& a = in[previous];
+        double bestArea = -1;
+        size_t best = first;
+        for (size_t i = first; i < last; i++) {
+            double dt = (double)(a.timestamp - in[i].timestamp);
+            double dtNext = nextTime - a.timestamp;
+            double area = fabs(dt * (nextDry - a.values[DRY_BULB]) - dtNext * (a.values[DRY_BULB] - in[i].values[DRY_BULB]))
+                        + fabs(dt * (nextWet - a.values[WET_BULB]) - dtNext * (a.values[WET_BULB] - in[i].values[WET_BULB]));
+            if (area > bestArea) {
+                bestArea = area;
+                best = i;
+            }
+        }
+        out.push_back(in[best]);
+        previous = best;
+    }
+    out.push_back(in[count - 1]);
+}
+
+size_t historyFormatPoint(const HistoryPoint& point, char* out, size_t size) {
+    time_t seconds = (time_t)(point.timestamp / 1000);
+    struct tm utc;
+    gmtime_r(&seconds, &utc);
+    char timestamp[32];
+    size_t length = strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%S", &utc);
+    snprintf(timestamp + length, sizeof(timestamp) - length, ".%03dZ", (int)(point.timestamp % 1000));
+
+    // JSON has no NaN; a missing value is null, as db.js returns NULL columns.
+    // A failed snprintf counts as filling the buffer.
+    int written = snprintf(out, size, "{\"timestamp\":\"%s\"", timestamp);
+    size_t used = written > 0 ? (size_t)written : size;
+    for (uint8_t field = 0; field < ROLLUP_FIELDS && used < size; field++) {
+        double value = point.values[field];
+        written = isfinite(value)
+            ? snprintf(out + used, size - used, ",\"%s\":%.*f", rollupFields[field], fieldDecimals[field], value)
+            : snprintf(out + used, size - used, ",\"%s\":null", rollupFields[field]);
+        used += written > 0 ? (size_t)written : size;
+    }
+    if (used < size) {
+        used += (size_t)snprintf(out + used, size - used, "}");
+    }
+    return used < size ? used : 0;
+}
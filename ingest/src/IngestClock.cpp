@@ -0,0 +1,18 @@
+#include "IngestClock.h"
+#include <time.h>
+
+int64_t ingestWallClockMs() {
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    return (int64_t)now.tv_sec * 1000 + now.tv_nsec / 1000000;
+}
+
+int64_t ingestMonotonicMs() {
+    return ingestMonotonicUs() / 1000;
+}
+
+int64_t ingestMonotonicUs() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (int64_t)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
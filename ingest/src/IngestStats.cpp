@@ -0,0 +1,37 @@
+#include "IngestStats.h"
+#include <string.h>
+
+LatencyHistogram::LatencyHistogram() {
+    reset();
+}
+
+void LatencyHistogram::add(int64_t micros) {
+    uint8_t bucket = 0;
+    while (bucket < LATENCY_BUCKETS - 1 && ((int64_t)1 << bucket) <= micros) {
+        bucket++;
+    }
+    buckets[bucket]++;
+    total++;
+    if (micros > maxMicros) {
+        maxMicros = micros;
+    }
+}
+
+void LatencyHistogram::reset() {
+    memset(buckets, 0, sizeof(buckets));
+    total = 0;
+    maxMicros = 0;
+}
+
+int64_t LatencyHistogram::quantile(double q) const {
+    uint64_t target = (uint64_t)(q * total);
+    uint64_t seen = 0;
+    for (uint8_t bucket = 0; bucket < LATENCY_BUCKETS; bucket++) {
+        seen += buckets[bucket];
+        if (seen > target) {
+            int64_t upper = (int64_t)1 << bucket;
+            return upper < maxMicros ? upper : maxMicros;
+        }
+    }
+    return maxMicros;
+}
@@ -0,0 +1,297 @@
+#include "RollupStore.h"
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#define SQL_MAX 8192
+
+const int64_t rollupWidthMs[ROLLUP_TIERS] = { 10000, 60000, 600000 };
+const char* const rollupTables[ROLLUP_TIERS] = { "rollup_10s", "rollup_1m", "rollup_10m" };
+const char* const rollupFields[ROLLUP_FIELDS] = {
+    "dry_bulb", "wet_bulb", "relative_humidity", "dew_point",
+    "absolute_humidity", "partial_pressure", "specific_volume", "enthalpy",
+};
+
+void rollupValues(const PsychroState& state, double values[ROLLUP_FIELDS]) {
+    values[0] = state.dryBulbTemp;
+    values[1] = state.wetBulbTemp;
+    values[2] = state.relativeHumidity * 100;
+    values[3] = state.dewPoint;
+    values[4] = state.absoluteHumidity;
+    values[5] = state.partialPressure;
+    values[6] = state.specificVolume;
+    values[7] = state.enthalpy;
+}
+
+// Appends printf-style text to a fixed buffer; the caller checks for truncation
+static void append(char* sql, size_t& length, const char* format, ...) __attribute__((format(printf, 3, 4)));
+
+static void append(char* sql, size_t& length, const char* format, ...) {
+    if (length >= SQL_MAX) {
+        return;
+    }
+    va_list args;
+    va_start(args, format);
+    int written = vsnprintf(sql + length, SQL_MAX - length, format, args);
+    va_end(args);
+    length = written < 0 ? SQL_MAX : length + (size_t)written;
+}
+
+RollupStore::RollupStore() : upserts(0), db(0) {
+    memset(upsert, 0, sizeof(upsert));
+    for (uint8_t channel = 0; channel < PSYCHRO_FRAME_MAX_CHANNELS; channel++) {
+        for (uint8_t tier = 0; tier < ROLLUP_TIERS; tier++) {
+            clear(buckets[channel][tier], -1);
+        }
+    }
+}
+
+RollupStore::~RollupStore() {
+    close();
+}
+
+bool RollupStore::open(sqlite3* db) {
+    this->db = db;
+    for (uint8_t tier = 0; tier < ROLLUP_TIERS; tier++) {
+        if (!createTier(tier)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void RollupStore::close() {
+    for (uint8_t tier = 0; tier < ROLLUP_TIERS; tier++) {
+        sqlite3_finalize(upsert[tier]);
+        upsert[tier] = 0;
+    }
+    db = 0;
+}
+
+bool RollupStore::add(const IngestSample& sample) {
+    if (sample.channel >= PSYCHRO_FRAME_MAX_CHANNELS) {
+        return true;
+    }
+    double values[ROLLUP_FIELDS];
+    rollupValues(sample.state, values);
+
+    for (uint8_t tier = 0; tier < ROLLUP_TIERS; tier++) {
+        Bucket& bucket = buckets[sample.channel][tier];
+        int64_t start = sample.timestamp - sample.timestamp % rollupWidthMs[tier];
+
+        if (start < bucket.start) {
+            // Replayed from the device log: merge it into its old bucket directly
+            Bucket late;
+            clear(late, start);
+            accumulate(late, values);
+            if (!write(tier, sample.channel, late)) {
+                return false;
+            }
+            continue;
+        }
+        if (start > bucket.start) {
+            if (bucket.count > 0 && !write(tier, sample.channel, bucket)) {
+                return false;
+            }
+            clear(bucket, start);
+        }
+        accumulate(bucket, values);
+    }
+    return true;
+}
+
+bool RollupStore::flush() {
+    for (uint8_t channel = 0; channel < PSYCHRO_FRAME_MAX_CHANNELS; channel++) {
+        for (uint8_t tier = 0; tier < ROLLUP_TIERS; tier++) {
+            Bucket& bucket = buckets[channel][tier];
+            if (bucket.count == 0) {
+                continue;
+            }
+            if (!write(tier, channel, bucket)) {
+                return false;
+            }
+            clear(bucket, bucket.start);
+        }
+    }
+    return true;
+}
+
+void RollupStore::discard() {
+    for (uint8_t channel = 0; channel < PSYCHRO_FRAME_MAX_CHANNELS; channel++) {
+        for (uint8_t tier = 0; tier < ROLLUP_TIERS; tier++) {
+            clear(buckets[channel][tier], buckets[channel][tier].start);
+        }
+    }
+}
+
+// Merge of an incoming row (excluded) into the stored one. SET expressions
+// see the row before the update, so the counts are the old counts; SQLite's
+// min() and max() are NULL if either side is.
+static void appendMerge(char* sql, size_t& length) {
+    append(sql, length, " ON CONFLICT (channel, ts) DO UPDATE SET count = count + excluded.count");
+    for (uint8_t field = 0; field < ROLLUP_FIELDS; field++) {
+        const char* name = rollupFields[field];
+        append(sql, length, ", %s = CASE WHEN %s_count + excluded.%s_count > 0"
+               " THEN (coalesce(%s * %s_count, 0) + coalesce(excluded.%s * excluded.%s_count, 0))"
+               " / (%s_count + excluded.%s_count) END",
+               name, name, name, name, name, name, name, name, name);
+        append(sql, length, ", %s_min = coalesce(min(%s_min, excluded.%s_min), %s_min, excluded.%s_min)",
+               name, name, name, name, name);
+        append(sql, length, ", %s_max = coalesce(max(%s_max, excluded.%s_max), %s_max, excluded.%s_max)",
+               name, name, name, name, name);
+        append(sql, length, ", %s_count = %s_count + excluded.%s_count", name, name, name);
+    }
+}
+
+bool RollupStore::createTier(uint8_t tier) {
+    const char* table = rollupTables[tier];
+    char sql[SQL_MAX];
+    size_t length = 0;
+
+    // Tiers from before the per-field counts are derived data: rebuild them
+    append(sql, length, "SELECT %s_count FROM %s LIMIT 0", rollupFields[0], table);
+    sqlite3_stmt* probe;
+    if (sqlite3_prepare_v2(db, sql, -1, &probe, 0) == SQLITE_OK) {
+        sqlite3_finalize(probe);
+    } else {
+        length = 0;
+        append(sql, length, "DROP TABLE IF EXISTS %s", table);
+        if (sqlite3_exec(db, sql, 0, 0, 0) != SQLITE_OK) {
+            return false;
+        }
+    }
+
+    length = 0;
+    append(sql, length, "CREATE TABLE IF NOT EXISTS %s (channel INTEGER NOT NULL, ts INTEGER NOT NULL,"
+           " count INTEGER NOT NULL", table);
+    for (uint8_t field = 0; field < ROLLUP_FIELDS; field++) {
+        const char* name = rollupFields[field];
+        append(sql, length, ", %s REAL, %s_min REAL, %s_max REAL, %s_count INTEGER NOT NULL",
+               name, name, name, name);
+    }
+    append(sql, length, ", PRIMARY KEY (channel, ts)) WITHOUT ROWID");
+    if (length >= SQL_MAX || sqlite3_exec(db, sql, 0, 0, 0) != SQLITE_OK) {
+        return false;
+    }
+
+    // First open on a database that already has samples: build the tier from them
+    sqlite3_stmt* empty;
+    length = 0;
+    append(sql, length, "SELECT NOT EXISTS (SELECT 1 FROM %s) AND EXISTS (SELECT 1 FROM samples)", table);
+    if (sqlite3_prepare_v2(db, sql, -1, &empty, 0) != SQLITE_OK) {
+        return false;
+    }
+    bool rebuild = sqlite3_step(empty) == SQLITE_ROW && sqlite3_column_int(empty, 0);
+    sqlite3_finalize(empty);
+    if (rebuild && !rollUpTier(tier, INT64_MIN, INT64_MAX)) {
+        return false;
+    }
+
+    length = 0;
+    append(sql, length, "INSERT INTO %s (channel, ts, count", table);
+    for (uint8_t field = 0; field < ROLLUP_FIELDS; field++) {
+        const char* name = rollupFields[field];
+        append(sql, length, ", %s, %s_min, %s_max, %s_count", name, name, name, name);
+    }
+    append(sql, length, ") VALUES (?, ?, ?");
+    for (uint8_t field = 0; field < ROLLUP_FIELDS; field++) {
+        append(sql, length, ", ?, ?, ?, ?");
+    }
+    append(sql, length, ")");
+    appendMerge(sql, length);
+    if (length >= SQL_MAX) {
+        return false;
+    }
+    return sqlite3_prepare_v3(db, sql, -1, SQLITE_PREPARE_PERSISTENT, &upsert[tier], 0) == SQLITE_OK;
+}
+
+bool RollupStore::rollUp(int64_t from, int64_t to) {
+    for (uint8_t tier = 0; tier < ROLLUP_TIERS; tier++) {
+        if (!rollUpTier(tier, from, to)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// The same buckets add() builds, by GROUP BY over the samples table; the
+// inner SELECT turns infinities into NULL, which the aggregates skip
+bool RollupStore::rollUpTier(uint8_t tier, int64_t from, int64_t to) {
+    long long width = (long long)rollupWidthMs[tier];
+    char sql[SQL_MAX];
+    size_t length = 0;
+
+    append(sql, length, "INSERT INTO %s (channel, ts, count", rollupTables[tier]);
+    for (uint8_t field = 0; field < ROLLUP_FIELDS; field++) {
+        const char* name = rollupFields[field];
+        append(sql, length, ", %s, %s_min, %s_max, %s_count", name, name, name, name);
+    }
+    append(sql, length, ") SELECT channel, ts - ts %% %lld, count(*)", width);
+    for (uint8_t field = 0; field < ROLLUP_FIELDS; field++) {
+        const char* name = rollupFields[field];
+        append(sql, length, ", avg(%s), min(%s), max(%s), count(%s)", name, name, name, name);
+    }
+    append(sql, length, " FROM (SELECT channel, ts");
+    for (uint8_t field = 0; field < ROLLUP_FIELDS; field++) {
+        const char* name = rollupFields[field];
+        append(sql, length, ", CASE WHEN abs(%s) <= 1.7976931348623157e308 THEN %s END AS %s", name, name, name);
+    }
+    append(sql, length, " FROM samples WHERE ts >= %lld AND ts < %lld)", (long long)from, (long long)to);
+    append(sql, length, " WHERE true GROUP BY channel, ts - ts %% %lld", width);
+    appendMerge(sql, length);
+    return length < SQL_MAX && sqlite3_exec(db, sql, 0, 0, 0) == SQLITE_OK;
+}
+
+bool RollupStore::write(uint8_t tier, uint8_t channel, const Bucket& bucket) {
+    sqlite3_stmt* statement = upsert[tier];
+    sqlite3_bind_int(statement, 1, channel);
+    sqlite3_bind_int64(statement, 2, bucket.start);
+    sqlite3_bind_int(statement, 3, (int)bucket.count);
+    for (uint8_t field = 0; field < ROLLUP_FIELDS; field++) {
+        int column = 4 + field * 4;
+        if (bucket.valid[field] > 0) {
+            sqlite3_bind_double(statement, column, bucket.sum[field] / bucket.valid[field]);
+            sqlite3_bind_double(statement, column + 1, bucket.min[field]);
+            sqlite3_bind_double(statement, column + 2, bucket.max[field]);
+        } else {
+            sqlite3_bind_null(statement, column);
+            sqlite3_bind_null(statement, column + 1);
+            sqlite3_bind_null(statement, column + 2);
+        }
+        sqlite3_bind_int(statement, column + 3, (int)bucket.valid[field]);
+    }
+    int result = sqlite3_step(statement);
+    sqlite3_reset(statement);
+    upserts++;
+    return result == SQLITE_DONE;
+}
+
+void RollupStore::clear(Bucket& bucket, int64_t start) {
+    bucket.start = start;
+    bucket.count = 0;
+    memset(bucket.valid, 0, sizeof(bucket.valid));
+}
+
+void RollupStore::accumulate(Bucket& bucket, const double values[ROLLUP_FIELDS]) {
+    for (uint8_t field = 0; field < ROLLUP_FIELDS; field++) {
+        double value = values[field];
+        if (!isfinite(value)) {
+            continue;
+        }
+        if (bucket.valid[field]++ == 0) {
+            bucket.sum[field] = value;
+            bucket.min[field] = value;
+            bucket.max[field] = value;
+            continue;
+        }
+        bucket.sum[field] += value;
+        if (value < bucket.min[field]) {
+            bucket.min[field] = value;
+        }
+        if (value > bucket.max[field]) {
+            bucket.max[field] = value;
+        }
+    }
+    bucket.count++;
+}
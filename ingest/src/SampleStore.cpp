@@ -0,0 +1,222 @@
+#include "SampleStore.h"
+#include "IngestClock.h"
+#include <stdio.h>
+
+static const char* const SCHEMA =
+    "CREATE TABLE IF NOT EXISTS samples ("
+    " ts INTEGER NOT NULL,"  // UTC epoch ms
+    " channel INTEGER NOT NULL DEFAULT 0,"
+    " seq INTEGER,"          // Device seq, NULL for CSV input
+    " dry_bulb REAL,"
+    " wet_bulb REAL,"
+    " relative_humidity REAL,"
+    " dew_point REAL,"
+    " absolute_humidity REAL,"
+    " partial_pressure REAL,"
+    " specific_volume REAL,"
+    " enthalpy REAL"
+    ");"
+    "CREATE INDEX IF NOT EXISTS samples_channel_ts ON samples (channel, ts);";
+
+// webapp/db.js's own table, in local time at one-second resolution. What it
+// holds from before the first sample is copied over once, as channel 0, so
+// history and the rollup tiers reach back past the switch to ingest. Later
+// opens find nothing older than the first sample and copy nothing.
+static const char* const IMPORT_MEASUREMENTS =
+    "INSERT INTO samples (ts, channel, dry_bulb, wet_bulb, relative_humidity, dew_point,"
+    " absolute_humidity, partial_pressure, specific_volume, enthalpy)"
+    " SELECT ts, 0, dry_bulb, wet_bulb, relative_humidity, dew_point,"
+    " absolute_humidity, partial_pressure, specific_volume, enthalpy"
+    " FROM (SELECT strftime('%s', timestamp, 'utc') * 1000 AS ts, * FROM measurements)"
+    " WHERE ts < ?"
+    " ORDER BY ts";
+
+static const char* const INSERT =
+    "INSERT INTO samples (ts, channel, seq, dry_bulb, wet_bulb, relative_humidity, dew_point,"
+    " absolute_humidity, partial_pressure, specific_volume, enthalpy)"
+    " VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)";
+
+SampleStore::SampleStore()
+    : rows(0), rowsLost(0), commits(0), db(0), insert(0), begin(0), end(0), batchSize(1), commitIntervalMs(0),
+      pending(0), batchStartUs(0) {
+    failure[0] = '\0';
+}
+
+SampleStore::~SampleStore() {
+    close();
+}
+
+bool SampleStore::open(const char* path, size_t batchSize, int64_t commitIntervalMs) {
+    this->batchSize = batchSize > 0 ? batchSize : 1;
+    this->commitIntervalMs = commitIntervalMs;
+
+    if (sqlite3_open(path, &db) != SQLITE_OK) {
+        return false;
+    }
+    // The Node server holds the database too; wait out its short locks
+    sqlite3_busy_timeout(db, 5000);
+
+    if (!exec("PRAGMA journal_mode=WAL") || !exec("PRAGMA synchronous=NORMAL") || !exec(SCHEMA)
+        || !rollups.open(db) || !importMeasurements()) {
+        return false;
+    }
+    return sqlite3_prepare_v3(db, INSERT, -1, SQLITE_PREPARE_PERSISTENT, &insert, 0) == SQLITE_OK
+        && sqlite3_prepare_v3(db, "BEGIN", -1, SQLITE_PREPARE_PERSISTENT, &begin, 0) == SQLITE_OK
+        && sqlite3_prepare_v3(db, "COMMIT", -1, SQLITE_PREPARE_PERSISTENT, &end, 0) == SQLITE_OK;
+}
+
+void SampleStore::close() {
+    if (!db) {
+        return;
+    }
+    commit();
+    rollups.close();
+    sqlite3_finalize(insert);
+    sqlite3_finalize(begin);
+    sqlite3_finalize(end);
+    sqlite3_close(db);
+    db = 0;
+    insert = begin = end = 0;
+}
+
+bool SampleStore::add(const IngestSample& sample) {
+    if (pending == 0) {
+        failure[0] = '\0';
+        if (!step(begin)) {
+            return false;
+        }
+        batchStartUs = ingestMonotonicUs();
+    }
+
+    const PsychroState& state = sample.state;
+    sqlite3_bind_int64(insert, 1, sample.timestamp);
+    sqlite3_bind_int(insert, 2, sample.channel);
+    if (sample.seq >= 0) {
+        sqlite3_bind_int(insert, 3, sample.seq);
+    } else {
+        sqlite3_bind_null(insert, 3);
+    }
+    sqlite3_bind_double(insert, 4, state.dryBulbTemp);
+    sqlite3_bind_double(insert, 5, state.wetBulbTemp);
+    sqlite3_bind_double(insert, 6, state.relativeHumidity * 100);
+    sqlite3_bind_double(insert, 7, state.dewPoint);
+    sqlite3_bind_double(insert, 8, state.absoluteHumidity);
+    sqlite3_bind_double(insert, 9, state.partialPressure);
+    sqlite3_bind_double(insert, 10, state.specificVolume);
+    sqlite3_bind_double(insert, 11, state.enthalpy);
+    if (!step(insert) || !rollups.add(sample)) {
+        pending++;  // Lost with the batch
+        rollback();
+        return false;
+    }
+
+    pending++;
+    return pending < batchSize || commit();
+}
+
+bool SampleStore::tick(int64_t monotonicNow) {
+    if (pending == 0 || monotonicNow * 1000 - batchStartUs < commitIntervalMs * 1000) {
+        return true;
+    }
+    return commit();
+}
+
+bool SampleStore::commit() {
+    if (pending == 0) {
+        return true;
+    }
+
+    int64_t start = ingestMonotonicUs();
+    if (!rollups.flush() || !step(end)) {
+        rollback();
+        return false;
+    }
+    int64_t done = ingestMonotonicUs();
+
+    commitTime.add(done - start);
+    rowDelay.add(done - batchStartUs);
+    rows += pending;
+    commits++;
+    pending = 0;
+    return true;
+}
+
+int64_t SampleStore::msUntilCommit(int64_t monotonicNow) const {
+    if (pending == 0) {
+        return -1;
+    }
+    int64_t due = batchStartUs / 1000 + commitIntervalMs - monotonicNow;
+    return due > 0 ? due : 0;
+}
+
+bool SampleStore::importMeasurements() {
+    sqlite3_stmt* statement;
+    if (sqlite3_prepare_v2(db, "SELECT EXISTS (SELECT 1 FROM sqlite_master WHERE type = 'table'"
+                           " AND name = 'measurements'), coalesce((SELECT min(ts) FROM samples), ?)",
+                           -1, &statement, 0) != SQLITE_OK) {
+        return false;
+    }
+    sqlite3_bind_int64(statement, 1, INT64_MAX);
+    bool legacy = false;
+    int64_t firstSample = INT64_MAX;
+    if (sqlite3_step(statement) == SQLITE_ROW) {
+        legacy = sqlite3_column_int(statement, 0);
+        firstSample = sqlite3_column_int64(statement, 1);
+    }
+    sqlite3_finalize(statement);
+    if (!legacy) {
+        return true;
+    }
+
+    if (!exec("BEGIN") || sqlite3_prepare_v2(db, IMPORT_MEASUREMENTS, -1, &statement, 0) != SQLITE_OK) {
+        exec("ROLLBACK");
+        return false;
+    }
+    sqlite3_bind_int64(statement, 1, firstSample);
+    bool copied = sqlite3_step(statement) == SQLITE_DONE;
+    sqlite3_finalize(statement);
+    int imported = copied ? sqlite3_changes(db) : 0;
+    if (!copied || (imported > 0 && !rollups.rollUp(INT64_MIN, firstSample)) || !exec("COMMIT")) {
+        exec("ROLLBACK");
+        return false;
+    }
+    if (imported > 0) {
+        fprintf(stderr, "psychro-ingest: imported %d rows from measurements\n", imported);
+    }
+    return true;
+}
+
+const char* SampleStore::error() const {
+    if (!db) {
+        return "database not open";
+    }
+    return failure[0] ? failure : sqlite3_errmsg(db);
+}
+
+// A statement failed inside the batch: drop the batch rather than leave its
+// transaction open under the next one. SQLite may have rolled back already.
+void SampleStore::rollback() {
+    snprintf(failure, sizeof(failure), "%s", sqlite3_errmsg(db));
+    if (!sqlite3_get_autocommit(db)) {
+        sqlite3_exec(db, "ROLLBACK", 0, 0, 0);
+    }
+    rollups.discard();
+    rowsLost += pending;
+    pending = 0;
+}
+
+bool SampleStore::exec(const char* sql) {
+    char* message = 0;
+    if (sqlite3_exec(db, sql, 0, 0, &message) != SQLITE_OK) {
+        fprintf(stderr, "sqlite: %s\n", message ? message : sqlite3_errmsg(db));
+        sqlite3_free(message);
+        return false;
+    }
+    return true;
+}
+
+bool SampleStore::step(sqlite3_stmt* statement) {
+    int result = sqlite3_step(statement);
+    sqlite3_reset(statement);
+    return result == SQLITE_DONE || result == SQLITE_ROW;
+}
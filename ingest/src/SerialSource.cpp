@@ -0,0 +1,111 @@
+#include "SerialSource.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <termios.h>
+#include <unistd.h>
+
+static speed_t baudConstant(unsigned long baud) {
+    switch (baud) {
+        case 9600: return B9600;
+        case 19200: return B19200;
+        case 38400: return B38400;
+        case 57600: return B57600;
+        case 115200: return B115200;
+        case 230400: return B230400;
+        case 460800: return B460800;
+        case 500000: return B500000;
+        case 1000000: return B1000000;
+        default: return 0;
+    }
+}
+
+SerialSource::SerialSource() : handle(-1), terminal(false), file(false), rate(0) {}
+
+SerialSource::~SerialSource() {
+    close();
+}
+
+bool SerialSource::open(const char* path, unsigned long baud) {
+    // A FIFO is opened read-only: writing to it would loop back into our own reads
+    handle = ::open(path, O_RDONLY | O_NONBLOCK | O_NOCTTY | O_CLOEXEC);
+    if (handle < 0) {
+        return false;
+    }
+
+    struct stat info;
+    file = fstat(handle, &info) == 0 && S_ISREG(info.st_mode);
+    terminal = isatty(handle);
+    if (!terminal) {
+        return true;
+    }
+
+    // Reopen read-write so backfill requests can go back to the board
+    ::close(handle);
+    handle = ::open(path, O_RDWR | O_NONBLOCK | O_NOCTTY | O_CLOEXEC);
+    if (handle < 0) {
+        return false;
+    }
+
+    struct termios options;
+    speed_t speed = baudConstant(baud);
+    if (tcgetattr(handle, &options) < 0 || speed == 0) {
+        close();
+        errno = EINVAL;
+        return false;
+    }
+    cfmakeraw(&options);
+    cfsetispeed(&options, speed);
+    cfsetospeed(&options, speed);
+    options.c_cflag |= CLOCAL | CREAD;
+    if (tcsetattr(handle, TCSANOW, &options) < 0) {
+        close();
+        return false;
+    }
+    rate = baud;
+    return true;
+}
+
+bool SerialSource::setBaud(unsigned long baud) {
+    struct termios options;
+    speed_t speed = baudConstant(baud);
+    if (!terminal || speed == 0 || tcgetattr(handle, &options) < 0) {
+        return false;
+    }
+    cfsetispeed(&options, speed);
+    cfsetospeed(&options, speed);
+    if (tcsetattr(handle, TCSANOW, &options) < 0) {
+        return false;
+    }
+    rate = baud;
+    return true;
+}
+
+bool SerialSource::supportsBaud(unsigned long baud) {
+    return baudConstant(baud) != 0;
+}
+
+void SerialSource::close() {
+    if (handle >= 0) {
+        ::close(handle);
+        handle = -1;
+    }
+}
+
+ssize_t SerialSource::read(uint8_t* buffer, size_t length) {
+    ssize_t count = ::read(handle, buffer, length);
+    if (count >= 0) {
+        return count;
+    }
+    if (errno == EAGAIN || errno == EINTR) {
+        return -1;
+    }
+    return 0;  // EIO from a hung-up pty or unplugged board
+}
+
+bool SerialSource::write(const uint8_t* data, size_t length) {
+    if (!terminal) {
+        return false;
+    }
+    return ::write(handle, data, length) == (ssize_t)length;
+}
@@ -0,0 +1,151 @@
+#include "StatePublisher.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+StatePublisher::StatePublisher() : published(0), dropped(0), listener(-1), clientCount(0) {
+    path[0] = '\0';
+    memset(latestLength, 0, sizeof(latestLength));
+}
+
+StatePublisher::~StatePublisher() {
+    close();
+}
+
+bool StatePublisher::open(const char* path) {
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(address.sun_path)) {
+        errno = ENAMETOOLONG;
+        return false;
+    }
+    strcpy(address.sun_path, path);
+
+    listener = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listener < 0) {
+        return false;
+    }
+    unlink(path);  // Left behind by a previous run
+    if (bind(listener, (struct sockaddr*)&address, sizeof(address)) < 0 || listen(listener, 8) < 0) {
+        ::close(listener);
+        listener = -1;
+        return false;
+    }
+    strcpy(this->path, path);
+    return true;
+}
+
+void StatePublisher::close() {
+    while (clientCount > 0) {
+        ::close(clients[--clientCount]);
+    }
+    if (listener >= 0) {
+        ::close(listener);
+        unlink(path);
+        listener = -1;
+    }
+}
+
+void StatePublisher::acceptClients() {
+    while (true) {
+        int client = accept4(listener, 0, 0, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (client < 0) {
+            return;
+        }
+        if (clientCount == PUBLISHER_MAX_CLIENTS) {
+            ::close(client);
+            continue;
+        }
+
+        bool alive = true;
+        for (uint8_t channel = 0; channel < PSYCHRO_FRAME_MAX_CHANNELS && alive; channel++) {
+            if (latestLength[channel] > 0) {
+                alive = send(client, latest[channel], latestLength[channel]);
+            }
+        }
+        if (alive) {
+            clients[clientCount++] = client;
+        } else {
+            ::close(client);
+        }
+    }
+}
+
+#define PUBLISHED_FIELDS 8
+
+// Names and decimals as webapp/server.js rounds them
+static const char* const publishedFields[PUBLISHED_FIELDS] = {
+    "dryBulb", "wetBulb", "relativeHumidity", "dewPoint",
+    "absoluteHumidity", "partialPressure", "specificVolume", "enthalpy",
+};
+static const int publishedDecimals[PUBLISHED_FIELDS] = { 2, 2, 2, 2, 5, 2, 3, 2 };
+
+// Relative humidity in %. JSON has no NaN, so a value the state could not
+// give (a dew point without vapor, say) is null, as in historyFormatPoint.
+void StatePublisher::publish(const IngestSample& sample) {
+    if (sample.channel >= PSYCHRO_FRAME_MAX_CHANNELS) {
+        return;
+    }
+
+    time_t seconds = (time_t)(sample.timestamp / 1000);
+    struct tm utc;
+    gmtime_r(&seconds, &utc);
+    char timestamp[32];
+    size_t length = strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%S", &utc);
+    snprintf(timestamp + length, sizeof(timestamp) - length, ".%03dZ", (int)(sample.timestamp % 1000));
+
+    const PsychroState& state = sample.state;
+    const float values[PUBLISHED_FIELDS] = {
+        state.dryBulbTemp, state.wetBulbTemp, state.relativeHumidity * 100, state.dewPoint,
+        state.absoluteHumidity, state.partialPressure, state.specificVolume, state.enthalpy,
+    };
+
+    // A failed snprintf counts as filling the buffer
+    char* message = latest[sample.channel];
+    size_t size = PUBLISHER_MESSAGE_MAX;
+    int written = snprintf(message, size, "{\"type\":\"data\",\"source\":\"sensor\",\"channel\":%u,\"seq\":%ld",
+                           sample.channel, (long)sample.seq);
+    size_t used = written > 0 ? (size_t)written : size;
+    for (uint8_t field = 0; field < PUBLISHED_FIELDS && used < size; field++) {
+        written = isfinite(values[field])
+            ? snprintf(message + used, size - used, ",\"%s\":%.*f", publishedFields[field],
+                       publishedDecimals[field], values[field])
+            : snprintf(message + used, size - used, ",\"%s\":null", publishedFields[field]);
+        used += written > 0 ? (size_t)written : size;
+    }
+    if (used < size) {
+        written = snprintf(message + used, size - used, ",\"timestamp\":\"%s\"}\n", timestamp);
+        used += written > 0 ? (size_t)written : size;
+    }
+    if (used >= size) {
+        latestLength[sample.channel] = 0;
+        return;
+    }
+    latestLength[sample.channel] = used;
+
+    for (uint8_t i = clientCount; i-- > 0;) {
+        if (!send(clients[i], message, used)) {
+            drop(i);
+        }
+    }
+    published++;
+}
+
+bool StatePublisher::send(int client, const char* message, size_t length) {
+    // A partial write would leave a broken line on the stream, so it counts as a failure
+    ssize_t sent = ::send(client, message, length, MSG_DONTWAIT | MSG_NOSIGNAL);
+    return sent == (ssize_t)length;
+}
+
+void StatePublisher::drop(uint8_t index) {
+    ::close(clients[index]);
+    clients[index] = clients[--clientCount];
+    dropped++;
+}
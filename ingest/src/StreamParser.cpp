@@ -0,0 +1,371 @@
+#include "StreamParser.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define CSV_FIELDS 8
+
+static int hexDigit(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+// Readings outside what the sensors can report are rejected before they reach the store
+static bool plausible(const PsychroState& state) {
+    return state.dryBulbTemp >= -50 && state.dryBulbTemp <= 100
+        && state.wetBulbTemp >= -50 && state.wetBulbTemp <= 100
+        && state.relativeHumidity >= 0 && state.relativeHumidity <= 1;
+}
+
+StreamParser::StreamParser(Format format)
+    : lines(0), frames(0), skipped(0), invalid(0), duplicates(0), deviceResets(0), telemetry(0),
+      replayTimeouts(0), format(format), lineLength(0), lineOverflow(false), synced(false),
+      lastDeviceTime(0), deviceOffset(0), gap(false), gapFrom(0), lastBackfillAt(0), hole(false),
+      holeFrom(0), liveSinceAck(0), replayRate(0), replayFrames(0), replayActiveAt(0) {}
+
+void StreamParser::push(const uint8_t* data, size_t length, int64_t now, IngestSink& sink) {
+    if (format == FORMAT_CSV) {
+        for (size_t i = 0; i < length; i++) {
+            pushCsv(data[i], now, sink);
+        }
+        return;
+    }
+
+    for (size_t i = 0; i < length; i++) {
+        if (decoder.push(data[i])) {
+            handleFrame(now, sink);
+        }
+    }
+}
+
+bool StreamParser::backfillWanted(uint16_t& fromSeq, int64_t monotonicNow) {
+    if (!gap || (lastBackfillAt != 0 && monotonicNow - lastBackfillAt < STREAM_BACKFILL_RETRY_MS)) {
+        return false;
+    }
+    gap = false;
+    lastBackfillAt = monotonicNow;
+    fromSeq = gapFrom;
+    return true;
+}
+
+bool StreamParser::ackWanted(uint16_t& nextSeq) {
+    if (!synced || liveSinceAck < STREAM_ACK_INTERVAL) {
+        return false;
+    }
+    liveSinceAck = 0;
+    nextSeq = hole ? holeFrom : (uint16_t)(seqs.newest() + 1);
+    return true;
+}
+
+bool StreamParser::replayTimedOut(int64_t monotonicNow) {
+    if (replayRate == 0) {
+        return false;
+    }
+    if (replayActiveAt == 0 || decoder.frames != replayFrames) {
+        replayFrames = decoder.frames;
+        replayActiveAt = monotonicNow;
+        return false;
+    }
+    if (monotonicNow - replayActiveAt < STREAM_REPLAY_TIMEOUT_MS) {
+        return false;
+    }
+    // The device still holds everything from the hole on, since the acks
+    // stopped there
+    replayRate = 0;
+    if (hole) {
+        gap = true;
+        gapFrom = holeFrom;
+    }
+    replayTimeouts++;
+    return true;
+}
+
+void StreamParser::reset() {
+    lineLength = 0;
+    lineOverflow = false;
+    decoder.reset();
+    seqs.reset();
+    synced = false;
+    gap = false;
+    hole = false;
+    liveSinceAck = 0;
+    replayRate = 0;
+}
+
+void StreamParser::pushCsv(uint8_t byte, int64_t now, IngestSink& sink) {
+    if (byte == '\n') {
+        if (!lineOverflow) {
+            line[lineLength] = '\0';
+            parseLine(now, sink);
+        } else {
+            skipped++;
+        }
+        lineLength = 0;
+        lineOverflow = false;
+    } else if (lineLength < STREAM_LINE_MAX - 1) {
+        line[lineLength++] = (char)byte;
+    } else {
+        lineOverflow = true;
+    }
+}
+
+// Same rules as webapp/server.js: exactly 8 numeric fields, temperatures in
+// -50..100 °C and RH in 0..1; anything else is debug output
+void StreamParser::parseLine(int64_t now, IngestSink& sink) {
+    while (lineLength > 0 && (line[lineLength - 1] == '\r' || line[lineLength - 1] == ' ')) {
+        line[--lineLength] = '\0';
+    }
+    if (lineLength == 0) {
+        return;
+    }
+    if (line[0] == '#') {
+        parseHexFrame(now, sink);
+        return;
+    }
+
+    float fields[CSV_FIELDS];
+    uint8_t count = 0;
+    const char* cursor = line;
+    while (count < CSV_FIELDS) {
+        char* end;
+        fields[count] = strtof(cursor, &end);
+        if (end == cursor) {
+            break;
+        }
+        count++;
+        cursor = end;
+        if (*cursor != ',') {
+            break;
+        }
+        cursor++;
+    }
+    if (count != CSV_FIELDS || *cursor != '\0') {
+        skipped++;
+        return;
+    }
+
+    IngestSample sample;
+    sample.timestamp = now;
+    sample.seq = -1;
+    sample.channel = 0;
+    sample.live = true;
+    memset(&sample.state, 0, sizeof(sample.state));
+    sample.state.dryBulbTemp = fields[0];
+    sample.state.wetBulbTemp = fields[1];
+    sample.state.relativeHumidity = fields[2];
+    sample.state.dewPoint = fields[3];
+    sample.state.absoluteHumidity = fields[4];
+    sample.state.partialPressure = fields[5];
+    sample.state.specificVolume = fields[6];
+    sample.state.enthalpy = fields[7];
+    sample.state.dewPointConverged = true;
+
+    if (!plausible(sample.state)) {
+        invalid++;
+        return;
+    }
+
+    lines++;
+    sink.onSample(sample);
+}
+
+// '#' and a frame's type | body | crc16 in hex, as the firmware's CSV mode
+// sends telemetry
+void StreamParser::parseHexFrame(int64_t now, IngestSink& sink) {
+    uint8_t frame[PSYCHRO_FRAME_MAX];
+    size_t digits = lineLength - 1;
+    size_t length = digits / 2;
+    if (digits % 2 != 0 || length < 3 || length > sizeof(frame)) {
+        skipped++;
+        return;
+    }
+    for (size_t i = 0; i < length; i++) {
+        int high = hexDigit(line[1 + 2 * i]);
+        int low = hexDigit(line[2 + 2 * i]);
+        if (high < 0 || low < 0) {
+            skipped++;
+            return;
+        }
+        frame[i] = (uint8_t)(high << 4 | low);
+    }
+    uint16_t crc = psychroCrc16(frame, length - 2);
+    if ((frame[length - 2] | (frame[length - 1] << 8)) != crc) {
+        invalid++;
+        return;
+    }
+    if (frame[0] != FRAME_TELEMETRY && frame[0] != FRAME_TELEMETRY_SPAN) {
+        skipped++;
+        return;
+    }
+    handleTelemetry(frame[0], frame + 1, length - 3, now, sink);
+}
+
+void StreamParser::handleFrame(int64_t now, IngestSink& sink) {
+    switch (decoder.type()) {
+        case FRAME_STATE: {
+            PsychroStateFrame frame;
+            if (!decoder.read(frame)) {
+                invalid++;
+                return;
+            }
+            if (!acceptSeq(frame.header, true, now)) {
+                return;
+            }
+            // Only dry and wet bulb are measured; the rest is recomputed at full precision
+            emit(sink, frame.header, true, 0, frame.dryBulbTemp / PSYCHRO_SCALE_TEMP,
+                 frame.wetBulbTemp / PSYCHRO_SCALE_TEMP, now);
+            break;
+        }
+        case FRAME_MULTI_STATE: {
+            PsychroMultiStateFrame frame;
+            size_t length = decoder.bodyLength();
+            if (length < PSYCHRO_MULTI_STATE_SIZE(0) || length > sizeof(frame)) {
+                invalid++;
+                return;
+            }
+            memcpy(&frame, decoder.body(), length);
+            if (frame.count > PSYCHRO_FRAME_MAX_CHANNELS || length != PSYCHRO_MULTI_STATE_SIZE(frame.count)) {
+                invalid++;
+                return;
+            }
+            if (!acceptSeq(frame.header, true, now)) {
+                return;
+            }
+            for (uint8_t channel = 0; channel < frame.count; channel++) {
+                const PsychroChannelState& state = frame.channels[channel];
+                if (state.dryBulbTemp == PSYCHRO_TEMP_DISCONNECTED || state.wetBulbTemp == PSYCHRO_TEMP_DISCONNECTED) {
+                    continue;
+                }
+                emit(sink, frame.header, true, channel, state.dryBulbTemp / PSYCHRO_SCALE_TEMP,
+                     state.wetBulbTemp / PSYCHRO_SCALE_TEMP, now);
+            }
+            break;
+        }
+        case FRAME_RAW_SAMPLE: {
+            PsychroRawSampleFrame frame;
+            if (!decoder.read(frame)) {
+                invalid++;
+                return;
+            }
+            if (!acceptSeq(frame.header, false, now)) {
+                return;
+            }
+            emit(sink, frame.header, false, 0, frame.dryBulbTemp / PSYCHRO_SCALE_TEMP,
+                 frame.wetBulbTemp / PSYCHRO_SCALE_TEMP, now);
+            break;
+        }
+        case FRAME_BACKFILL_BEGIN: {
+            // Sent at the link rate; the replay and its END follow at begin.baud
+            PsychroBackfillBeginFrame begin;
+            if (!decoder.read(begin)) {
+                invalid++;
+                return;
+            }
+            replayRate = begin.baud;
+            replayActiveAt = 0;
+            skipped++;
+            return;
+        }
+        case FRAME_BACKFILL_END:
+            // The replay sent all the device still had; what it dropped is gone
+            // for good. A gap seen since is still to be asked for. The device
+            // is back at the link rate.
+            hole = gap;
+            holeFrom = gapFrom;
+            replayRate = 0;
+            skipped++;
+            return;
+        case FRAME_TELEMETRY:
+        case FRAME_TELEMETRY_SPAN:
+            handleTelemetry(decoder.type(), decoder.body(), decoder.bodyLength(), now, sink);
+            return;
+        default:
+            // Anything newer than this parser
+            skipped++;
+            return;
+    }
+    frames++;
+}
+
+// Reports carry their own seq and are never replayed, so they bypass the
+// sample seq filter. Device time maps to host time once a live frame has been
+// seen; CSV streams have none and use arrival time.
+void StreamParser::handleTelemetry(uint8_t type, const uint8_t* body, size_t length, int64_t now, IngestSink& sink) {
+    if (type == FRAME_TELEMETRY) {
+        PsychroTelemetryFrame frame;
+        if (length != sizeof(frame)) {
+            invalid++;
+            return;
+        }
+        memcpy(&frame, body, sizeof(frame));
+        sink.onTelemetry(frame, synced ? (int64_t)frame.header.timestamp + deviceOffset : now);
+    } else {
+        PsychroTelemetrySpanFrame frame;
+        if (length != sizeof(frame)) {
+            invalid++;
+            return;
+        }
+        memcpy(&frame, body, sizeof(frame));
+        sink.onTelemetrySpan(frame, synced ? (int64_t)frame.header.timestamp + deviceOffset : now);
+    }
+    telemetry++;
+}
+
+// Live frames move the seq window and the device clock mapping; replayed
+// samples only fill holes behind it
+bool StreamParser::acceptSeq(const PsychroFrameHeader& header, bool live, int64_t now) {
+    if (live) {
+        // A device reset restarts both seq and millis(); start over rather
+        // than rejecting the new seqs as old
+        if (synced && psychroSeqBefore(header.seq, seqs.newest()) && header.timestamp < lastDeviceTime) {
+            seqs.reset();
+            synced = false;
+            gap = false;
+            hole = false;
+            deviceResets++;
+        }
+
+        uint16_t expected = (uint16_t)(seqs.newest() + 1);
+        if (synced && header.seq != expected && psychroSeqBefore(expected, header.seq)) {
+            gap = true;
+            gapFrom = expected;
+            if (!hole) {
+                hole = true;
+                holeFrom = expected;
+            }
+        }
+        synced = true;
+        liveSinceAck++;
+        lastDeviceTime = header.timestamp;
+        deviceOffset = now - (int64_t)header.timestamp;
+    }
+
+    if (!seqs.accept(header.seq)) {
+        duplicates++;
+        return false;
+    }
+    return true;
+}
+
+void StreamParser::emit(IngestSink& sink, const PsychroFrameHeader& header, bool live, uint8_t channel,
+                        float dryBulbTemp, float wetBulbTemp, int64_t now) {
+    // Without a live frame there is no device clock mapping; arrival time is the best guess
+    IngestSample sample;
+    sample.timestamp = synced ? (int64_t)header.timestamp + deviceOffset : now;
+    sample.seq = header.seq;
+    sample.channel = channel;
+    sample.live = live;
+    sample.state = computePsychroState(dryBulbTemp, wetBulbTemp);
+    if (!plausible(sample.state)) {
+        invalid++;
+        return;
+    }
+    sink.onSample(sample);
+}
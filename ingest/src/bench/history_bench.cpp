@@ -0,0 +1,137 @@
+// History benchmark: fills a database with synthetic samples through the
+// ingest path (SampleStore with its rollup tiers), then compares returning
+// every raw row of a window, as webapp/db.js does, with HistoryQuery.
+//
+//   program [--db /tmp/psychro-bench.db] [--rows 5000000] [--hours 24] [--points 1000]
+//
+// The samples are spread evenly over the last --hours hours, so --rows
+// sets the density. Run it at several densities: the raw response grows
+// with --rows, the downsampled one does not.
+
+#include <getopt.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "HistoryQuery.h"
+#include "IngestClock.h"
+#include "SampleStore.h"
+
+#define WINDOWS 4
+
+static const int windowMinutes[WINDOWS] = { 15, 60, 600, 1440 };
+
+static IngestSample synthesize(int64_t timestamp, uint64_t index) {
+    // A drying cycle with a one-hour period and sensor noise
+    double phase = timestamp / 3600000.0 * 2 * M_PI;
+    float noise = ((rand() & 0xFF) - 128) * (0.0625f / 128);
+    IngestSample sample;
+    sample.timestamp = timestamp;
+    sample.seq = (int32_t)(index & 0xFFFF);
+    sample.channel = 0;
+    sample.live = true;
+    sample.state = computePsychroState((float)(30 + 10 * sin(phase)) + noise,
+                                       (float)(22 + 6 * sin(phase - 0.3)) + noise);
+    return sample;
+}
+
+// Bytes the rows would take as the JSON array server.js sends
+static size_t jsonBytes(const std::vector<HistoryPoint>& points) {
+    char row[512];
+    size_t bytes = 2;
+    for (size_t i = 0; i < points.size(); i++) {
+        bytes += historyFormatPoint(points[i], row, sizeof(row)) + 1;
+    }
+    return bytes;
+}
+
+int main(int argc, char** argv) {
+    static const struct option longOptions[] = {
+        { "db", required_argument, 0, 'D' },
+        { "rows", required_argument, 0, 'r' },
+        { "hours", required_argument, 0, 'h' },
+        { "points", required_argument, 0, 'p' },
+        { 0, 0, 0, 0 },
+    };
+    const char* database = "/tmp/psychro-bench.db";
+    uint64_t rows = 5000000;
+    double hours = 24;
+    size_t maxPoints = 1000;
+
+    int option;
+    while ((option = getopt_long(argc, argv, "", longOptions, 0)) != -1) {
+        switch (option) {
+            case 'D': database = optarg; break;
+            case 'r': rows = strtoull(optarg, 0, 10); break;
+            case 'h': hours = atof(optarg); break;
+            case 'p': maxPoints = strtoul(optarg, 0, 10); break;
+            default:
+                fprintf(stderr, "usage: history_bench [--db PATH] [--rows N] [--hours N] [--points N]\n");
+                return 2;
+        }
+    }
+
+    unlink(database);
+    SampleStore store;
+    if (!store.open(database, 4096, 1000)) {
+        fprintf(stderr, "cannot open %s: %s\n", database, store.error());
+        return 1;
+    }
+    int64_t end = ingestWallClockMs();
+    int64_t span = (int64_t)(hours * 3600000);
+    int64_t start = ingestMonotonicUs();
+    for (uint64_t i = 0; i < rows; i++) {
+        if (!store.add(synthesize(end - span + (int64_t)(span * (double)i / rows), i))) {
+            fprintf(stderr, "insert failed: %s\n", store.error());
+            return 1;
+        }
+    }
+    store.close();
+    double seconds = (ingestMonotonicUs() - start) / 1e6;
+    printf("ingest: %llu rows over %.0f h in %.1f s (%.0f rows/s with rollups), commit p99 %.1f ms\n",
+           (unsigned long long)rows, hours, seconds, rows / seconds, store.commitTime.quantile(0.99) / 1000.0);
+
+    HistoryQuery history;
+    if (!history.open(database)) {
+        fprintf(stderr, "cannot open %s: %s\n", database, history.error());
+        return 1;
+    }
+
+    // What webapp/db.js returns without the sidecar: every raw row of the window
+    sqlite3* db;
+    sqlite3_stmt* all;
+    sqlite3_open_v2(database, &db, SQLITE_OPEN_READONLY, 0);
+    sqlite3_prepare_v2(db, "SELECT ts, dry_bulb, wet_bulb, relative_humidity, dew_point, absolute_humidity,"
+                       " partial_pressure, specific_volume, enthalpy FROM samples"
+                       " WHERE channel = 0 AND ts >= ? ORDER BY ts", -1, &all, 0);
+
+    printf("%-9s %-35s %s\n", "window", "all raw rows", "downsampled");
+    std::vector<HistoryPoint> raw, points;
+    for (int w = 0; w < WINDOWS; w++) {
+        int64_t from = end - windowMinutes[w] * 60000LL;
+
+        int64_t t0 = ingestMonotonicUs();
+        raw.clear();
+        sqlite3_bind_int64(all, 1, from);
+        while (sqlite3_step(all) == SQLITE_ROW) {
+            HistoryPoint point;
+            point.timestamp = sqlite3_column_int64(all, 0);
+            for (uint8_t field = 0; field < ROLLUP_FIELDS; field++) {
+                point.values[field] = sqlite3_column_double(all, 1 + field);
+            }
+            raw.push_back(point);
+        }
+        sqlite3_reset(all);
+        int64_t t1 = ingestMonotonicUs();
+        history.query(0, from, end + 1, maxPoints, points);
+        int64_t t2 = ingestMonotonicUs();
+
+        printf("%5d min  %8zu rows %8.1f ms %10zu B   %5zu pts %6.1f ms %7zu B  (%s, %zu source rows)\n",
+               windowMinutes[w], raw.size(), (t1 - t0) / 1000.0, jsonBytes(raw),
+               points.size(), (t2 - t1) / 1000.0, jsonBytes(points),
+               history.tier() == HISTORY_TIER_RAW ? "raw" : rollupTables[history.tier()], history.sourceRows());
+    }
+    sqlite3_finalize(all);
+    sqlite3_close(db);
+    return 0;
+}
@@ -0,0 +1,174 @@
+// psychro-chartgen: writes the psychrometric chart's line geometry for
+// webapp/static/psychrometrics.js as a content-hashed static asset.
+//
+//   program [--pressure 14.7] [--max-temp 120] [--max-w 0.03]
+//           [--out ../webapp/static/chart] [--tolerance 1e-4] [--bench 0]
+//
+// Writes <out>/<hash>.bin (see ChartGeometry.h for the layout), removes
+// older files for the same configuration and rewrites <out>/manifest.json,
+// which maps each configuration present to its file and names the default
+// one; server.js preloads that on the page. The defaults are the chart's.
+// --bench N times N builds and encodes instead of writing anything.
+
+#include <dirent.h>
+#include <errno.h>
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <map>
+#include <string>
+#include <vector>
+#include "ChartGeometry.h"
+#include "IngestClock.h"
+
+static const ChartConfig defaultConfig = { 14.7, 120, 0.03 };
+
+static std::string configKey(const ChartConfig& config) {
+    char key[64];
+    snprintf(key, sizeof(key), "%g-%g-%g", config.totalPressure, config.maxTemp, config.maxW);
+    return key;
+}
+
+// The configuration in an existing file's header, as float32 like the client sees it
+static bool readConfig(const std::string& path, ChartConfig& config) {
+    uint8_t header[20];
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) {
+        return false;
+    }
+    bool ok = fread(header, 1, sizeof(header), file) == sizeof(header) && memcmp(header, CHART_MAGIC, 4) == 0;
+    fclose(file);
+    if (ok) {
+        float values[3];
+        memcpy(values, header + 8, sizeof(values));
+        config.totalPressure = values[0];
+        config.maxTemp = values[1];
+        config.maxW = values[2];
+    }
+    return ok;
+}
+
+static bool writeFile(const std::string& path, const std::vector<uint8_t>& data) {
+    std::string temporary = path + ".tmp";
+    FILE* file = fopen(temporary.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+    bool ok = fwrite(data.data(), 1, data.size(), file) == data.size();
+    ok = fclose(file) == 0 && ok;
+    return ok && rename(temporary.c_str(), path.c_str()) == 0;
+}
+
+static bool isChartFile(const char* name) {
+    size_t length = strlen(name);
+    return length > 4 && strcmp(name + length - 4, ".bin") == 0;
+}
+
+// Drops files superseded by current, then lists what is left
+static bool updateManifest(const std::string& directory, const std::string& current, const ChartConfig& config) {
+    DIR* dir = opendir(directory.c_str());
+    if (!dir) {
+        return false;
+    }
+    std::string key = configKey(config);
+    std::map<std::string, std::string> charts;
+    ChartConfig stored;
+    while (struct dirent* entry = readdir(dir)) {
+        if (!isChartFile(entry->d_name) || !readConfig(directory + "/" + entry->d_name, stored)) {
+            continue;
+        }
+        std::string storedKey = configKey(stored);
+        if (storedKey == key && current != entry->d_name) {
+            unlink((directory + "/" + entry->d_name).c_str());
+            continue;
+        }
+        charts[storedKey] = entry->d_name;
+    }
+    closedir(dir);
+
+    std::string manifest = "{\n  \"default\": ";
+    manifest += charts.count(configKey(defaultConfig)) ? "\"" + configKey(defaultConfig) + "\"" : "null";
+    manifest += ",\n  \"charts\": {";
+    for (std::map<std::string, std::string>::const_iterator it = charts.begin(); it != charts.end(); ++it) {
+        manifest += (it == charts.begin() ? "\n    \"" : ",\n    \"") + it->first + "\": \"" + it->second + "\"";
+    }
+    manifest += "\n  }\n}\n";
+    return writeFile(directory + "/manifest.json", std::vector<uint8_t>(manifest.begin(), manifest.end()));
+}
+
+int main(int argc, char** argv) {
+    static const struct option longOptions[] = {
+        { "pressure", required_argument, 0, 'p' },
+        { "max-temp", required_argument, 0, 't' },
+        { "max-w", required_argument, 0, 'w' },
+        { "out", required_argument, 0, 'o' },
+        { "tolerance", required_argument, 0, 'T' },
+        { "bench", required_argument, 0, 'b' },
+        { 0, 0, 0, 0 },
+    };
+    ChartConfig config = defaultConfig;
+    std::string directory = "../webapp/static/chart";
+    double tolerance = CHART_TOLERANCE;
+    int benchRuns = 0;
+
+    int option;
+    while ((option = getopt_long(argc, argv, "", longOptions, 0)) != -1) {
+        switch (option) {
+            case 'p': config.totalPressure = atof(optarg); break;
+            case 't': config.maxTemp = atof(optarg); break;
+            case 'w': config.maxW = atof(optarg); break;
+            case 'o': directory = optarg; break;
+            case 'T': tolerance = atof(optarg); break;
+            case 'b': benchRuns = atoi(optarg); break;
+            default:
+                fprintf(stderr, "usage: psychro-chartgen [--pressure PSIA] [--max-temp F] [--max-w LB/LB] "
+                                "[--out DIR] [--tolerance FRACTION] [--bench RUNS]\n");
+                return 2;
+        }
+    }
+    // The ranges the chart's own inputs accept
+    if (!(config.totalPressure > 10 && config.totalPressure < 20) || !(config.maxTemp > CHART_MIN_TEMP && config.maxTemp < 180)
+        || !(config.maxW > 0 && config.maxW < 0.07)) {
+        fprintf(stderr, "psychro-chartgen: configuration out of range\n");
+        return 2;
+    }
+
+    ChartGeometry geometry;
+    std::vector<uint8_t> data;
+    int64_t start = ingestMonotonicUs();
+    int runs = benchRuns > 0 ? benchRuns : 1;
+    for (int i = 0; i < runs; i++) {
+        buildChartGeometry(config, geometry);
+        encodeChartGeometry(geometry, tolerance, data);
+    }
+    double elapsedMs = (ingestMonotonicUs() - start) / 1000.0 / runs;
+
+    size_t lines = 0;
+    size_t points = 0;
+    for (int f = 0; f < CHART_FAMILIES; f++) {
+        lines += geometry.families[f].size();
+        for (const ChartLine& l : geometry.families[f]) {
+            points += l.points.size();
+        }
+    }
+    // 20 bytes per line header, 4 per point kept
+    size_t kept = (data.size() - 36 - 4 * CHART_FAMILIES - 20 * lines) / 4;
+    fprintf(stderr, "psychro-chartgen: %s: %zu lines, %zu points -> %zu, %zu bytes in %.2f ms%s\n",
+            configKey(config).c_str(), lines, points, kept, data.size(), elapsedMs,
+            benchRuns > 0 ? " (mean)" : "");
+    if (benchRuns > 0) {
+        return 0;
+    }
+
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.bin", (unsigned long long)chartContentHash(data));
+    std::string path = directory + "/" + name;
+    if (!writeFile(path, data) || !updateManifest(directory, name, config)) {
+        fprintf(stderr, "psychro-chartgen: cannot write %s: %s\n", path.c_str(), strerror(errno));
+        return 1;
+    }
+    printf("%s\n", path.c_str());
+    return 0;
+}
@@ -0,0 +1,163 @@
+// psychro-history: answers history requests from webapp/server.js out of
+// the samples and rollup tables that psychro-ingest maintains.
+//
+//   program [--db ../webapp/measurements.db] [--socket /tmp/psychro-history.sock]
+//
+// One request per connection on a unix stream socket: the client writes
+//   <channel> <from epoch ms> <to epoch ms> <max points>\n
+// and reads a JSON array of at most max points rows (the row shape of
+// webapp/db.js) until the connection closes. The database is opened
+// read-only, so this runs beside the ingest daemon under WAL.
+
+#include <errno.h>
+#include <getopt.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "HistoryQuery.h"
+#include "IngestClock.h"
+
+#define REQUEST_MAX 128
+#define REQUEST_TIMEOUT_S 2
+#define RESPONSE_CHUNK 16384
+#define OPEN_RETRY_S 5
+
+static bool writeAll(int fd, const char* data, size_t length) {
+    while (length > 0) {
+        ssize_t written = send(fd, data, length, MSG_NOSIGNAL);
+        if (written <= 0) {
+            return false;
+        }
+        data += written;
+        length -= (size_t)written;
+    }
+    return true;
+}
+
+static bool readRequest(int client, char* request) {
+    size_t length = 0;
+    while (length < REQUEST_MAX - 1) {
+        ssize_t count = recv(client, request + length, REQUEST_MAX - 1 - length, 0);
+        if (count <= 0) {
+            return false;
+        }
+        length += (size_t)count;
+        request[length] = '\0';
+        if (strchr(request, '\n')) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void serve(int client, HistoryQuery& history, std::vector<HistoryPoint>& points) {
+    char request[REQUEST_MAX];
+    unsigned channel;
+    long long from, to;
+    size_t maxPoints;
+    if (!readRequest(client, request)
+        || sscanf(request, "%u %lld %lld %zu", &channel, &from, &to, &maxPoints) != 4 || channel > 255) {
+        writeAll(client, "{\"error\":\"bad request\"}", 23);
+        return;
+    }
+
+    int64_t start = ingestMonotonicUs();
+    if (!history.query((uint8_t)channel, from, to, maxPoints, points)) {
+        char message[256];
+        int length = snprintf(message, sizeof(message), "{\"error\":\"%s\"}", history.error());
+        writeAll(client, message, (size_t)length);
+        return;
+    }
+
+    // Streamed out in chunks; the response is bounded by HISTORY_MAX_POINTS rows
+    static char chunk[RESPONSE_CHUNK];
+    size_t length = 0;
+    chunk[length++] = '[';
+    for (size_t i = 0; i < points.size(); i++) {
+        if (RESPONSE_CHUNK - length < 512) {
+            if (!writeAll(client, chunk, length)) {
+                return;
+            }
+            length = 0;
+        }
+        if (i > 0) {
+            chunk[length++] = ',';
+        }
+        length += historyFormatPoint(points[i], chunk + length, RESPONSE_CHUNK - length);
+    }
+    chunk[length++] = ']';
+    writeAll(client, chunk, length);
+
+    fprintf(stderr, "history: channel %u, %.0f min, tier %s, %zu source rows -> %zu points in %.1f ms\n",
+            channel, (to - from) / 60000.0,
+            history.tier() == HISTORY_TIER_RAW ? "raw" : rollupTables[history.tier()],
+            history.sourceRows(), points.size(), (ingestMonotonicUs() - start) / 1000.0);
+}
+
+int main(int argc, char** argv) {
+    static const struct option longOptions[] = {
+        { "db", required_argument, 0, 'D' },
+        { "socket", required_argument, 0, 's' },
+        { 0, 0, 0, 0 },
+    };
+    const char* database = "../webapp/measurements.db";
+    const char* socketPath = "/tmp/psychro-history.sock";
+
+    int option;
+    while ((option = getopt_long(argc, argv, "", longOptions, 0)) != -1) {
+        switch (option) {
+            case 'D': database = optarg; break;
+            case 's': socketPath = optarg; break;
+            default:
+                fprintf(stderr, "usage: psychro-history [--db PATH] [--socket PATH]\n");
+                return 2;
+        }
+    }
+
+    // The rollup tables appear once psychro-ingest has opened the database
+    HistoryQuery history;
+    while (!history.open(database)) {
+        fprintf(stderr, "psychro-history: waiting for %s: %s\n", database, history.error());
+        history.close();
+        sleep(OPEN_RETRY_S);
+    }
+
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (strlen(socketPath) >= sizeof(address.sun_path)) {
+        fprintf(stderr, "psychro-history: socket path too long\n");
+        return 1;
+    }
+    strcpy(address.sun_path, socketPath);
+    int listener = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    unlink(socketPath);
+    if (listener < 0 || bind(listener, (struct sockaddr*)&address, sizeof(address)) < 0 || listen(listener, 16) < 0) {
+        fprintf(stderr, "psychro-history: cannot listen on %s: %s\n", socketPath, strerror(errno));
+        return 1;
+    }
+    signal(SIGPIPE, SIG_IGN);
+
+    std::vector<HistoryPoint> points;
+    while (true) {
+        int client = accept4(listener, 0, 0, SOCK_CLOEXEC);
+        if (client < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        // A client that never sends its request must not hold up the others
+        struct timeval timeout = { REQUEST_TIMEOUT_S, 0 };
+        setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+        serve(client, history, points);
+        close(client);
+    }
+    return 1;
+}
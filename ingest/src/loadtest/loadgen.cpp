@@ -0,0 +1,180 @@
+// Synthetic sensor stream for load testing psychro-ingest.
+//
+//   program [--out PATH] [--rate LINES_PER_S] [--seconds N] [--format csv|binary] [--channels N]
+//
+// Without --out a pty is created and its device path printed, to be passed to
+// psychro-ingest --device. With --out the stream goes to a FIFO or file. The
+// samples follow a slow drying-room cycle with sensor noise; CSV lines carry
+// the same fields and precision as the firmware. Samples are paced in 10 ms
+// ticks, and the achieved rate is reported at the end: if the reader falls
+// behind, the pty buffer fills and the achieved rate drops below the target.
+
+#include <fcntl.h>
+#include <getopt.h>
+#include <math.h>
+#include <pty.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include <PsychroFrame.h>
+#include <Psychrometrics.h>
+
+#define TICK_US 10000
+
+static int64_t monotonicUs() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (int64_t)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+static bool writeAll(int fd, const void* data, size_t length) {
+    const uint8_t* bytes = (const uint8_t*)data;
+    while (length > 0) {
+        ssize_t written = write(fd, bytes, length);
+        if (written <= 0) {
+            return false;
+        }
+        bytes += written;
+        length -= (size_t)written;
+    }
+    return true;
+}
+
+// Dry bulb 20..40 °C over a 10 minute cycle, wet bulb 4..12 °C below it
+static void synthesize(uint32_t index, uint8_t channel, float& dryBulbTemp, float& wetBulbTemp) {
+    float phase = index * 0.001f + channel * 0.7f;
+    float noise = ((rand() & 0xFF) - 128) * (0.0625f / 128);
+    dryBulbTemp = 30 + 10 * sinf(phase) + noise;
+    wetBulbTemp = dryBulbTemp - 8 - 4 * cosf(phase * 0.5f) + noise;
+}
+
+static size_t formatCsv(uint32_t index, char* out, size_t size) {
+    float dryBulbTemp, wetBulbTemp;
+    synthesize(index, 0, dryBulbTemp, wetBulbTemp);
+    PsychroState state = computePsychroState(dryBulbTemp, wetBulbTemp);
+    return (size_t)snprintf(out, size, "%.2f,%.2f,%.4f,%.2f,%.5f,%.2f,%.3f,%.2f\r\n",
+        state.dryBulbTemp, state.wetBulbTemp, state.relativeHumidity, state.dewPoint,
+        state.absoluteHumidity, state.partialPressure, state.specificVolume, state.enthalpy);
+}
+
+static size_t formatFrame(uint32_t index, uint8_t channels, uint32_t millis, uint8_t* out) {
+    PsychroMultiStateFrame frame;
+    frame.header.seq = (uint16_t)index;
+    frame.header.timestamp = millis;
+    frame.count = channels;
+    for (uint8_t channel = 0; channel < channels; channel++) {
+        float dryBulbTemp, wetBulbTemp;
+        synthesize(index, channel, dryBulbTemp, wetBulbTemp);
+        PsychroState state = computePsychroState(dryBulbTemp, wetBulbTemp);
+        frame.channels[channel].dryBulbTemp = psychroWireInt16(state.dryBulbTemp, PSYCHRO_SCALE_TEMP);
+        frame.channels[channel].wetBulbTemp = psychroWireInt16(state.wetBulbTemp, PSYCHRO_SCALE_TEMP);
+        frame.channels[channel].relativeHumidity = psychroWireUint16(state.relativeHumidity, PSYCHRO_SCALE_RH);
+        frame.channels[channel].dewPoint = psychroWireInt16(state.dewPoint, PSYCHRO_SCALE_TEMP);
+    }
+    return psychroEncodeFrame(FRAME_MULTI_STATE, &frame, PSYCHRO_MULTI_STATE_SIZE(channels), out);
+}
+
+int main(int argc, char** argv) {
+    static const struct option longOptions[] = {
+        { "out", required_argument, 0, 'o' },
+        { "rate", required_argument, 0, 'r' },
+        { "seconds", required_argument, 0, 's' },
+        { "format", required_argument, 0, 'f' },
+        { "channels", required_argument, 0, 'c' },
+        { 0, 0, 0, 0 },
+    };
+    const char* out = 0;
+    double rate = 2000;
+    double seconds = 30;
+    bool binary = false;
+    int channels = 1;
+
+    int option;
+    while ((option = getopt_long(argc, argv, "", longOptions, 0)) != -1) {
+        switch (option) {
+            case 'o': out = optarg; break;
+            case 'r': rate = atof(optarg); break;
+            case 's': seconds = atof(optarg); break;
+            case 'f': binary = strcmp(optarg, "binary") == 0; break;
+            case 'c': channels = atoi(optarg); break;
+            default:
+                fprintf(stderr, "usage: loadgen [--out PATH] [--rate N] [--seconds N] [--format csv|binary] [--channels N]\n");
+                return 2;
+        }
+    }
+    if (channels < 1 || channels > PSYCHRO_FRAME_MAX_CHANNELS) {
+        fprintf(stderr, "loadgen: --channels must be 1..%d\n", PSYCHRO_FRAME_MAX_CHANNELS);
+        return 2;
+    }
+
+    int fd;
+    int slave = -1;
+    if (out) {
+        fd = open(out, O_WRONLY | O_CLOEXEC);
+    } else {
+        // Raw from the start, so nothing is echoed before the reader configures it
+        struct termios raw;
+        memset(&raw, 0, sizeof(raw));
+        cfmakeraw(&raw);
+        char name[64];
+        if (openpty(&fd, &slave, name, &raw, 0) < 0) {
+            perror("loadgen: openpty");
+            return 1;
+        }
+        printf("%s\n", name);
+        fflush(stdout);
+        sleep(2);  // Time to start psychro-ingest on it
+    }
+    if (fd < 0) {
+        perror("loadgen: open");
+        return 1;
+    }
+
+    uint32_t sent = 0;
+    uint64_t bytes = 0;
+    uint32_t total = (uint32_t)(rate * seconds);
+    int64_t start = monotonicUs();
+    char line[128];
+    uint8_t frame[PSYCHRO_FRAME_ENCODED_MAX];
+
+    while (sent < total) {
+        int64_t elapsed = monotonicUs() - start;
+        uint32_t due = (uint32_t)(rate * elapsed / 1e6);
+        if (due > total) {
+            due = total;
+        }
+        for (; sent < due; sent++) {
+            size_t length;
+            const void* data;
+            if (binary) {
+                length = formatFrame(sent, (uint8_t)channels, (uint32_t)(elapsed / 1000), frame);
+                data = frame;
+            } else {
+                length = formatCsv(sent, line, sizeof(line));
+                data = line;
+            }
+            if (!writeAll(fd, data, length)) {
+                perror("loadgen: write");
+                return 1;
+            }
+            bytes += length;
+        }
+        usleep(TICK_US);
+    }
+
+    double elapsed = (monotonicUs() - start) / 1e6;
+    fprintf(stderr, "loadgen: %u %s, %llu bytes in %.2f s: %.0f/s (target %.0f/s)\n", sent,
+            binary ? "frames" : "lines", (unsigned long long)bytes, elapsed, sent / elapsed, rate);
+
+    // Let the reader drain the pty before it hangs up
+    if (slave >= 0) {
+        tcdrain(fd);
+        sleep(1);
+        close(slave);
+    }
+    close(fd);
+    return 0;
+}
@@ -0,0 +1,340 @@
+// psychro-ingest: reads the instrument's serial stream, stores every sample
+// in SQLite and publishes the latest state on a unix socket.
+//
+//   program --device /dev/ttyACM0 [--db ../webapp/measurements.db]
+//           [--socket /tmp/psychro-ingest.sock] [--format csv|binary]
+//           [--telemetry PATH]
+//
+// Runs a single poll() loop with no allocation per sample. SIGINT/SIGTERM
+// commit the open batch and print the final statistics. Reports from
+// TELEMETRY firmware builds are appended to --telemetry as JSON lines, one
+// per report and one per stage, and are dropped without it.
+
+#include <errno.h>
+#include <getopt.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "IngestClock.h"
+#include "SampleStore.h"
+#include "SerialSource.h"
+#include "StatePublisher.h"
+#include "StreamParser.h"
+
+#define REOPEN_INTERVAL_MS 1000  // Device retry period while it is absent
+#define READ_CHUNK 4096
+
+static volatile sig_atomic_t stopping = 0;
+
+static void onSignal(int) {
+    stopping = 1;
+}
+
+struct Options {
+    const char* device;
+    const char* database;
+    const char* socketPath;
+    const char* telemetryPath;
+    StreamParser::Format format;
+    unsigned long baud;
+    unsigned long backfillBaud;
+    size_t batchSize;
+    int64_t commitIntervalMs;
+    int64_t statsIntervalMs;
+};
+
+// Names of PsychroTelemetryStage in the telemetry log
+static const char* const stageNames[] = {
+    "loop", "idle", "sensor_start", "conversion", "sensor_read", "calc", "transmit", "debug",
+};
+
+static_assert(sizeof(stageNames) / sizeof(stageNames[0]) == PSYCHRO_TELEMETRY_STAGES, "Name every telemetry stage");
+
+// Stores every sample and publishes the live ones; telemetry goes to its own log
+class IngestPipeline : public IngestSink {
+public:
+    IngestPipeline(SampleStore& store, StatePublisher& publisher, FILE* telemetryLog)
+        : failed(false), store(store), publisher(publisher), telemetryLog(telemetryLog) {}
+
+    void onSample(const IngestSample& sample) override {
+        if (!store.add(sample) && !failed) {
+            fprintf(stderr, "psychro-ingest: insert failed: %s\n", store.error());
+            failed = true;
+        }
+        if (sample.live) {
+            publisher.publish(sample);
+        }
+    }
+
+    void onTelemetry(const PsychroTelemetryFrame& report, int64_t timestamp) override {
+        if (!telemetryLog) {
+            return;
+        }
+        fprintf(telemetryLog,
+            "{\"time\":%lld,\"report\":%u,\"periodMs\":%lu,\"freeSram\":%u,\"minFreeSram\":%u,"
+            "\"serialBytes\":%lu,\"txStalls\":%u,\"dewSolves\":%u,\"dewIterations\":%lu,"
+            "\"dewMaxIterations\":%u,\"dewNotConverged\":%u}\n",
+            (long long)timestamp, report.header.seq, (unsigned long)report.periodMs, report.freeSram,
+            report.minFreeSram, (unsigned long)report.serialBytes, report.txStalls, report.dewSolves,
+            (unsigned long)report.dewIterations, report.dewMaxIterations, report.dewNotConverged);
+        fflush(telemetryLog);
+    }
+
+    void onTelemetrySpan(const PsychroTelemetrySpanFrame& span, int64_t timestamp) override {
+        if (!telemetryLog) {
+            return;
+        }
+        // Stages this build does not know are logged by number
+        char stage[16];
+        if (span.stage < PSYCHRO_TELEMETRY_STAGES) {
+            snprintf(stage, sizeof(stage), "\"%s\"", stageNames[span.stage]);
+        } else {
+            snprintf(stage, sizeof(stage), "%u", span.stage);
+        }
+        fprintf(telemetryLog,
+            "{\"time\":%lld,\"report\":%u,\"stage\":%s,\"count\":%lu,\"minUs\":%lu,\"maxUs\":%lu,"
+            "\"meanUs\":%.1f,\"histogram\":[",
+            (long long)timestamp, span.header.seq, stage, (unsigned long)span.count, (unsigned long)span.minUs,
+            (unsigned long)span.maxUs, span.count ? (double)span.totalUs / span.count : 0.0);
+        for (int i = 0; i < PSYCHRO_SPAN_BUCKETS; i++) {
+            fprintf(telemetryLog, i ? ",%u" : "%u", span.histogram[i]);
+        }
+        fputs("]}\n", telemetryLog);
+        fflush(telemetryLog);
+    }
+
+    bool failed;
+
+private:
+    SampleStore& store;
+    StatePublisher& publisher;
+    FILE* telemetryLog;
+};
+
+static void usage() {
+    fprintf(stderr,
+        "usage: psychro-ingest --device PATH [--db PATH] [--socket PATH] [--format csv|binary]\n"
+        "                      [--baud N] [--backfill-baud N] [--batch N] [--commit-ms N] [--stats-s N]\n"
+        "                      [--telemetry PATH]\n");
+}
+
+static bool parseOptions(int argc, char** argv, Options& options) {
+    static const struct option longOptions[] = {
+        { "device", required_argument, 0, 'd' },
+        { "db", required_argument, 0, 'D' },
+        { "socket", required_argument, 0, 's' },
+        { "format", required_argument, 0, 'f' },
+        { "baud", required_argument, 0, 'b' },
+        { "backfill-baud", required_argument, 0, 'B' },
+        { "batch", required_argument, 0, 'n' },
+        { "commit-ms", required_argument, 0, 'c' },
+        { "stats-s", required_argument, 0, 'S' },
+        { "telemetry", required_argument, 0, 't' },
+        { 0, 0, 0, 0 },
+    };
+
+    options.device = 0;
+    options.database = "../webapp/measurements.db";
+    options.socketPath = "/tmp/psychro-ingest.sock";
+    options.telemetryPath = 0;
+    options.format = StreamParser::FORMAT_CSV;
+    options.baud = 9600;
+    options.backfillBaud = 0;
+    options.batchSize = 512;
+    options.commitIntervalMs = 250;
+    options.statsIntervalMs = 10000;
+
+    int option;
+    while ((option = getopt_long(argc, argv, "", longOptions, 0)) != -1) {
+        switch (option) {
+            case 'd': options.device = optarg; break;
+            case 'D': options.database = optarg; break;
+            case 's': options.socketPath = optarg; break;
+            case 'f':
+                if (strcmp(optarg, "csv") == 0) {
+                    options.format = StreamParser::FORMAT_CSV;
+                } else if (strcmp(optarg, "binary") == 0) {
+                    options.format = StreamParser::FORMAT_BINARY;
+                } else {
+                    return false;
+                }
+                break;
+            case 'b': options.baud = strtoul(optarg, 0, 10); break;
+            case 'B':
+                options.backfillBaud = strtoul(optarg, 0, 10);
+                if (!SerialSource::supportsBaud(options.backfillBaud)) {
+                    fprintf(stderr, "psychro-ingest: unsupported backfill baud %s\n", optarg);
+                    return false;
+                }
+                break;
+            case 'n': options.batchSize = strtoul(optarg, 0, 10); break;
+            case 'c': options.commitIntervalMs = strtol(optarg, 0, 10); break;
+            case 'S': options.statsIntervalMs = strtol(optarg, 0, 10) * 1000; break;
+            case 't': options.telemetryPath = optarg; break;
+            default: return false;
+        }
+    }
+    return options.device != 0;
+}
+
+static void printStats(const StreamParser& parser, const SampleStore& store, const StatePublisher& publisher,
+                       uint64_t previousRows, int64_t elapsedMs) {
+    double rate = elapsedMs > 0 ? (store.rows - previousRows) * 1000.0 / elapsedMs : 0;
+    fprintf(stderr,
+        "rows %llu (%.0f/s), lost %llu, commits %llu, commit p50 %.2f p99 %.2f max %.2f ms,"
+        " row delay p99 %.1f max %.1f ms, skipped %llu invalid %llu dup %llu crc %llu, telemetry %llu,"
+        " replay timeouts %llu, clients dropped %llu\n",
+        (unsigned long long)store.rows, rate, (unsigned long long)store.rowsLost,
+        (unsigned long long)store.commits,
+        store.commitTime.quantile(0.5) / 1000.0, store.commitTime.quantile(0.99) / 1000.0,
+        store.commitTime.max() / 1000.0, store.rowDelay.quantile(0.99) / 1000.0, store.rowDelay.max() / 1000.0,
+        (unsigned long long)parser.skipped, (unsigned long long)parser.invalid,
+        (unsigned long long)parser.duplicates, (unsigned long long)parser.crcErrors(),
+        (unsigned long long)parser.telemetry, (unsigned long long)parser.replayTimeouts,
+        (unsigned long long)publisher.dropped);
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        usage();
+        return 2;
+    }
+
+    SampleStore store;
+    if (!store.open(options.database, options.batchSize, options.commitIntervalMs)) {
+        fprintf(stderr, "psychro-ingest: cannot open %s: %s\n", options.database, store.error());
+        return 1;
+    }
+    StatePublisher publisher;
+    if (!publisher.open(options.socketPath)) {
+        fprintf(stderr, "psychro-ingest: cannot listen on %s: %s\n", options.socketPath, strerror(errno));
+        return 1;
+    }
+    FILE* telemetryLog = 0;
+    if (options.telemetryPath && !(telemetryLog = fopen(options.telemetryPath, "a"))) {
+        fprintf(stderr, "psychro-ingest: cannot open %s: %s\n", options.telemetryPath, strerror(errno));
+        return 1;
+    }
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = onSignal;
+    sigaction(SIGINT, &action, 0);
+    sigaction(SIGTERM, &action, 0);
+
+    SerialSource source;
+    StreamParser parser(options.format);
+    IngestPipeline pipeline(store, publisher, telemetryLog);
+    static uint8_t buffer[READ_CHUNK];
+
+    int64_t nextOpen = 0;
+    int64_t statsStart = ingestMonotonicMs();
+    uint64_t statsRows = 0;
+    bool done = false;
+
+    while (!stopping && !done) {
+        int64_t now = ingestMonotonicMs();
+
+        if (!source.isOpen() && now >= nextOpen) {
+            if (source.open(options.device, options.baud)) {
+                fprintf(stderr, "psychro-ingest: reading %s\n", options.device);
+                parser.reset();
+            } else {
+                nextOpen = now + REOPEN_INTERVAL_MS;
+            }
+        }
+
+        struct pollfd fds[2];
+        nfds_t count = 0;
+        fds[count].fd = publisher.listenFd();
+        fds[count++].events = POLLIN;
+        if (source.isOpen()) {
+            fds[count].fd = source.fd();
+            fds[count++].events = POLLIN;
+        }
+
+        int64_t timeout = options.statsIntervalMs > 0 ? statsStart + options.statsIntervalMs - now : 1000;
+        int64_t commitDue = store.msUntilCommit(now);
+        if (commitDue >= 0 && commitDue < timeout) {
+            timeout = commitDue;
+        }
+        if (!source.isOpen() && nextOpen - now < timeout) {
+            timeout = nextOpen - now;
+        }
+        poll(fds, count, timeout > 0 ? (int)timeout : 0);
+
+        if (fds[0].revents & POLLIN) {
+            publisher.acceptClients();
+        }
+
+        // Drain what the device has; a regular file is read to its end once
+        while (source.isOpen()) {
+            ssize_t length = source.read(buffer, sizeof(buffer));
+            if (length < 0) {
+                break;
+            }
+            if (length == 0) {
+                done = source.regularFile();
+                source.close();
+                nextOpen = ingestMonotonicMs() + REOPEN_INTERVAL_MS;
+                break;
+            }
+            parser.push(buffer, (size_t)length, ingestWallClockMs(), pipeline);
+        }
+
+        // Follow the device to a backfill replay's rate and back
+        if (source.writable()) {
+            if (parser.replayTimedOut(ingestMonotonicMs())) {
+                fprintf(stderr, "psychro-ingest: backfill at %lu baud timed out, retrying at %lu\n",
+                        source.baud(), options.baud);
+            }
+            unsigned long linkBaud = parser.replayBaud() ? parser.replayBaud() : options.baud;
+            if (linkBaud != source.baud() && !source.setBaud(linkBaud)) {
+                fprintf(stderr, "psychro-ingest: cannot switch to %lu baud\n", linkBaud);
+            }
+        }
+
+        uint16_t fromSeq;
+        if (source.writable() && parser.backfillWanted(fromSeq, ingestMonotonicMs())) {
+            PsychroBackfillRequestFrame request;
+            request.fromSeq = fromSeq;
+            // A replay rate that once timed out may not get through; stay at the link rate
+            request.baud = parser.replayTimeouts == 0 ? options.backfillBaud : 0;
+            uint8_t encoded[PSYCHRO_FRAME_ENCODED_MAX];
+            size_t length = psychroEncodeFrame(FRAME_BACKFILL_REQUEST, &request, sizeof(request), encoded);
+            source.write(encoded, length);
+        }
+
+        // Keep the device's sample log short while we are listening
+        uint16_t nextSeq;
+        if (source.writable() && parser.ackWanted(nextSeq)) {
+            PsychroLogAckFrame ack;
+            ack.nextSeq = nextSeq;
+            uint8_t encoded[PSYCHRO_FRAME_ENCODED_MAX];
+            size_t length = psychroEncodeFrame(FRAME_LOG_ACK, &ack, sizeof(ack), encoded);
+            source.write(encoded, length);
+        }
+
+        now = ingestMonotonicMs();
+        if (!store.tick(now)) {
+            fprintf(stderr, "psychro-ingest: commit failed: %s\n", store.error());
+        }
+        if (options.statsIntervalMs > 0 && now - statsStart >= options.statsIntervalMs) {
+            printStats(parser, store, publisher, statsRows, now - statsStart);
+            statsStart = now;
+            statsRows = store.rows;
+        }
+    }
+
+    if (!store.commit()) {
+        fprintf(stderr, "psychro-ingest: commit failed: %s\n", store.error());
+    }
+    printStats(parser, store, publisher, statsRows, ingestMonotonicMs() - statsStart);
+    if (telemetryLog) {
+        fclose(telemetryLog);
+    }
+    return pipeline.failed ? 1 : 0;
+}
@@ -0,0 +1,179 @@
+// psychro-recompute: recomputes the derived columns of every row in the
+// samples table from its dry and wet bulb, e.g. after the equations or the
+// P_ws backend changed or for rows imported from webapp/db.js, which the
+// firmware computed in its own precision.
+//
+//   program [--db ../webapp/measurements.db] [--threads 0] [--scalar]
+//
+// Rows are read in chunks of RECOMPUTE_CHUNK, run through PsychroBatch
+// (AVX2 and one thread per core unless --threads or --scalar say otherwise)
+// and written back in a single transaction that also rebuilds the rollup
+// tiers, so history never mixes old and new values. Stop psychro-ingest
+// first: it would wait on the write lock for the whole run.
+
+#include <getopt.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+#include <sqlite3.h>
+#include <PsychroBatch.h>
+#include "IngestClock.h"
+#include "RollupStore.h"
+
+#define RECOMPUTE_CHUNK PSYCHRO_BATCH_PARALLEL_MIN  // Large enough to use every thread
+
+static const char* const SELECT_CHUNK =
+    "SELECT rowid, dry_bulb, wet_bulb FROM samples WHERE rowid > ? ORDER BY rowid LIMIT ?";
+
+static const char* const UPDATE_ROW =
+    "UPDATE samples SET relative_humidity = ?, dew_point = ?, absolute_humidity = ?,"
+    " partial_pressure = ?, specific_volume = ?, enthalpy = ? WHERE rowid = ?";
+
+// Output columns in UPDATE_ROW order
+struct Chunk {
+    std::vector<int64_t> rowids;
+    std::vector<float> dryBulb;
+    std::vector<float> wetBulb;
+    std::vector<float> columns[6];
+};
+
+// The next chunk after rowid from; NULL readings come back as NaN and
+// leave NaN in every derived column
+static bool readChunk(sqlite3_stmt* select, int64_t from, Chunk& chunk) {
+    chunk.rowids.clear();
+    chunk.dryBulb.clear();
+    chunk.wetBulb.clear();
+    sqlite3_bind_int64(select, 1, from);
+    sqlite3_bind_int(select, 2, RECOMPUTE_CHUNK);
+    int result;
+    while ((result = sqlite3_step(select)) == SQLITE_ROW) {
+        chunk.rowids.push_back(sqlite3_column_int64(select, 0));
+        chunk.dryBulb.push_back(sqlite3_column_type(select, 1) == SQLITE_NULL ? NAN : (float)sqlite3_column_double(select, 1));
+        chunk.wetBulb.push_back(sqlite3_column_type(select, 2) == SQLITE_NULL ? NAN : (float)sqlite3_column_double(select, 2));
+    }
+    sqlite3_reset(select);
+    return result == SQLITE_DONE;
+}
+
+// Units as SampleStore writes them: relative humidity in %; a NaN binds as NULL
+static bool writeChunk(sqlite3_stmt* update, const Chunk& chunk) {
+    for (size_t i = 0; i < chunk.rowids.size(); i++) {
+        sqlite3_bind_double(update, 1, chunk.columns[0][i] * 100.0);
+        for (int column = 1; column < 6; column++) {
+            sqlite3_bind_double(update, column + 1, chunk.columns[column][i]);
+        }
+        sqlite3_bind_int64(update, 7, chunk.rowids[i]);
+        int result = sqlite3_step(update);
+        sqlite3_reset(update);
+        if (result != SQLITE_DONE) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Every tier emptied and filled again from the updated samples
+static bool rebuildRollups(sqlite3* db) {
+    RollupStore rollups;
+    if (!rollups.open(db)) {
+        return false;
+    }
+    for (uint8_t tier = 0; tier < ROLLUP_TIERS; tier++) {
+        char sql[64];
+        snprintf(sql, sizeof(sql), "DELETE FROM %s", rollupTables[tier]);
+        if (sqlite3_exec(db, sql, 0, 0, 0) != SQLITE_OK) {
+            return false;
+        }
+    }
+    return rollups.rollUp(INT64_MIN, INT64_MAX);
+}
+
+int main(int argc, char** argv) {
+    static const struct option longOptions[] = {
+        { "db", required_argument, 0, 'D' },
+        { "threads", required_argument, 0, 't' },
+        { "scalar", no_argument, 0, 's' },
+        { 0, 0, 0, 0 },
+    };
+    const char* database = "../webapp/measurements.db";
+    unsigned threads = 0;
+    bool scalar = false;
+
+    int option;
+    while ((option = getopt_long(argc, argv, "", longOptions, 0)) != -1) {
+        switch (option) {
+            case 'D': database = optarg; break;
+            case 't': threads = (unsigned)atoi(optarg); break;
+            case 's': scalar = true; break;
+            default:
+                fprintf(stderr, "usage: psychro-recompute [--db PATH] [--threads N] [--scalar]\n");
+                return 2;
+        }
+    }
+
+    sqlite3* db;
+    if (sqlite3_open_v2(database, &db, SQLITE_OPEN_READWRITE, 0) != SQLITE_OK) {
+        fprintf(stderr, "psychro-recompute: cannot open %s: %s\n", database, sqlite3_errmsg(db));
+        return 1;
+    }
+    sqlite3_busy_timeout(db, 5000);
+
+    sqlite3_stmt* select = 0;
+    sqlite3_stmt* update = 0;
+    if (sqlite3_prepare_v2(db, SELECT_CHUNK, -1, &select, 0) != SQLITE_OK
+        || sqlite3_prepare_v2(db, UPDATE_ROW, -1, &update, 0) != SQLITE_OK
+        || sqlite3_exec(db, "BEGIN IMMEDIATE", 0, 0, 0) != SQLITE_OK) {
+        fprintf(stderr, "psychro-recompute: %s\n", sqlite3_errmsg(db));
+        sqlite3_finalize(select);
+        sqlite3_finalize(update);
+        sqlite3_close(db);
+        return 1;
+    }
+
+    int64_t start = ingestMonotonicUs();
+    int64_t computeUs = 0;
+    size_t rows = 0;
+    int64_t last = INT64_MIN;
+    Chunk chunk;
+    bool ok = true;
+    while ((ok = readChunk(select, last, chunk)) && !chunk.rowids.empty()) {
+        size_t n = chunk.rowids.size();
+        for (int column = 0; column < 6; column++) {
+            chunk.columns[column].resize(n);
+        }
+        PsychroBatchOut out = {
+            chunk.columns[0].data(), chunk.columns[1].data(), chunk.columns[2].data(),
+            chunk.columns[3].data(), chunk.columns[4].data(), chunk.columns[5].data(),
+        };
+
+        int64_t computeStart = ingestMonotonicUs();
+        if (scalar) {
+            computeBatchScalar(chunk.dryBulb.data(), chunk.wetBulb.data(), n, out);
+        } else {
+            computeBatch(chunk.dryBulb.data(), chunk.wetBulb.data(), n, out, threads);
+        }
+        computeUs += ingestMonotonicUs() - computeStart;
+
+        if (!(ok = writeChunk(update, chunk))) {
+            break;
+        }
+        rows += n;
+        last = chunk.rowids.back();
+    }
+
+    ok = ok && rebuildRollups(db) && sqlite3_exec(db, "COMMIT", 0, 0, 0) == SQLITE_OK;
+    if (!ok) {
+        fprintf(stderr, "psychro-recompute: %s; nothing changed\n", sqlite3_errmsg(db));
+        sqlite3_exec(db, "ROLLBACK", 0, 0, 0);
+    } else {
+        double seconds = (ingestMonotonicUs() - start) / 1e6;
+        fprintf(stderr, "psychro-recompute: %zu rows in %.2f s (%.0f rows/s), %s kernel %.2f s\n",
+                rows, seconds, seconds > 0 ? rows / seconds : 0.0,
+                !scalar && psychroBatchHasAvx2() ? "AVX2" : "scalar", computeUs / 1e6);
+    }
+    sqlite3_finalize(select);
+    sqlite3_finalize(update);
+    sqlite3_close(db);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,344 @@
+// StreamParser fed byte streams as the board sends them: which CSV lines and
+// frames reach the sink, duplicate seqs, gaps and the backfill requests and
+// acks they lead to, device resets, a replay whose END never arrives, and
+// telemetry sent as '#' hex lines.
+
+#include <unity.h>
+#include <math.h>
+#include <string.h>
+#include "StreamParser.h"
+
+#define SINK_MAX 64
+#define DEVICE_EPOCH 1700000000000LL  // Host UTC ms the tests push at
+
+// Keeps what the parser delivers
+class RecordingSink : public IngestSink {
+public:
+    IngestSample samples[SINK_MAX];
+    uint8_t count;
+    uint8_t telemetryFrames;
+    PsychroTelemetryFrame lastTelemetry;
+
+    RecordingSink() : count(0), telemetryFrames(0) {}
+
+    void onSample(const IngestSample& sample) override {
+        if (count < SINK_MAX) {
+            samples[count] = sample;
+        }
+        count++;
+    }
+
+    void onTelemetry(const PsychroTelemetryFrame& frame, int64_t) override {
+        lastTelemetry = frame;
+        telemetryFrames++;
+    }
+};
+
+void setUp() {}
+void tearDown() {}
+
+static void pushText(StreamParser& parser, const char* text, RecordingSink& sink) {
+    parser.push((const uint8_t*)text, strlen(text), DEVICE_EPOCH, sink);
+}
+
+static void pushFrame(StreamParser& parser, uint8_t type, const void* body, size_t length,
+                      RecordingSink& sink, int64_t now = DEVICE_EPOCH) {
+    uint8_t encoded[PSYCHRO_FRAME_ENCODED_MAX];
+    size_t encodedLength = psychroEncodeFrame(type, body, length, encoded);
+    parser.push(encoded, encodedLength, now, sink);
+}
+
+// A live state frame; only dry and wet bulb matter to the parser
+static void pushState(StreamParser& parser, uint16_t seq, uint32_t timestamp, RecordingSink& sink,
+                      int16_t dryBulb = 2500, int16_t wetBulb = 1800) {
+    PsychroStateFrame frame;
+    memset(&frame, 0, sizeof(frame));
+    frame.header.seq = seq;
+    frame.header.timestamp = timestamp;
+    frame.dryBulbTemp = dryBulb;
+    frame.wetBulbTemp = wetBulb;
+    pushFrame(parser, FRAME_STATE, &frame, sizeof(frame), sink);
+}
+
+// A sample replayed from the device log
+static void pushRaw(StreamParser& parser, uint16_t seq, uint32_t timestamp, RecordingSink& sink) {
+    PsychroRawSampleFrame frame;
+    frame.header.seq = seq;
+    frame.header.timestamp = timestamp;
+    frame.dryBulbTemp = 2500;
+    frame.wetBulbTemp = 1800;
+    pushFrame(parser, FRAME_RAW_SAMPLE, &frame, sizeof(frame), sink);
+}
+
+// type | body | crc16 as the firmware's '#' line, newline included
+static void hexLine(uint8_t type, const void* body, size_t length, char* out) {
+    uint8_t frame[PSYCHRO_FRAME_MAX];
+    frame[0] = type;
+    memcpy(frame + 1, body, length);
+    uint16_t crc = psychroCrc16(frame, length + 1);
+    frame[length + 1] = (uint8_t)crc;
+    frame[length + 2] = (uint8_t)(crc >> 8);
+
+    static const char digits[] = "0123456789ABCDEF";
+    *out++ = '#';
+    for (size_t i = 0; i < length + 3; i++) {
+        *out++ = digits[frame[i] >> 4];
+        *out++ = digits[frame[i] & 0x0F];
+    }
+    *out++ = '\n';
+    *out = '\0';
+}
+
+// Same rules as webapp/server.js: exactly 8 numeric fields in range, the
+// rest counted and dropped
+static void test_csv_acceptance() {
+    StreamParser parser(StreamParser::FORMAT_CSV);
+    RecordingSink sink;
+
+    pushText(parser, "25.00,18.00,0.5074,14.09,0.01007,1608.18,0.858,50.80\r\n", sink);
+    TEST_ASSERT_EQUAL_UINT8(1, sink.count);
+    TEST_ASSERT_EQUAL_INT(-1, sink.samples[0].seq);
+    TEST_ASSERT_EQUAL_INT64(DEVICE_EPOCH, sink.samples[0].timestamp);
+    TEST_ASSERT_EQUAL_FLOAT(0.5074f, sink.samples[0].state.relativeHumidity);
+
+    pushText(parser, "Sensors found: 2\n", sink);
+    pushText(parser, "25.00,18.00,0.5074,14.09,0.01007,1608.18,0.858\n", sink);
+    pushText(parser, "25.00,18.00,0.5074,14.09,0.01007,1608.18,0.858,50.80,1\n", sink);
+    pushText(parser, "25.00,18.00,0.5074,14.09,0.01007,1608.18,0.858,50.80 C\n", sink);
+    TEST_ASSERT_EQUAL_UINT64(4, parser.skipped);
+
+    pushText(parser, "120.00,18.00,0.5074,14.09,0.01007,1608.18,0.858,50.80\n", sink);
+    pushText(parser, "25.00,-60.00,0.5074,14.09,0.01007,1608.18,0.858,50.80\n", sink);
+    pushText(parser, "25.00,18.00,1.5,14.09,0.01007,1608.18,0.858,50.80\n", sink);
+    pushText(parser, "25.00,18.00,nan,14.09,0.01007,1608.18,0.858,50.80\n", sink);
+    TEST_ASSERT_EQUAL_UINT64(4, parser.invalid);
+
+    // A line too long to hold is dropped whole, not parsed from its tail
+    char longLine[STREAM_LINE_MAX + 64];
+    memset(longLine, ' ', sizeof(longLine));
+    strcpy(longLine + sizeof(longLine) - 60, "25.00,18.00,0.5074,14.09,0.01007,1608.18,0.858,50.80\n");
+    pushText(parser, longLine, sink);
+    TEST_ASSERT_EQUAL_UINT64(5, parser.skipped);
+
+    // Split anywhere across reads
+    const char* line = "20.00,15.00,0.5811,11.58,0.00856,1367.06,0.846,41.76\n";
+    for (const char* c = line; *c; c++) {
+        parser.push((const uint8_t*)c, 1, DEVICE_EPOCH, sink);
+    }
+    TEST_ASSERT_EQUAL_UINT8(2, sink.count);
+    TEST_ASSERT_EQUAL_UINT64(2, parser.lines);
+    TEST_ASSERT_EQUAL_FLOAT(20.0f, sink.samples[1].state.dryBulbTemp);
+}
+
+// Frames carry only the readings; the rest is recomputed, and readings the
+// sensors cannot give are rejected like CSV ones
+static void test_frame_samples() {
+    StreamParser parser(StreamParser::FORMAT_BINARY);
+    RecordingSink sink;
+
+    pushState(parser, 1, 5000, sink);
+    TEST_ASSERT_EQUAL_UINT8(1, sink.count);
+    PsychroState expected = computePsychroState(25.0f, 18.0f);
+    TEST_ASSERT_EQUAL_FLOAT(expected.relativeHumidity, sink.samples[0].state.relativeHumidity);
+    TEST_ASSERT_EQUAL_FLOAT(expected.dewPoint, sink.samples[0].state.dewPoint);
+
+    pushState(parser, 2, 6000, sink, 15000, 1800);  // 150 °C
+    pushState(parser, 3, 7000, sink, 2000, 3000);   // Wet bulb above dry bulb
+    TEST_ASSERT_EQUAL_UINT8(1, sink.count);
+    TEST_ASSERT_EQUAL_UINT64(2, parser.invalid);
+
+    // A disconnected pair is left out, the others still arrive
+    PsychroMultiStateFrame multi;
+    memset(&multi, 0, sizeof(multi));
+    multi.header.seq = 4;
+    multi.header.timestamp = 8000;
+    multi.count = 2;
+    multi.channels[0].dryBulbTemp = PSYCHRO_TEMP_DISCONNECTED;
+    multi.channels[0].wetBulbTemp = 1800;
+    multi.channels[1].dryBulbTemp = 2200;
+    multi.channels[1].wetBulbTemp = 1600;
+    pushFrame(parser, FRAME_MULTI_STATE, &multi, PSYCHRO_MULTI_STATE_SIZE(2), sink);
+    TEST_ASSERT_EQUAL_UINT8(2, sink.count);
+    TEST_ASSERT_EQUAL_UINT8(1, sink.samples[1].channel);
+    TEST_ASSERT_EQUAL_FLOAT(22.0f, sink.samples[1].state.dryBulbTemp);
+}
+
+// A seq is delivered once, live or replayed
+static void test_seq_dedup() {
+    StreamParser parser(StreamParser::FORMAT_BINARY);
+    RecordingSink sink;
+
+    pushState(parser, 100, 10000, sink);
+    pushState(parser, 101, 11000, sink);
+    pushState(parser, 101, 11000, sink);
+    pushRaw(parser, 100, 10000, sink);
+    pushState(parser, 102, 12000, sink);
+
+    TEST_ASSERT_EQUAL_UINT8(3, sink.count);
+    TEST_ASSERT_EQUAL_UINT64(2, parser.duplicates);
+    for (uint8_t i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL_INT(100 + i, sink.samples[i].seq);
+        TEST_ASSERT_TRUE(sink.samples[i].live);
+    }
+}
+
+// A gap is asked for once, not again within STREAM_BACKFILL_RETRY_MS, and
+// acks stop at its start until the replay has ended
+static void test_gap_backfill() {
+    StreamParser parser(StreamParser::FORMAT_BINARY);
+    RecordingSink sink;
+    uint16_t fromSeq = 0;
+    uint16_t nextSeq = 0;
+
+    pushState(parser, 10, 10000, sink);
+    pushState(parser, 11, 11000, sink);
+    TEST_ASSERT_FALSE(parser.backfillWanted(fromSeq, 1000));
+    pushState(parser, 14, 14000, sink);
+    TEST_ASSERT_TRUE(parser.backfillWanted(fromSeq, 1000));
+    TEST_ASSERT_EQUAL_UINT16(12, fromSeq);
+    TEST_ASSERT_FALSE(parser.backfillWanted(fromSeq, 1000));
+
+    // A second gap soon after waits out the retry interval
+    pushState(parser, 16, 16000, sink);
+    TEST_ASSERT_FALSE(parser.backfillWanted(fromSeq, 1000 + STREAM_BACKFILL_RETRY_MS - 1));
+    TEST_ASSERT_TRUE(parser.backfillWanted(fromSeq, 1000 + STREAM_BACKFILL_RETRY_MS));
+    TEST_ASSERT_EQUAL_UINT16(15, fromSeq);
+
+    uint16_t seq = 17;
+    while (!parser.ackWanted(nextSeq)) {
+        pushState(parser, seq, (uint32_t)seq * 1000, sink);
+        seq++;
+    }
+    TEST_ASSERT_EQUAL_UINT16(12, nextSeq);
+
+    // The replay fills the holes with log time mapped to host time
+    PsychroBackfillBeginFrame begin = { 12, 3, 0 };
+    pushFrame(parser, FRAME_BACKFILL_BEGIN, &begin, sizeof(begin), sink);
+    pushRaw(parser, 12, 12000, sink);
+    pushRaw(parser, 13, 13000, sink);
+    pushRaw(parser, 15, 15000, sink);
+    PsychroBackfillEndFrame end = { 16 };
+    pushFrame(parser, FRAME_BACKFILL_END, &end, sizeof(end), sink);
+
+    IngestSample& replayed = sink.samples[sink.count - 3];
+    TEST_ASSERT_FALSE(replayed.live);
+    TEST_ASSERT_EQUAL_INT(12, replayed.seq);
+    TEST_ASSERT_EQUAL_INT64(DEVICE_EPOCH - (int64_t)(seq - 1 - 12) * 1000, replayed.timestamp);
+    TEST_ASSERT_EQUAL_UINT8(seq - 10, sink.count);  // Every seq from 10 on, once
+
+    while (!parser.ackWanted(nextSeq)) {
+        pushState(parser, seq, (uint32_t)seq * 1000, sink);
+        seq++;
+    }
+    TEST_ASSERT_EQUAL_UINT16(seq, nextSeq);
+    TEST_ASSERT_FALSE(parser.backfillWanted(fromSeq, 100000));
+}
+
+// A rebooted device starts its seq and millis() over; that is a new stream,
+// not a run of duplicates or a gap
+static void test_device_reset() {
+    StreamParser parser(StreamParser::FORMAT_BINARY);
+    RecordingSink sink;
+    uint16_t fromSeq;
+
+    pushState(parser, 500, 600000, sink);
+    pushState(parser, 501, 601000, sink);
+    pushState(parser, 0, 1200, sink);
+    pushState(parser, 1, 2200, sink);
+
+    TEST_ASSERT_EQUAL_UINT64(1, parser.deviceResets);
+    TEST_ASSERT_EQUAL_UINT64(0, parser.duplicates);
+    TEST_ASSERT_EQUAL_UINT8(4, sink.count);
+    TEST_ASSERT_EQUAL_INT(0, sink.samples[2].seq);
+    TEST_ASSERT_EQUAL_INT64(DEVICE_EPOCH, sink.samples[2].timestamp);
+    TEST_ASSERT_FALSE(parser.backfillWanted(fromSeq, 1000));
+
+    // An old seq with a later device time is only a duplicate
+    pushState(parser, 0, 3200, sink);
+    TEST_ASSERT_EQUAL_UINT64(1, parser.deviceResets);
+    TEST_ASSERT_EQUAL_UINT64(1, parser.duplicates);
+}
+
+// A replay at another rate whose END is lost falls back to the link rate
+// after STREAM_REPLAY_TIMEOUT_MS of silence and asks for the gap again
+static void test_replay_timeout() {
+    StreamParser parser(StreamParser::FORMAT_BINARY);
+    RecordingSink sink;
+    uint16_t fromSeq = 0;
+
+    pushState(parser, 1, 1000, sink);
+    pushState(parser, 4, 4000, sink);
+    TEST_ASSERT_TRUE(parser.backfillWanted(fromSeq, 1000));
+    TEST_ASSERT_EQUAL_UINT16(2, fromSeq);
+
+    PsychroBackfillBeginFrame begin = { 2, 2, 250000 };
+    pushFrame(parser, FRAME_BACKFILL_BEGIN, &begin, sizeof(begin), sink);
+    TEST_ASSERT_EQUAL_UINT32(250000, parser.replayBaud());
+    TEST_ASSERT_FALSE(parser.replayTimedOut(1100));
+
+    // Frames keep the replay alive
+    pushRaw(parser, 2, 2000, sink);
+    TEST_ASSERT_FALSE(parser.replayTimedOut(1100 + STREAM_REPLAY_TIMEOUT_MS));
+    TEST_ASSERT_FALSE(parser.replayTimedOut(1100 + 2 * STREAM_REPLAY_TIMEOUT_MS - 1));
+    TEST_ASSERT_TRUE(parser.replayTimedOut(1100 + 2 * STREAM_REPLAY_TIMEOUT_MS));
+    TEST_ASSERT_EQUAL_UINT32(0, parser.replayBaud());
+    TEST_ASSERT_EQUAL_UINT64(1, parser.replayTimeouts);
+    TEST_ASSERT_FALSE(parser.replayTimedOut(100000));
+
+    TEST_ASSERT_TRUE(parser.backfillWanted(fromSeq, 1000 + STREAM_BACKFILL_RETRY_MS));
+    TEST_ASSERT_EQUAL_UINT16(2, fromSeq);
+
+    // An END in time ends it without a timeout
+    pushFrame(parser, FRAME_BACKFILL_BEGIN, &begin, sizeof(begin), sink);
+    TEST_ASSERT_FALSE(parser.replayTimedOut(20000));
+    PsychroBackfillEndFrame end = { 4 };
+    pushFrame(parser, FRAME_BACKFILL_END, &end, sizeof(end), sink);
+    TEST_ASSERT_EQUAL_UINT32(0, parser.replayBaud());
+    TEST_ASSERT_FALSE(parser.replayTimedOut(20000 + STREAM_REPLAY_TIMEOUT_MS));
+    TEST_ASSERT_EQUAL_UINT64(1, parser.replayTimeouts);
+}
+
+// CSV mode takes telemetry as '#' hex lines; a bad one never reaches the sink
+static void test_hex_telemetry() {
+    StreamParser parser(StreamParser::FORMAT_CSV);
+    RecordingSink sink;
+    char line[2 * PSYCHRO_FRAME_MAX + 4];
+
+    PsychroTelemetryFrame report;
+    memset(&report, 0, sizeof(report));
+    report.header.seq = 7;
+    report.periodMs = 60000;
+    report.freeSram = 1234;
+    report.stages = PSYCHRO_TELEMETRY_STAGES;
+    hexLine(FRAME_TELEMETRY, &report, sizeof(report), line);
+    pushText(parser, line, sink);
+    TEST_ASSERT_EQUAL_UINT8(1, sink.telemetryFrames);
+    TEST_ASSERT_EQUAL_UINT64(1, parser.telemetry);
+    TEST_ASSERT_EQUAL_UINT16(1234, sink.lastTelemetry.freeSram);
+    TEST_ASSERT_EQUAL_UINT32(60000, sink.lastTelemetry.periodMs);
+
+    line[5] = line[5] == '0' ? '1' : '0';
+    pushText(parser, line, sink);
+    TEST_ASSERT_EQUAL_UINT64(1, parser.invalid);
+
+    pushText(parser, "#0612345\n", sink);  // Odd digit count
+    pushText(parser, "#06XY0000\n", sink);
+    PsychroRawSampleFrame sample = { { 1, 1000 }, 2500, 1800 };
+    hexLine(FRAME_RAW_SAMPLE, &sample, sizeof(sample), line);
+    pushText(parser, line, sink);  // Samples never come as hex
+    TEST_ASSERT_EQUAL_UINT64(3, parser.skipped);
+    TEST_ASSERT_EQUAL_UINT8(1, sink.telemetryFrames);
+    TEST_ASSERT_EQUAL_UINT8(0, sink.count);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_csv_acceptance);
+    RUN_TEST(test_frame_samples);
+    RUN_TEST(test_seq_dedup);
+    RUN_TEST(test_gap_backfill);
+    RUN_TEST(test_device_reset);
+    RUN_TEST(test_replay_timeout);
+    RUN_TEST(test_hex_telemetry);
+    return UNITY_END();
+}
@@ -0,0 +1,153 @@
+// SampleStore on an in-memory database: a batch whose INSERT or rollup write
+// fails is rolled back whole and counted as lost, the next batch starts
+// clean, and webapp/db.js's measurements are imported once on open.
+// A second connection to the same shared-cache database plants the failing
+// triggers and reads back what was committed.
+
+#include <unity.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "SampleStore.h"
+
+#define BATCH 100
+
+static int databases = 0;
+static char path[64];
+static sqlite3* observer;
+
+// Each test gets a database of its own, alive while observer holds it
+void setUp() {
+    snprintf(path, sizeof(path), "file:store%d?mode=memory&cache=shared", databases++);
+    TEST_ASSERT_EQUAL_INT(SQLITE_OK, sqlite3_open(path, &observer));
+}
+
+void tearDown() {
+    sqlite3_close(observer);
+}
+
+static void exec(const char* sql) {
+    TEST_ASSERT_EQUAL_INT(SQLITE_OK, sqlite3_exec(observer, sql, 0, 0, 0));
+}
+
+static int64_t query(const char* sql) {
+    sqlite3_stmt* statement;
+    TEST_ASSERT_EQUAL_INT(SQLITE_OK, sqlite3_prepare_v2(observer, sql, -1, &statement, 0));
+    TEST_ASSERT_EQUAL_INT(SQLITE_ROW, sqlite3_step(statement));
+    int64_t value = sqlite3_column_int64(statement, 0);
+    sqlite3_finalize(statement);
+    return value;
+}
+
+static IngestSample sampleAt(int64_t timestamp, float dryBulb) {
+    IngestSample sample;
+    sample.timestamp = timestamp;
+    sample.seq = -1;
+    sample.channel = 0;
+    sample.live = true;
+    sample.state = computePsychroState(dryBulb, 15.0f);
+    return sample;
+}
+
+// A failing INSERT takes the rows before it in the batch along, rollups
+// included, and leaves no transaction open for the next batch
+static void test_insert_failure_rolls_back() {
+    SampleStore store;
+    TEST_ASSERT_TRUE(store.open(path, BATCH, 60000));
+    exec("CREATE TRIGGER reject BEFORE INSERT ON samples WHEN NEW.dry_bulb > 40"
+         " BEGIN SELECT RAISE(ABORT, 'rejected'); END");
+
+    for (int64_t i = 0; i < 3; i++) {
+        TEST_ASSERT_TRUE(store.add(sampleAt(1000000 + i * 1000, 20)));
+    }
+    TEST_ASSERT_FALSE(store.add(sampleAt(1003000, 45)));
+    TEST_ASSERT_NOT_NULL(strstr(store.error(), "rejected"));
+    TEST_ASSERT_EQUAL_UINT64(4, store.rowsLost);
+    TEST_ASSERT_EQUAL_INT64(0, query("SELECT count(*) FROM samples"));
+
+    TEST_ASSERT_TRUE(store.add(sampleAt(1004000, 21)));
+    TEST_ASSERT_TRUE(store.add(sampleAt(1005000, 22)));
+    TEST_ASSERT_TRUE(store.commit());
+    TEST_ASSERT_EQUAL_UINT64(2, store.rows);
+    TEST_ASSERT_EQUAL_UINT64(4, store.rowsLost);
+    TEST_ASSERT_EQUAL_INT64(2, query("SELECT count(*) FROM samples"));
+    TEST_ASSERT_EQUAL_INT64(2, query("SELECT sum(count) FROM rollup_10s"));
+    TEST_ASSERT_EQUAL_INT64(2, query("SELECT sum(count) FROM rollup_10m"));
+}
+
+// A rollup write that fails at commit loses the whole batch, samples and all
+static void test_rollup_failure_rolls_back() {
+    SampleStore store;
+    TEST_ASSERT_TRUE(store.open(path, BATCH, 60000));
+    exec("CREATE TRIGGER reject BEFORE INSERT ON rollup_1m"
+         " BEGIN SELECT RAISE(ABORT, 'rollup rejected'); END");
+
+    for (int64_t i = 0; i < 5; i++) {
+        TEST_ASSERT_TRUE(store.add(sampleAt(2000000 + i * 1000, 20)));
+    }
+    TEST_ASSERT_FALSE(store.commit());
+    TEST_ASSERT_NOT_NULL(strstr(store.error(), "rollup rejected"));
+    TEST_ASSERT_EQUAL_UINT64(0, store.rows);
+    TEST_ASSERT_EQUAL_UINT64(5, store.rowsLost);
+    TEST_ASSERT_EQUAL_INT64(0, query("SELECT count(*) FROM samples"));
+    TEST_ASSERT_EQUAL_INT64(0, query("SELECT count(*) FROM rollup_10s"));
+
+    // The discarded rollups do not come back with the next batch
+    exec("DROP TRIGGER reject");
+    TEST_ASSERT_TRUE(store.add(sampleAt(2005000, 20)));
+    TEST_ASSERT_TRUE(store.commit());
+    TEST_ASSERT_EQUAL_INT64(1, query("SELECT count(*) FROM samples"));
+    TEST_ASSERT_EQUAL_INT64(1, query("SELECT sum(count) FROM rollup_1m"));
+}
+
+// db.js writes local time; rows from before the first sample become
+// channel 0 samples in UTC ms, once
+static void test_legacy_import() {
+    exec("CREATE TABLE measurements (id INTEGER PRIMARY KEY AUTOINCREMENT,"
+         " timestamp DATETIME DEFAULT CURRENT_TIMESTAMP, dry_bulb REAL, wet_bulb REAL,"
+         " relative_humidity REAL, dew_point REAL, absolute_humidity REAL,"
+         " partial_pressure REAL, specific_volume REAL, enthalpy REAL)");
+    exec("INSERT INTO measurements (timestamp, dry_bulb, wet_bulb, relative_humidity)"
+         " VALUES ('2024-01-15 12:00:00', 20, 15, 58.1), ('2024-01-15 12:00:05', 21, 15, 53.6)");
+
+    struct tm local;
+    memset(&local, 0, sizeof(local));
+    local.tm_year = 2024 - 1900;
+    local.tm_mon = 0;
+    local.tm_mday = 15;
+    local.tm_hour = 12;
+    local.tm_isdst = -1;
+    int64_t first = (int64_t)mktime(&local) * 1000;
+
+    {
+        SampleStore store;
+        TEST_ASSERT_TRUE(store.open(path, BATCH, 60000));
+        TEST_ASSERT_TRUE(store.add(sampleAt(first + 3600000, 22)));
+        TEST_ASSERT_TRUE(store.commit());
+    }
+    TEST_ASSERT_EQUAL_INT64(3, query("SELECT count(*) FROM samples"));
+    TEST_ASSERT_EQUAL_INT64(first, query("SELECT min(ts) FROM samples"));
+    TEST_ASSERT_EQUAL_INT64(first + 5000, query("SELECT ts FROM samples WHERE dry_bulb = 21"));
+    TEST_ASSERT_EQUAL_INT64(2, query("SELECT count(*) FROM samples WHERE seq IS NULL AND channel = 0"
+                                     " AND ts < (SELECT max(ts) FROM samples)"));
+    TEST_ASSERT_EQUAL_INT64(3, query("SELECT sum(count) FROM rollup_10s"));
+
+    SampleStore reopened;
+    TEST_ASSERT_TRUE(reopened.open(path, BATCH, 60000));
+    TEST_ASSERT_EQUAL_INT64(3, query("SELECT count(*) FROM samples"));
+    TEST_ASSERT_EQUAL_INT64(3, query("SELECT sum(count) FROM rollup_10s"));
+}
+
+int main() {
+    // Shared-cache memory databases are named by URI; a fixed zone without
+    // DST keeps the local time conversion the same on every host
+    setenv("TZ", "EST5", 1);
+    tzset();
+    sqlite3_config(SQLITE_CONFIG_URI, 1);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_insert_failure_rolls_back);
+    RUN_TEST(test_rollup_failure_rolls_back);
+    RUN_TEST(test_legacy_import);
+    return UNITY_END();
+}
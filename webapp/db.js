@@ -1,10 +1,14 @@
 // db.js
 const sqlite3 = require('sqlite3').verbose();
 const path = require('path');
+const net = require('net');
+
+const HISTORY_TIMEOUT = 5000;  // ms to wait for the history sidecar
 
 class Database {
     constructor() {
         const dbPath = path.join(__dirname, 'measurements.db');
+        this.ingest = false;
         console.log('Creating/Opening database at:', dbPath);
         
         this.db = new sqlite3.Database(dbPath, (err) => {
@@ -41,6 +45,45 @@ class Database {
         });
     }
 
+    // Read history from the samples table that ingest/ writes (UTC epoch ms
+    // timestamps) instead of the measurements table. Older measurements rows
+    // still fill the time before the first sample; the daemon copies them into
+    // samples when it opens the database, after which this adds nothing.
+    useIngestSamples() {
+        this.ingest = true;
+    }
+
+    // Downsampled history from the psychro-history sidecar (ingest/src/history):
+    // at most `points` rows drawn from the rollup tier that fits the window
+    async getHistory(socketPath, duration, points) {
+        return new Promise((resolve, reject) => {
+            const to = Date.now();
+            const from = to - duration * 60 * 1000;
+            const chunks = [];
+            const socket = net.createConnection(socketPath, () => {
+                socket.end(`0 ${from} ${to} ${points}\n`);
+            });
+
+            socket.setTimeout(HISTORY_TIMEOUT, () => {
+                socket.destroy(new Error('History sidecar timed out'));
+            });
+            socket.on('data', (chunk) => chunks.push(chunk));
+            socket.on('error', reject);
+            socket.on('end', () => {
+                try {
+                    const rows = JSON.parse(Buffer.concat(chunks).toString());
+                    if (rows.error) {
+                        reject(new Error(rows.error));
+                    } else {
+                        resolve(rows);
+                    }
+                } catch (error) {
+                    reject(error);
+                }
+            });
+        });
+    }
+
     insertMeasurement(data) {
         const stmt = this.db.prepare(`
             INSERT INTO measurements (
@@ -68,14 +111,41 @@ class Database {
         return new Promise((resolve, reject) => {
             console.log('Querying database with duration:', duration);
             
-            const sql = `
+            let sql = `
                 SELECT * FROM measurements 
                 WHERE timestamp >= datetime('now', '-' || ? || ' minutes', 'localtime')
                 AND timestamp <= datetime('now', 'localtime')
                 ORDER BY timestamp ASC
             `;
+            let params = [duration];
+
+            if (this.ingest) {
+                // Samples are served from the (channel, ts) index; measurements
+                // are in local time
+                sql = `
+                    SELECT strftime('%Y-%m-%dT%H:%M:%fZ', ts / 1000.0, 'unixepoch') AS timestamp,
+                        dry_bulb, wet_bulb, relative_humidity, dew_point, absolute_humidity,
+                        partial_pressure, specific_volume, enthalpy
+                    FROM (
+                        SELECT ts, dry_bulb, wet_bulb, relative_humidity, dew_point, absolute_humidity,
+                            partial_pressure, specific_volume, enthalpy
+                        FROM samples
+                        WHERE channel = 0 AND ts >= $from
+                        UNION ALL
+                        SELECT strftime('%s', timestamp, 'utc') * 1000 AS ts, dry_bulb, wet_bulb,
+                            relative_humidity, dew_point, absolute_humidity,
+                            partial_pressure, specific_volume, enthalpy
+                        FROM measurements
+                        WHERE timestamp >= datetime($from / 1000, 'unixepoch', 'localtime')
+                            AND strftime('%s', timestamp, 'utc') * 1000
+                                < (SELECT coalesce(min(ts), 9223372036854775807) FROM samples)
+                    )
+                    ORDER BY ts ASC
+                `;
+                params = { $from: Date.now() - duration * 60 * 1000 };
+            }
             
-            this.db.all(sql, [duration], (err, rows) => {
+            this.db.all(sql, params, (err, rows) => {
                 if (err) {
                     console.error('Database query error:', err);
                     reject(err);
@@ -94,7 +164,8 @@ class Database {
 
     async checkDatabase() {
         return new Promise((resolve, reject) => {
-            this.db.get("SELECT COUNT(*) as count FROM measurements", (err, row) => {
+            const table = this.ingest ? 'samples' : 'measurements';
+            this.db.get(`SELECT COUNT(*) as count FROM ${table}`, (err, row) => {
                 if (err) {
                     console.error('Error checking database:', err);
                     reject(err);
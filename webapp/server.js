@@ -4,6 +4,8 @@ const WebSocket = require('ws');
 const { SerialPort } = require('serialport');
 const { ReadlineParser } = require('@serialport/parser-readline');
 const path = require('path');
+const fs = require('fs');
+const net = require('net');
 const db = require('./db');
 
 const app = express();
@@ -19,6 +21,21 @@ let parser;
 let reconnectTimer;
 const RECONNECT_INTERVAL = 5000; // 5 seconds
 
+// With INGEST_SOCKET set, ingest/ owns the serial port and the database
+// writes; this server only relays its published states and reads history
+const ingestSocketPath = process.env.INGEST_SOCKET;
+let ingestSocket;
+
+// With HISTORY_SOCKET set, /api/history is served downsampled by the
+// psychro-history sidecar instead of returning every raw row
+const historySocketPath = process.env.HISTORY_SOCKET;
+const HISTORY_POINTS = 1000;  // Default chart resolution
+
+// Psychrometric chart geometry written by ingest/ (psychro-chartgen). The
+// files are named by content hash, so browsers may cache them for good; the
+// page gets a preload link to the default configuration's file
+const chartDir = path.join(__dirname, 'static', 'chart');
+
 let latestData = {
     dryBulb: 0,
     wetBulb: 0,
@@ -91,6 +108,9 @@ function initializeSerialPort() {
                         return;
                     }
 
+                    // Skip telemetry frames from TELEMETRY firmware builds, read by the ingest daemon
+                    if (trimmedData.startsWith('#')) return;
+
                     // Process data and send to clients
                     processAndSendData(trimmedData);
                 } catch (error) {
@@ -187,15 +207,91 @@ function processAndSendData(trimmedData) {
     db.insertMeasurement(latestData);
 }
 
-// Initialize the serial port when the server starts
-initializeSerialPort();
+function initializeIngestSocket() {
+    ingestSocket = net.createConnection(ingestSocketPath);
+    const lines = new ReadlineParser({ delimiter: '\n' });
+    ingestSocket.pipe(lines);
+
+    ingestSocket.on('connect', () => {
+        console.log('Connected to ingest daemon at', ingestSocketPath);
+        broadcastStatus(true);
+    });
+
+    lines.on('data', (line) => {
+        try {
+            const data = JSON.parse(line);
+            // The browser charts the primary sensor pair only
+            if (data.channel !== 0) return;
+            latestData = data;
+            wss.clients.forEach((client) => {
+                if (client.readyState === WebSocket.OPEN) {
+                    client.send(line);
+                }
+            });
+        } catch (error) {
+            console.error('Error processing ingest data:', error);
+        }
+    });
+
+    ingestSocket.on('error', (err) => {
+        console.error('Ingest socket error:', err.message);
+    });
+
+    ingestSocket.on('close', () => {
+        broadcastStatus(false);
+        clearTimeout(reconnectTimer);
+        reconnectTimer = setTimeout(initializeIngestSocket, RECONNECT_INTERVAL);
+    });
+}
+
+function broadcastStatus(connected) {
+    wss.clients.forEach((client) => {
+        if (client.readyState === WebSocket.OPEN) {
+            client.send(JSON.stringify({ type: 'status', connected: connected }));
+        }
+    });
+}
+
+// Read the sensor directly, or through the ingest daemon
+if (ingestSocketPath) {
+    db.useIngestSamples();
+    initializeIngestSocket();
+} else {
+    initializeSerialPort();
+}
+
+async function chartPreloadLink() {
+    try {
+        const manifest = JSON.parse(await fs.promises.readFile(path.join(chartDir, 'manifest.json'), 'utf8'));
+        const file = manifest.default && manifest.charts[manifest.default];
+        if (!file) return '';
+        return `<link rel="preload" id="chart-geometry" href="/static/chart/${file}" as="fetch" crossorigin>\n`;
+    } catch (error) {
+        // The chart computes its lines in the browser instead
+        return '';
+    }
+}
+
+app.use('/static/chart', express.static(chartDir, {
+    index: false,
+    setHeaders: (res, filePath) => {
+        if (filePath.endsWith('.bin')) {
+            res.setHeader('Cache-Control', 'public, max-age=31536000, immutable');
+        }
+    }
+}));
 
 // Serve static files from the 'static' directory
 app.use('/static', express.static(path.join(__dirname, 'static')));
 
 // Serve the index.html file
-app.get('/', (req, res) => {
-    res.sendFile(path.join(__dirname, 'index.html'));
+app.get('/', async (req, res) => {
+    try {
+        const html = await fs.promises.readFile(path.join(__dirname, 'index.html'), 'utf8');
+        res.type('html').send(html.replace('</head>', `${await chartPreloadLink()}</head>`));
+    } catch (err) {
+        res.status(500).send(err.message);
+    }
 });
 
 app.get('/api/history/:duration', async (req, res) => {
@@ -210,7 +306,13 @@ app.get('/api/history/:duration', async (req, res) => {
         }
         
         console.log('Requesting data for duration:', duration);
-        const data = await db.getMeasurements(duration);
+        let data;
+        if (historySocketPath) {
+            const points = parseInt(req.query.points) || HISTORY_POINTS;
+            data = await db.getHistory(historySocketPath, duration, points);
+        } else {
+            data = await db.getMeasurements(duration);
+        }
         console.log(`Sending ${data.length} records to client`);
         res.json(data);
     } catch (err) {
@@ -247,7 +349,9 @@ wss.on('connection', (ws) => {
     // Send initial connection status
     ws.send(JSON.stringify({
         type: 'status',
-        connected: port && port.isOpen
+        connected: ingestSocketPath
+            ? Boolean(ingestSocket && !ingestSocket.connecting && !ingestSocket.destroyed)
+            : Boolean(port && port.isOpen)
     }));
 
     // Send latest data if available
@@ -271,11 +271,6 @@ function initializeWebSocket() {
 
 function initPsychroChart() {
     try {
-        // Remove any existing bindings
-        if (window.viewModel) {
-            ko.cleanNode(document.getElementById('vizcontainer'));
-        }
-        
         const container = document.getElementById('psychrometricChart');
         const svg = document.getElementById('chartsvg');
         
@@ -297,18 +292,72 @@ function initPsychroChart() {
         svg.setAttribute('viewBox', `0 0 ${width} ${height}`);
         svg.setAttribute('preserveAspectRatio', 'xMinYMin meet');
         
-        // Clear existing content
-        svg.innerHTML = '';
-        
-        // Initialize the view model with the correct dimensions
-        window.viewModel = new ViewModel(width, height);
-        ko.applyBindings(window.viewModel, document.getElementById('vizcontainer'));
+        // Build from the precomputed lines when the server provides them
+        loadChartGeometry()
+            .then((geometry) => buildPsychroChart(width, height, geometry))
+            .catch((error) => console.error('Error initializing psychrometric chart:', error));
         
     } catch (error) {
         console.error('Error initializing psychrometric chart:', error);
     }
 }
 
+function buildPsychroChart(width, height, geometry) {
+    const vizcontainer = document.getElementById('vizcontainer');
+    if (window.viewModel) {
+        ko.cleanNode(vizcontainer);
+    }
+
+    // Clear existing content
+    document.getElementById('chartsvg').innerHTML = '';
+
+    // Initialize the view model with the correct dimensions
+    window.viewModel = new ViewModel(width, height, geometry);
+    ko.applyBindings(window.viewModel, vizcontainer);
+}
+
+// Times the psychrometric chart to its first painted frame, computed in the
+// browser and from the precomputed geometry (fetch and decode included; the
+// asset is usually in the HTTP cache by then). Run from the console on the
+// device itself: benchmarkPsychroChart(10)
+async function benchmarkPsychroChart(runs = 5) {
+    const svg = document.getElementById('chartsvg');
+    const width = svg.clientWidth;
+    const height = svg.clientHeight;
+    const nextPaint = () => new Promise((resolve) => requestAnimationFrame(() => requestAnimationFrame(resolve)));
+    const link = document.getElementById('chart-geometry');
+
+    const paths = {
+        browser: async () => buildPsychroChart(width, height, null),
+        geometry: async () => {
+            const response = await fetch(link.href);
+            buildPsychroChart(width, height, decodeChartGeometry(await response.arrayBuffer()));
+        }
+    };
+    if (!link) {
+        delete paths.geometry;
+    }
+
+    const results = {};
+    for (const [name, build] of Object.entries(paths)) {
+        const times = [];
+        for (let i = 0; i < runs; i++) {
+            await nextPaint();
+            const start = performance.now();
+            await build();
+            const built = performance.now();
+            await nextPaint();
+            times.push({ build: built - start, paint: performance.now() - start });
+        }
+        const mean = (key) => times.reduce((sum, t) => sum + t[key], 0) / runs;
+        results[name] = { 'build ms': mean('build').toFixed(1), 'first paint ms': mean('paint').toFixed(1) };
+    }
+    console.table(results);
+
+    initPsychroChart();
+    return results;
+}
+
 function initializeWithDefaults() {
     // Initialize charts first
     initCharts();
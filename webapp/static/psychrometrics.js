@@ -304,6 +304,67 @@ function satTempAtEnthalpy(enthalpy, totalPressure) {
 
 function isMult(val, mult) { return val % mult === 0; }
 
+// Line geometry precomputed by ingest/ (psychro-chartgen, layout in
+// ingest/include/ChartGeometry.h). server.js links the default configuration's
+// file from the page; without it, or once the inputs leave that configuration,
+// the view model computes the lines itself.
+const chartFamilies = ["boundary", "temp", "humidity", "rh", "volume", "enthalpy", "wetBulb", "enthalpyBorder"];
+const chartQuant = 65535;
+var chartGeometryRequest = null;
+
+function decodeChartGeometry(buffer) {
+    var view = new DataView(buffer);
+    var magic = String.fromCharCode(view.getUint8(0), view.getUint8(1), view.getUint8(2), view.getUint8(3));
+    if (magic !== "PSYC" || view.getUint16(4, true) !== 1) throw new Error("Unknown chart geometry format");
+
+    var header = new Float32Array(buffer, 8, 7);
+    var geometry = {
+        totalPressure: header[0],
+        maxTemp: header[1],
+        maxω: header[2],
+        maxPv: header[3],
+        tempAtCutoff: header[4],
+        upperLeftBorderTemp: header[5],
+        bottomLeftBorderPv: header[6]
+    };
+
+    var tempScale = (geometry.maxTemp - minTemp) / chartQuant;
+    var pvScale = geometry.maxPv / chartQuant;
+    var offset = 36;
+    for (let f = 0; f < view.getUint16(6, true); f++) {
+        var lines = [];
+        var lineCount = view.getUint32(offset, true);
+        offset += 4;
+        for (let i = 0; i < lineCount; i++) {
+            var fields = new Float32Array(buffer, offset, 4);
+            var coords = new Uint16Array(buffer, offset + 20, 2 * view.getUint32(offset + 16, true));
+            var data = [];
+            for (let j = 0; j < coords.length; j += 2) {
+                data.push({ x: minTemp + coords[j] * tempScale, y: coords[j + 1] * pvScale });
+            }
+            lines.push({ value: fields[0], labelTemp: fields[1], labelPv: fields[2], labelSlope: fields[3], data: data });
+            offset += 20 + 2 * coords.length;
+        }
+        geometry[chartFamilies[f]] = lines;
+    }
+    return geometry;
+}
+
+// Resolves to the decoded geometry, or null to compute the chart in the browser
+function loadChartGeometry() {
+    if (!chartGeometryRequest) {
+        var link = document.getElementById("chart-geometry");
+        chartGeometryRequest = !link ? Promise.resolve(null) : fetch(link.href)
+            .then(response => response.ok ? response.arrayBuffer() : null)
+            .then(buffer => buffer && decodeChartGeometry(buffer))
+            .catch(error => {
+                console.error("Error loading chart geometry:", error);
+                return null;
+            });
+    }
+    return chartGeometryRequest;
+}
+
 var constantRHvalues = [10, 20, 30, 40, 50, 60, 70, 80, 90];
 
 function StateTempω(maxTemp, maxω, name, totalPressure) {
@@ -322,7 +383,7 @@ function StateTempω(maxTemp, maxω, name, totalPressure) {
     });
 }
 
-function ViewModel() {
+function ViewModel(width, height, chartGeometry) {
     var self = this;
     // Start by creating svg elements in the order that I want
     // them layered. The later items will be on top of the earlier items.
@@ -397,6 +458,13 @@ function ViewModel() {
 
     self.maxPv = ko.pureComputed(() => pvFromw(self.maxω(), self.totalPressure()) );
 
+    // The precomputed lines, while the inputs match the configuration they were built for
+    self.geometry = ko.pureComputed(() => {
+        var g = chartGeometry;
+        return g && g.totalPressure === Math.fround(self.totalPressure()) &&
+            g.maxTemp === Math.fround(self.maxTemp()) && g.maxω === Math.fround(self.maxω()) ? g : null;
+    });
+
     self.yScale = ko.computed(() => {
         return d3.scaleLinear()
             .domain([0, self.maxPv()])
@@ -414,7 +482,9 @@ function ViewModel() {
             .y(d => self.yScale()(Math.min(d.y, self.maxPv())));
     });
 
-    self.tempAtCutoff = ko.pureComputed(() => tempFromRhAndPv(1, self.maxPv()));
+    self.tempAtCutoff = ko.pureComputed(() => {
+        return self.geometry() ? self.geometry().tempAtCutoff : tempFromRhAndPv(1, self.maxPv());
+    });
     self.upperLeftBorderTemp = ko.pureComputed(() => {
         return self.tempAtCutoff() - 0.05 * (self.maxTemp() - minTemp);
     });
@@ -426,6 +496,8 @@ function ViewModel() {
     self.constantTemps = ko.pureComputed(() => range(minTemp, self.maxTemp(), 1));
 
     self.constantTempLines = ko.computed(() => {
+        // Quantized x is not exact; the stroke width below tests it for multiples of 10
+        if (self.geometry()) return self.geometry().temp.map(l => l.data.map(d => ({ x: l.value, y: d.y })));
         return self.constantTemps().map(temp => {
             return [{ x: temp, y: 0 }, { x: temp, y: satPressFromTempIp(temp) }];
         });
@@ -458,6 +530,7 @@ function ViewModel() {
     });
 
     self.constantHumidityLines = ko.computed(() => {
+        if (self.geometry()) return self.geometry().humidity.map(l => l.data);
         return self.constantHumidities().map(humidity => {
             var pv = pvFromw(humidity, self.totalPressure());
             return [
@@ -517,6 +590,18 @@ function ViewModel() {
     var starttemp = ko.pureComputed(() => Math.round(minTemp + (self.maxTemp() - minTemp) * 0.6));
 
     self.constRHLines = ko.computed(() => {
+        if (self.geometry()) {
+            return self.geometry().rh.map(l => ({
+                rh: l.value,
+                temp: l.labelTemp,
+                pv: l.labelPv,
+                data: l.data,
+                rotationDegrees: angleFromDerivative(l.labelSlope),
+                x: self.xScale()(l.labelTemp),
+                y: self.yScale()(l.labelPv)
+            }));
+        }
+
         return constantRHvalues.map((rhValue, i) => {
             const mapFunction = temp => ({
                 x: temp,
@@ -596,6 +681,16 @@ function ViewModel() {
     self.vValues = ko.computed(() => range(Math.ceil(self.minv() / 0.1) * 0.1, Math.floor(self.maxv() / 0.1) * 0.1, 0.1));
 
     self.vLines = ko.computed(() => {
+        if (self.geometry()) {
+            return self.geometry().volume.map(l => ({
+                v: Math.round(l.value * 10) / 10,
+                data: l.data,
+                labelLocation: { temp: l.labelTemp, pv: l.labelPv },
+                rotationDegrees: angleFromDerivative(l.labelSlope),
+                x: self.xScale()(l.labelTemp),
+                y: self.yScale()(l.labelPv)
+            }));
+        }
 
         var firstVCutoff = vFromTempω(minTemp, satHumidRatioFromTempIp(minTemp, self.totalPressure()), self.totalPressure());
         var secondVCutoff = vFromTempω(self.tempAtCutoff(), wFromPv(self.maxPv(), self.totalPressure()), self.totalPressure());
@@ -730,7 +825,10 @@ function ViewModel() {
         }
     };
 
-    self.constEnthalpyLines = ko.computed(() => self.constEnthalpyValues().map(self.enthalpyValueToLine));
+    self.constEnthalpyLines = ko.computed(() => {
+        if (self.geometry()) return self.geometry().enthalpy.map(l => ({ h: l.value, coords: l.data }));
+        return self.constEnthalpyValues().map(self.enthalpyValueToLine);
+    });
 
     // Draw enthalpy items.
     ko.computed(() => {
@@ -754,20 +852,30 @@ function ViewModel() {
     });
 
     ko.computed(() => {
-        var data = self.constEnthalpyValues().filter(h =>
-            h % 5 === 0 &&
-            h < enthalpyFromTempPv(self.upperLeftBorderTemp(), self.maxPv(), self.totalPressure())
-        );
+        var data;
+        if (self.geometry()) {
+            data = self.geometry().enthalpy
+                .filter(l => !isNaN(l.labelTemp))
+                .map(l => ({ h: l.value, temp: l.labelTemp, pv: l.labelPv }));
+        } else {
+            data = self.constEnthalpyValues().filter(h =>
+                h % 5 === 0 &&
+                h < enthalpyFromTempPv(self.upperLeftBorderTemp(), self.maxPv(), self.totalPressure())
+            ).map(h => {
+                var temp = tempAtStraightEnthalpyLine(h);
+                return { h: h, temp: temp, pv: pvFromEnthalpyTemp(h, temp, self.totalPressure()) };
+            });
+        }
 
         var selection = hLabels.selectAll("text").data(data);
         selection
             .enter()
             .append("text")
             .attr("class", "ticks")
-            .text(d => d.toString())
             .merge(selection)
-            .attr("x", h => self.xScale()(tempAtStraightEnthalpyLine(h) - 0.75))
-            .attr("y", h => self.yScale()(pvFromEnthalpyTemp(h, tempAtStraightEnthalpyLine(h), self.totalPressure()) + 0.005));
+            .text(d => d.h.toString())
+            .attr("x", d => self.xScale()(d.temp - 0.75))
+            .attr("y", d => self.yScale()(d.pv + 0.005));
         selection.exit().remove();
     });
 
@@ -778,6 +886,17 @@ function ViewModel() {
 
     var wetBulbLabelRh = 0.55; // RH value to put all the wetbulb labels.
     self.wetBulbLines = ko.computed(() => {
+        if (self.geometry()) {
+            return self.geometry().wetBulb.map(l => ({
+                wetbulbTemp: l.value,
+                data: l.data,
+                midtemp: l.labelTemp,
+                midpv: l.labelPv,
+                x: self.xScale()(l.labelTemp),
+                y: self.yScale()(l.labelPv),
+                rotationAngle: angleFromDerivative(l.labelSlope)
+            }));
+        }
 
         // This is the derivative of Pv vs. temperature for a given
         // constant wet-bulb line.
@@ -881,6 +1000,7 @@ function ViewModel() {
     });
 
     self.boundaryLineData = ko.computed(() => {
+        if (self.geometry()) return self.geometry().boundary[0].data;
         return [
             { x: self.maxTemp(), y: 0 },
             { x: minTemp, y: 0 },
@@ -898,16 +1018,15 @@ function ViewModel() {
     });
 
     ko.computed(() => {
+        var border = self.geometry() ? self.geometry().enthalpyBorder[0].data : [
+            { x: minTemp, y: satPressFromTempIp(minTemp) },
+            { x: minTemp, y: self.bottomLeftBorderPv() },
+            { x: self.upperLeftBorderTemp(), y: self.maxPv() },
+            { x: self.tempAtCutoff(), y: self.maxPv() }
+        ];
         enthalpyBorderPath
-            .attr(
-                "d",
-                self.saturationLine()([
-                    { x: minTemp, y: satPressFromTempIp(minTemp) },
-                    { x: minTemp, y: self.bottomLeftBorderPv() },
-                    { x: self.upperLeftBorderTemp(), y: self.maxPv() },
-                    { x: self.tempAtCutoff(), y: self.maxPv() }
-                ])
-            ).call(boundaryLine);
+            .attr("d", self.saturationLine()(border))
+            .call(boundaryLine);
     });
 
     self.states = ko.observableArray([]);
@@ -1215,8 +1334,8 @@ function ViewModel() {
 
 }
 
-var viewModel = new ViewModel();
-ko.applyBindings(viewModel);
+// app.js builds the view model once the geometry has arrived; start fetching it now
+loadChartGeometry();
 
 // Function to convert Fahrenheit to Celsius
 function fahrenheitToCelsius(fahrenheit) {